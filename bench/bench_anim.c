@@ -0,0 +1,75 @@
+#include "bench_harness.h"
+#include "../include/anim_pool.h"
+#include "../include/cpu.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Animation update benchmark: 50k objects with position and rotation tracks,
+// one animated_object_t per object vs the SoA pool (scalar and SIMD). One
+// operation is one tick of every object.
+
+enum { OBJECTS = 50000 };
+#define DT (1.0f / 60.0f)
+
+typedef struct {
+    animated_object_t** objects;
+    anim_pool_t pool;
+    float time;
+} anim_ctx_t;
+
+static bezier_animation_t* random_curve(bench_rng_t* rng) {
+    vec3f_t p[4];
+    for (int i = 0; i < 4; i++) {
+        p[i] = vec3f_make(bench_rng_float(rng, -5, 5), bench_rng_float(rng, -5, 5),
+                          bench_rng_float(rng, -5, 5));
+    }
+    return animation_create(&p[0], &p[1], &p[2], &p[3], bench_rng_float(rng, 0.5f, 4.0f),
+                            bench_rng_next(rng) % 2);
+}
+
+static void run_objects(void* p) {
+    anim_ctx_t* c = p;
+    for (int i = 0; i < OBJECTS; i++) animated_object_update(c->objects[i], DT);
+}
+
+static void run_pool(void* p) {
+    anim_ctx_t* c = p;
+    c->time += DT;
+    anim_pool_update(&c->pool, c->time);
+}
+
+int main() {
+    bench_harness_t h;
+    bench_init(&h, "anim");
+
+    anim_ctx_t ctx = { .objects = malloc(sizeof(animated_object_t*) * OBJECTS) };
+    anim_pool_init(&ctx.pool, OBJECTS);
+    bench_rng_t rng = { 9 };
+    for (int i = 0; i < OBJECTS; i++) {
+        ctx.objects[i] = animated_object_create();
+        animated_object_set_position_animation(ctx.objects[i], random_curve(&rng));
+        animated_object_set_rotation_animation(ctx.objects[i], random_curve(&rng));
+        anim_pool_add(&ctx.pool, ctx.objects[i]->pos_anim, ctx.objects[i]->rot_anim);
+    }
+
+    char params[64];
+    snprintf(params, sizeof(params), "%d objects", OBJECTS);
+    const bench_work_t none = { 0 };
+    bench_stats_t objects, pool;
+    bench_run(&h, "animated_object_update", params, run_objects, &ctx, none, &objects);
+
+    const unsigned int masks[] = { 0, ~0u };
+    const char* names[] = { "anim_pool_update", "anim_pool_update_avx2" };
+    for (int m = 0; m < 2; m++) {
+        cpu_set_feature_mask(masks[m]);
+        bench_run(&h, names[m], params, run_pool, &ctx, none, &pool);
+        printf("  %s: %.2f ns/object, %.1fx\n", names[m], pool.p50 / OBJECTS, objects.p50 / pool.p50);
+    }
+    cpu_set_feature_mask(~0u);
+
+    for (int i = 0; i < OBJECTS; i++) animated_object_destroy(ctx.objects[i]);
+    free(ctx.objects);
+    anim_pool_destroy(&ctx.pool);
+    bench_finish(&h);
+    return 0;
+}
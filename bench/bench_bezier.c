@@ -0,0 +1,86 @@
+#include "bench_harness.h"
+#include "../include/animation.h"
+#include <stdio.h>
+
+// Bézier sampling benchmark: exact evaluation vs the baked table, and
+// constant-speed sampling via the arc-length table vs numerically inverting
+// arc length per sample (bisection over a dense exact integration).
+
+enum { STEPS = 4096 };  // Distinct sample times cycled through
+
+typedef struct {
+    bezier_animation_t* anim;
+    float total;        // Exact arc length, for the bisection reference
+    int next;
+    float sink;
+} bezier_ctx_t;
+
+// Arc length from 0 to t by midpoint-free chord summation
+static float exact_length(const bezier_animation_t* a, float t, int steps) {
+    float length = 0.0f;
+    vec3f_t prev = a->p0;
+    for (int i = 1; i <= steps; i++) {
+        vec3f_t cur = vec3_bezier(&a->p0, &a->p1, &a->p2, &a->p3, t * i / steps);
+        length += vec3f_length(vec3f_sub(cur, prev));
+        prev = cur;
+    }
+    return length;
+}
+
+static vec3f_t invert_uniform(const bezier_animation_t* a, float total, float u) {
+    float lo = 0.0f, hi = 1.0f;
+    for (int iter = 0; iter < 16; iter++) {
+        float mid = 0.5f * (lo + hi);
+        if (exact_length(a, mid, 64) < u * total) lo = mid; else hi = mid;
+    }
+    return vec3_bezier(&a->p0, &a->p1, &a->p2, &a->p3, 0.5f * (lo + hi));
+}
+
+static float next_time(bezier_ctx_t* c) {
+    c->next = (c->next + 1) % STEPS;
+    return (float)c->next / STEPS;
+}
+
+static void run_bake(void* p) {
+    bezier_ctx_t* c = p;
+    animation_invalidate(c->anim);
+    animation_bake(c->anim);
+}
+
+static void run_sample(void* p) {
+    bezier_ctx_t* c = p;
+    c->sink += animation_sample(c->anim, next_time(c)).x;
+}
+
+static void run_bisection(void* p) {
+    bezier_ctx_t* c = p;
+    c->sink += invert_uniform(c->anim, c->total, next_time(c)).x;
+}
+
+int main() {
+    bench_harness_t h;
+    bench_init(&h, "bezier");
+
+    vec3f_t p0 = { 0, 0, 0 }, p1 = { 8, 4, 0 }, p2 = { 9, 5, 1 }, p3 = { 10, 5, 1 };
+    bezier_ctx_t ctx = { .anim = animation_create(&p0, &p1, &p2, &p3, 1.0f, 0) };
+    ctx.total = exact_length(ctx.anim, 1.0f, 4096);
+
+    const bench_work_t none = { 0 };
+    char params[64];
+    animation_set_sample_mode(ctx.anim, BEZIER_SAMPLE_UNIFORM, BEZIER_TABLE_DEFAULT_ERROR);
+    animation_bake(ctx.anim);
+    snprintf(params, sizeof(params), "%d segments", ctx.anim->table->segments);
+    bench_run(&h, "animation_bake", params, run_bake, &ctx, none, NULL);
+
+    const bezier_sample_mode_t modes[] = { BEZIER_SAMPLE_EXACT, BEZIER_SAMPLE_TABLE, BEZIER_SAMPLE_UNIFORM };
+    const char* names[] = { "exact", "table", "uniform (table)" };
+    for (int m = 0; m < 3; m++) {
+        animation_set_sample_mode(ctx.anim, modes[m], BEZIER_TABLE_DEFAULT_ERROR);
+        bench_run(&h, "animation_sample", names[m], run_sample, &ctx, none, NULL);
+    }
+    bench_run(&h, "animation_sample", "uniform (bisection)", run_bisection, &ctx, none, NULL);
+
+    animation_destroy(ctx.anim);
+    bench_finish(&h);
+    return ctx.sink == 0.0f;
+}
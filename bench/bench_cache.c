@@ -0,0 +1,102 @@
+#include "bench_harness.h"
+#include "../include/renderer.h"
+#include "../include/projection_cache.h"
+#include <math.h>
+#include <stdio.h>
+
+// Projection cache benchmark: a dashboard-like scene of many still meshes and
+// a few animated ones, drawn with and without per-object projection caches.
+// Reports frame times and the cache hit rate.
+
+#define NUM_OBJECTS 24
+#define NUM_ANIMATED 3
+
+typedef struct {
+    renderer_t* renderer;
+    indexed_mesh_t* mesh;
+    mat4_t view, proj;
+    projection_cache_t caches[NUM_OBJECTS];
+    int frame;
+} cache_ctx_t;
+
+static void object_world(mat4_t* world, int object, int frame) {
+    float spin = object < NUM_ANIMATED ? 0.02f * frame : 0.0f;
+    vec3f_t t = vec3f_make((float)(object % 6) - 2.5f, (float)(object / 6) - 1.5f, 0.0f);
+    vec3f_t euler = vec3f_make(0.3f * object, 0.5f + spin, 0.0f);
+    vec3f_t s = vec3f_make(0.4f, 0.4f, 0.4f);
+    mat4_trs(world, t, euler, s);
+}
+
+static void draw_frame(cache_ctx_t* c, int cached) {
+    renderer_begin_frame(c->renderer);
+    canvas_clear(c->renderer->canvas, 0.0f);
+    for (int i = 0; i < NUM_OBJECTS; i++) {
+        mat4_t world;
+        object_world(&world, i, c->frame);
+        if (cached) {
+            renderer_draw_wireframe_cached(c->renderer, c->mesh, &c->caches[i], &world, &c->view, &c->proj);
+        } else {
+            renderer_draw_wireframe(c->renderer, c->mesh, &world, &c->view, &c->proj);
+        }
+    }
+    c->frame++;
+}
+
+static void run_uncached(void* p) {
+    draw_frame(p, 0);
+}
+
+static void run_cached(void* p) {
+    draw_frame(p, 1);
+}
+
+int main() {
+    bench_harness_t h;
+    bench_init(&h, "cache");
+
+    cache_ctx_t ctx = { .mesh = indexed_mesh_create(2000, 6000) };
+    indexed_mesh_t* mesh = ctx.mesh;
+    bench_rng_t rng = { 5 };
+    // Random walk, so index-neighbours are close and edges stay short
+    vec3f_t p = vec3f_make(0.0f, 0.0f, 0.0f);
+    for (int i = 0; i < mesh->num_vertices; i++) {
+        p.x = fminf(fmaxf(p.x + bench_rng_float(&rng, -0.05f, 0.05f), -1.0f), 1.0f);
+        p.y = fminf(fmaxf(p.y + bench_rng_float(&rng, -0.05f, 0.05f), -1.0f), 1.0f);
+        p.z = fminf(fmaxf(p.z + bench_rng_float(&rng, -0.05f, 0.05f), -1.0f), 1.0f);
+        mesh->vertices[i] = p;
+    }
+    for (int i = 0; i < mesh->num_edges; i++) {
+        int a = (int)(bench_rng_next(&rng) % mesh->num_vertices);
+        mesh->indices[2*i] = a;
+        mesh->indices[2*i + 1] = (a + 1 + (int)(bench_rng_next(&rng) % 8)) % mesh->num_vertices;
+    }
+    indexed_mesh_compute_bounds(mesh);
+
+    canvas_t* canvas = create_canvas(800, 600);
+    ctx.renderer = renderer_create(canvas);
+    mat4_translate(&ctx.view, 0.0f, 0.0f, -6.0f);
+    mat4_frustum_asymmetric(&ctx.proj, -0.5f, 0.5f, -0.375f, 0.375f, 1.0f, 20.0f);
+    for (int i = 0; i < NUM_OBJECTS; i++) projection_cache_init(&ctx.caches[i]);
+
+    char params[64];
+    snprintf(params, sizeof(params), "%d objects, %d animated", NUM_OBJECTS, NUM_ANIMATED);
+    bench_work_t work = { .vertices = (double)NUM_OBJECTS * mesh->num_vertices,
+                          .edges = (double)NUM_OBJECTS * mesh->num_edges };
+    bench_run(&h, "uncached", params, run_uncached, &ctx, work, NULL);
+    bench_run(&h, "cached", params, run_cached, &ctx, work, NULL);
+
+    unsigned long hits = 0, misses = 0;
+    for (int i = 0; i < NUM_OBJECTS; i++) {
+        hits += ctx.caches[i].hits;
+        misses += ctx.caches[i].misses;
+        projection_cache_destroy(&ctx.caches[i]);
+    }
+    printf("  cache: %lu hits, %lu misses (%.1f%% hit rate)\n",
+           hits, misses, 100.0 * hits / (hits + misses));
+
+    renderer_destroy(ctx.renderer);
+    free_canvas(canvas);
+    indexed_mesh_destroy(mesh);
+    bench_finish(&h);
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "bench_harness.h"
+#include "../include/renderer.h"
+#include "../include/depth_buffer.h"
+#include <math.h>
+#include <stdio.h>
+
+// Depth buffer benchmark: full wireframe frames (clear + draw) with the
+// painter's sort versus per-pixel depth testing in float and 16-bit formats,
+// across mesh sizes. Also reports the depth-tested overdraw.
+
+typedef struct {
+    renderer_t* renderer;
+    indexed_mesh_t* mesh;
+    mat4_t world, view, proj;
+} depth_ctx_t;
+
+static void run_frame(void* p) {
+    depth_ctx_t* c = p;
+    renderer_begin_frame(c->renderer);
+    canvas_clear(c->renderer->canvas, 0.0f);
+    renderer_draw_wireframe(c->renderer, c->mesh, &c->world, &c->view, &c->proj);
+}
+
+int main() {
+    bench_harness_t h;
+    bench_init(&h, "depth");
+
+    canvas_t* canvas = create_canvas(800, 600);
+    depth_ctx_t ctx = { .renderer = renderer_create(canvas) };
+    ctx.renderer->line_mode = RASTER_LINE_AA;
+    mat4_rotate_xyz(&ctx.world, 0.4f, 0.9f, 0.0f);
+    mat4_translate(&ctx.view, 0.0f, 0.0f, -3.0f);
+    mat4_frustum_asymmetric(&ctx.proj, -0.5f, 0.5f, -0.375f, 0.375f, 1.0f, 20.0f);
+
+    bench_rng_t rng = { 3 };
+    char params[64];
+    for (int edges = 1000; edges <= 64000; edges *= 4) {
+        // Short edges between nearby vertices of a random walk, like a dense mesh
+        indexed_mesh_t* mesh = indexed_mesh_create(edges / 2, edges);
+        vec3f_t p = vec3f_make(0.0f, 0.0f, 0.0f);
+        for (int i = 0; i < mesh->num_vertices; i++) {
+            p.x = fminf(fmaxf(p.x + bench_rng_float(&rng, -0.05f, 0.05f), -1.0f), 1.0f);
+            p.y = fminf(fmaxf(p.y + bench_rng_float(&rng, -0.05f, 0.05f), -1.0f), 1.0f);
+            p.z = fminf(fmaxf(p.z + bench_rng_float(&rng, -0.05f, 0.05f), -1.0f), 1.0f);
+            mesh->vertices[i] = p;
+        }
+        for (int i = 0; i < mesh->num_edges; i++) {
+            int a = (int)(bench_rng_next(&rng) % mesh->num_vertices);
+            mesh->indices[2*i] = a;
+            mesh->indices[2*i + 1] = (a + 1 + (int)(bench_rng_next(&rng) % 16)) % mesh->num_vertices;
+        }
+        ctx.mesh = mesh;
+        bench_work_t work = { .vertices = mesh->num_vertices, .edges = edges };
+
+        canvas_detach_depth(canvas);
+        snprintf(params, sizeof(params), "%d edges, sort", edges);
+        bench_run(&h, "frame", params, run_frame, &ctx, work, NULL);
+
+        canvas_attach_depth(canvas, DEPTH_FORMAT_FLOAT32);
+        snprintf(params, sizeof(params), "%d edges, f32", edges);
+        bench_run(&h, "frame", params, run_frame, &ctx, work, NULL);
+        depth_stats_t stats;
+        depth_buffer_stats(canvas->depth, &stats);
+
+        canvas_attach_depth(canvas, DEPTH_FORMAT_UNORM16);
+        snprintf(params, sizeof(params), "%d edges, u16", edges);
+        bench_run(&h, "frame", params, run_frame, &ctx, work, NULL);
+        printf("  %d edges: overdraw %.2f\n", edges, stats.overdraw);
+        indexed_mesh_destroy(mesh);
+    }
+
+    renderer_destroy(ctx.renderer);
+    free_canvas(canvas);
+    bench_finish(&h);
+    return 0;
+}
@@ -0,0 +1,32 @@
+#ifndef BENCH_FIXTURES_H
+#define BENCH_FIXTURES_H
+
+#include "../include/mesh.h"
+
+// Meshes shared by the benchmarks. Everything here is static inline, so a
+// benchmark that uses only some of them still builds warning-clean.
+
+// Unit cube centred on the origin: 8 corners, 12 edges
+static inline indexed_mesh_t* make_cube(void) {
+    indexed_mesh_t* cube = indexed_mesh_create(8, 12);
+    if (!cube) return NULL;
+    for (int i = 0; i < 8; i++) {
+        cube->vertices[i] = vec3f_make(i & 1 ? 0.5f : -0.5f, i & 2 ? 0.5f : -0.5f,
+                                       i & 4 ? 0.5f : -0.5f);
+    }
+    // Every pair of corners differing in one coordinate
+    int e = 0;
+    for (int i = 0; i < 8; i++) {
+        for (int bit = 1; bit < 8; bit <<= 1) {
+            if (!(i & bit)) {
+                cube->indices[2*e] = i;
+                cube->indices[2*e + 1] = i | bit;
+                e++;
+            }
+        }
+    }
+    indexed_mesh_compute_bounds(cube);
+    return cube;
+}
+
+#endif // BENCH_FIXTURES_H
@@ -0,0 +1,180 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+// Shared benchmark harness: calibrated batches, warm-up, repeated samples and
+// percentile statistics, printed as a table and optionally appended as JSON
+// lines for comparing commits.
+//
+// Each case is a callback that performs one operation. The harness grows the
+// batch size until one batch takes BENCH_SAMPLE_NS (this doubles as warm-up),
+// keeps running until BENCH_WARMUP_NS has passed, then times up to
+// BENCH_MAX_SAMPLES batches within the per-case budget (never fewer than
+// BENCH_MIN_SAMPLES). Throughputs are derived from the median.
+//
+// Environment:
+//   BENCH_OUTPUT  file to append one JSON object per case to (unset = none)
+//   BENCH_COMMIT  revision label stored in each record (make bench sets it)
+//   BENCH_BUDGET  per-case time budget in milliseconds (default 250)
+//
+// Everything here is static inline, so a benchmark that uses only some of the
+// helpers still builds warning-clean.
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_SAMPLE_NS   2e6   // Target duration of one timed batch
+#define BENCH_WARMUP_NS   2e7
+#define BENCH_MIN_SAMPLES 5
+#define BENCH_MAX_SAMPLES 51
+
+typedef void (*bench_fn_t)(void* ctx);
+
+// Work done by one operation, for throughput columns (0 = not reported)
+typedef struct {
+    double vertices;
+    double edges;
+    double pixels;
+} bench_work_t;
+
+typedef struct {
+    int samples;
+    long batch;       // Operations per sample
+    double min;       // ns per operation
+    double p50;
+    double p90;
+    double p99;
+    double mean;
+} bench_stats_t;
+
+typedef struct {
+    const char* suite;
+    const char* commit;
+    double budget_ns;
+    FILE* out;        // JSON lines, or NULL
+} bench_harness_t;
+
+static inline double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static inline void bench_init(bench_harness_t* h, const char* suite) {
+    const char* output = getenv("BENCH_OUTPUT");
+    const char* commit = getenv("BENCH_COMMIT");
+    const char* budget = getenv("BENCH_BUDGET");
+    h->suite = suite;
+    h->commit = commit && *commit ? commit : "unknown";
+    h->budget_ns = (budget && atof(budget) > 0.0 ? atof(budget) : 250.0) * 1e6;
+    h->out = NULL;
+    if (output && *output) {
+        h->out = fopen(output, "a");
+        if (!h->out) fprintf(stderr, "bench: cannot open %s, JSON output disabled\n", output);
+    }
+    printf("%-24s %-22s %11s %11s %11s %9s %9s %9s\n", "case", "params", "p50 ns/op",
+           "p90 ns/op", "p99 ns/op", "Mvert/s", "Medge/s", "Mpix/s");
+}
+
+static inline void bench_finish(bench_harness_t* h) {
+    if (h->out) fclose(h->out);
+    h->out = NULL;
+}
+
+static inline int bench_compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of sorted samples
+static inline double bench_percentile(const double* sorted, int count, double p) {
+    int rank = (int)(p / 100.0 * count + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1];
+}
+
+static inline double bench_rate(double per_op, double ns) {
+    return per_op > 0.0 && ns > 0.0 ? per_op / ns * 1e3 : 0.0;  // Millions per second
+}
+
+static inline void bench_run(bench_harness_t* h, const char* name, const char* params,
+                      bench_fn_t fn, void* ctx, bench_work_t work, bench_stats_t* result) {
+    // Calibrate (and warm caches, branch predictors and lazily built tables)
+    long batch = 1;
+    double elapsed = 0.0, warm = 0.0;
+    for (;;) {
+        double start = bench_now_ns();
+        for (long i = 0; i < batch; i++) fn(ctx);
+        elapsed = bench_now_ns() - start;
+        warm += elapsed;
+        if (elapsed >= BENCH_SAMPLE_NS || batch >= (1L << 30)) break;
+        batch *= elapsed > 0.0 && elapsed * 8 < BENCH_SAMPLE_NS ? 8 : 2;
+    }
+    while (warm < BENCH_WARMUP_NS) {
+        double start = bench_now_ns();
+        for (long i = 0; i < batch; i++) fn(ctx);
+        warm += bench_now_ns() - start;
+    }
+
+    int samples = (int)(h->budget_ns / elapsed);
+    if (samples < BENCH_MIN_SAMPLES) samples = BENCH_MIN_SAMPLES;
+    if (samples > BENCH_MAX_SAMPLES) samples = BENCH_MAX_SAMPLES;
+
+    double ns[BENCH_MAX_SAMPLES];
+    double sum = 0.0;
+    for (int s = 0; s < samples; s++) {
+        double start = bench_now_ns();
+        for (long i = 0; i < batch; i++) fn(ctx);
+        ns[s] = (bench_now_ns() - start) / batch;
+        sum += ns[s];
+    }
+    qsort(ns, samples, sizeof(double), bench_compare_double);
+
+    bench_stats_t st = {
+        samples, batch, ns[0],
+        bench_percentile(ns, samples, 50.0),
+        bench_percentile(ns, samples, 90.0),
+        bench_percentile(ns, samples, 99.0),
+        sum / samples
+    };
+    if (result) *result = st;
+
+    double vps = bench_rate(work.vertices, st.p50);
+    double eps = bench_rate(work.edges, st.p50);
+    double pps = bench_rate(work.pixels, st.p50);
+    printf("%-24s %-22s %11.1f %11.1f %11.1f %9.1f %9.1f %9.1f\n", name, params,
+           st.p50, st.p90, st.p99, vps, eps, pps);
+    fflush(stdout);
+
+    if (h->out) {
+        fprintf(h->out,
+                "{\"suite\":\"%s\",\"case\":\"%s\",\"params\":\"%s\",\"commit\":\"%s\","
+                "\"samples\":%d,\"batch\":%ld,\"ns_per_op\":{\"min\":%.3f,\"p50\":%.3f,"
+                "\"p90\":%.3f,\"p99\":%.3f,\"mean\":%.3f},\"vertices_per_s\":%.6g,"
+                "\"edges_per_s\":%.6g,\"pixels_per_s\":%.6g}\n",
+                h->suite, name, params, h->commit, st.samples, st.batch, st.min, st.p50,
+                st.p90, st.p99, st.mean, vps * 1e6, eps * 1e6, pps * 1e6);
+        fflush(h->out);
+    }
+}
+
+// Deterministic generator so synthetic inputs are identical across runs and
+// machines (rand() sequences are not)
+typedef struct {
+    unsigned long long state;
+} bench_rng_t;
+
+static inline unsigned int bench_rng_next(bench_rng_t* rng) {
+    rng->state = rng->state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (unsigned int)(rng->state >> 33);
+}
+
+// Uniform in [lo, hi)
+static inline float bench_rng_float(bench_rng_t* rng, float lo, float hi) {
+    return lo + (hi - lo) * (float)(bench_rng_next(rng) >> 7) * (1.0f / 16777216.0f);
+}
+
+#endif // BENCH_HARNESS_H
@@ -0,0 +1,77 @@
+#include "bench_harness.h"
+#include "bench_fixtures.h"
+#include "../include/renderer.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Instancing benchmark: N cubes drawn with one render_wireframe call each
+// (throwaway context), one renderer_draw_wireframe call each (shared context),
+// and a single renderer_draw_instances call. About a third of the instances
+// sit outside the frustum.
+
+enum { COUNT = 10000 };
+
+typedef struct {
+    canvas_t* canvas;
+    renderer_t* renderer;
+    indexed_mesh_t* cube;
+    mat4_t* worlds;
+    mat4_t view, proj;
+    int drawn;
+} instances_ctx_t;
+
+static void run_oneshot(void* p) {
+    instances_ctx_t* c = p;
+    canvas_clear(c->canvas, 0.0f);
+    for (int i = 0; i < COUNT; i++) render_wireframe(c->canvas, c->cube, c->worlds[i], c->view, c->proj);
+}
+
+static void run_context(void* p) {
+    instances_ctx_t* c = p;
+    canvas_clear(c->canvas, 0.0f);
+    renderer_begin_frame(c->renderer);
+    for (int i = 0; i < COUNT; i++) {
+        renderer_draw_wireframe(c->renderer, c->cube, &c->worlds[i], &c->view, &c->proj);
+    }
+}
+
+static void run_instanced(void* p) {
+    instances_ctx_t* c = p;
+    canvas_clear(c->canvas, 0.0f);
+    renderer_begin_frame(c->renderer);
+    c->drawn = renderer_draw_instances(c->renderer, c->cube, c->worlds, NULL, COUNT, &c->view, &c->proj);
+}
+
+int main() {
+    bench_harness_t h;
+    bench_init(&h, "instances");
+
+    instances_ctx_t ctx = { .canvas = create_canvas(800, 600), .cube = make_cube() };
+    ctx.renderer = renderer_create(ctx.canvas);
+    mat4_translate(&ctx.view, 0.0f, 0.0f, -40.0f);
+    mat4_frustum_asymmetric(&ctx.proj, -0.5f, 0.5f, -0.375f, 0.375f, 1.0f, 100.0f);
+
+    ctx.worlds = malloc(sizeof(mat4_t) * COUNT);
+    bench_rng_t rng = { 8 };
+    for (int i = 0; i < COUNT; i++) {
+        vec3f_t t = vec3f_make(bench_rng_float(&rng, -30.0f, 30.0f), bench_rng_float(&rng, -22.5f, 22.5f),
+                               bench_rng_float(&rng, -10.0f, 10.0f));
+        vec3f_t r = vec3f_make(bench_rng_float(&rng, 0.0f, 6.3f), bench_rng_float(&rng, 0.0f, 6.3f), 0.0f);
+        mat4_trs(&ctx.worlds[i], t, r, vec3f_make(0.3f, 0.3f, 0.3f));
+    }
+
+    char params[64];
+    snprintf(params, sizeof(params), "%d cubes", COUNT);
+    bench_work_t work = { .vertices = 8.0 * COUNT, .edges = 12.0 * COUNT };
+    bench_run(&h, "render_wireframe", params, run_oneshot, &ctx, work, NULL);
+    bench_run(&h, "renderer_draw_wireframe", params, run_context, &ctx, work, NULL);
+    bench_run(&h, "renderer_draw_instances", params, run_instanced, &ctx, work, NULL);
+    printf("  %d cubes, %d survive culling\n", COUNT, ctx.drawn);
+
+    free(ctx.worlds);
+    renderer_destroy(ctx.renderer);
+    free_canvas(ctx.canvas);
+    indexed_mesh_destroy(ctx.cube);
+    bench_finish(&h);
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "bench_harness.h"
+#include "../include/lighting.h"
+#include "../include/cpu.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Lighting benchmark: 20 lights over 100k edges. The per-pair reference
+// (calculate_lambert_intensity for every edge and light, as apply_lighting
+// used to do) vs the prepared light set, scalar and AVX2.
+
+enum { LIGHTS = 20, VERTICES = 50000, EDGES = 100000 };
+
+typedef struct {
+    light_t lights[LIGHTS];
+    indexed_mesh_t* mesh;
+    light_set_t set;
+    float* out;
+} lighting_ctx_t;
+
+static void run_per_pair(void* p) {
+    lighting_ctx_t* c = p;
+    const indexed_mesh_t* mesh = c->mesh;
+    for (int i = 0; i < EDGES; i++) {
+        vec3f_t edge = vec3f_sub(mesh->vertices[mesh->indices[2*i + 1]],
+                                 mesh->vertices[mesh->indices[2*i]]);
+        float total = 0.0f;
+        for (int j = 0; j < LIGHTS; j++) {
+            total += calculate_lambert_intensity(edge, c->lights[j].direction) * c->lights[j].intensity;
+        }
+        c->out[i] = total < 1.0f ? total : 1.0f;
+    }
+}
+
+static void run_light_set(void* p) {
+    lighting_ctx_t* c = p;
+    light_set_prepare(&c->set, c->lights, LIGHTS, 0.0f);
+    lighting_evaluate_indexed(&c->set, c->mesh, c->out);
+}
+
+int main() {
+    bench_harness_t h;
+    bench_init(&h, "lighting");
+
+    lighting_ctx_t ctx;
+    bench_rng_t rng = { 4 };
+    for (int j = 0; j < LIGHTS; j++) {
+        ctx.lights[j].direction = vec3f_make(bench_rng_float(&rng, -1, 1), bench_rng_float(&rng, -1, 1),
+                                             bench_rng_float(&rng, -1, 1));
+        ctx.lights[j].intensity = bench_rng_float(&rng, 0.0f, 0.1f);
+    }
+    ctx.mesh = indexed_mesh_create(VERTICES, EDGES);
+    for (int i = 0; i < VERTICES; i++) {
+        ctx.mesh->vertices[i] = vec3f_make(bench_rng_float(&rng, -1, 1), bench_rng_float(&rng, -1, 1),
+                                           bench_rng_float(&rng, -1, 1));
+    }
+    for (int i = 0; i < 2 * EDGES; i++) ctx.mesh->indices[i] = (int)(bench_rng_next(&rng) % VERTICES);
+    ctx.out = malloc(sizeof(float) * EDGES);
+    light_set_init(&ctx.set);
+
+    char params[64];
+    snprintf(params, sizeof(params), "%d lights", LIGHTS);
+    bench_work_t work = { .edges = EDGES };
+    bench_stats_t pair, stats;
+    bench_run(&h, "per-pair", params, run_per_pair, &ctx, work, &pair);
+
+    const unsigned int masks[] = { 0, ~0u };
+    const char* names[] = { "light set", "light set avx2" };
+    for (int m = 0; m < 2; m++) {
+        cpu_set_feature_mask(masks[m]);
+        bench_run(&h, names[m], params, run_light_set, &ctx, work, &stats);
+        printf("  %s: %.1fx per-pair\n", names[m], pair.p50 / stats.p50);
+    }
+    cpu_set_feature_mask(~0u);
+
+    light_set_destroy(&ctx.set);
+    free(ctx.out);
+    indexed_mesh_destroy(ctx.mesh);
+    bench_finish(&h);
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "bench_harness.h"
+#include "../include/canvas.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Line rasterizer benchmark: draw_line_f (bilinear splats) vs draw_line_aa.
+// Throughput is reported in covered pixels per second, i.e. the total line
+// length times the thickness, so both engines are measured on the same work.
+
+enum { WIDTH = 1920, HEIGHT = 1080, NUM_LINES = 2000 };
+
+typedef struct {
+    canvas_t* canvas;
+    float (*lines)[4];
+    float thickness;
+} lines_ctx_t;
+
+static void run_splat(void* p) {
+    lines_ctx_t* c = p;
+    for (int i = 0; i < NUM_LINES; i++) {
+        draw_line_f(c->canvas, c->lines[i][0], c->lines[i][1], c->lines[i][2], c->lines[i][3],
+                    c->thickness);
+    }
+}
+
+static void run_aa(void* p) {
+    lines_ctx_t* c = p;
+    for (int i = 0; i < NUM_LINES; i++) {
+        draw_line_aa(c->canvas, c->lines[i][0], c->lines[i][1], c->lines[i][2], c->lines[i][3],
+                     c->thickness, 1.0f);
+    }
+}
+
+int main() {
+    bench_harness_t h;
+    bench_init(&h, "lines");
+
+    lines_ctx_t ctx = { .canvas = create_canvas(WIDTH, HEIGHT) };
+    ctx.lines = malloc(sizeof(float[4]) * NUM_LINES);
+    canvas_clear(ctx.canvas, 0.0f);
+
+    // Random lines, a fifth of them partly off-canvas
+    bench_rng_t rng = { 3 };
+    double total_length = 0.0;
+    for (int i = 0; i < NUM_LINES; i++) {
+        float pad = (i % 5 == 0) ? 200.0f : 0.0f;
+        for (int k = 0; k < 4; k += 2) {
+            ctx.lines[i][k] = bench_rng_float(&rng, -pad, WIDTH + pad);
+            ctx.lines[i][k + 1] = bench_rng_float(&rng, -pad, HEIGHT + pad);
+        }
+        total_length += hypot(ctx.lines[i][2] - ctx.lines[i][0], ctx.lines[i][3] - ctx.lines[i][1]);
+    }
+
+    const float thicknesses[] = { 1.0f, 3.0f, 5.0f };
+    char params[64];
+    for (int t = 0; t < 3; t++) {
+        ctx.thickness = thicknesses[t];
+        bench_work_t work = { .edges = NUM_LINES, .pixels = total_length * ctx.thickness };
+        bench_stats_t splat, aa;
+        snprintf(params, sizeof(params), "%d lines, thickness %.0f", NUM_LINES, ctx.thickness);
+        bench_run(&h, "draw_line_f", params, run_splat, &ctx, work, &splat);
+        bench_run(&h, "draw_line_aa", params, run_aa, &ctx, work, &aa);
+        printf("  thickness %.0f: aa %.1fx splat\n", ctx.thickness, splat.p50 / aa.p50);
+    }
+
+    free(ctx.lines);
+    free_canvas(ctx.canvas);
+    bench_finish(&h);
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "bench_harness.h"
+#include "../include/renderer.h"
+#include "../include/mesh_lod.h"
+#include <math.h>
+#include <stdio.h>
+
+// Distant dense meshes: the full mesh through renderer_draw_wireframe against
+// renderer_draw_lod at increasing camera distances, plus the one-off build.
+
+typedef struct {
+    renderer_t* renderer;
+    indexed_mesh_t* mesh;
+    mesh_lod_t* lod;
+    mat4_t world, view, proj;
+} lod_ctx_t;
+
+static void run_full(void* p) {
+    lod_ctx_t* c = p;
+    renderer_begin_frame(c->renderer);
+    canvas_clear(c->renderer->canvas, 0.0f);
+    renderer_draw_wireframe(c->renderer, c->mesh, &c->world, &c->view, &c->proj);
+}
+
+static void run_lod(void* p) {
+    lod_ctx_t* c = p;
+    renderer_begin_frame(c->renderer);
+    canvas_clear(c->renderer->canvas, 0.0f);
+    renderer_draw_lod(c->renderer, c->lod, &c->world, &c->view, &c->proj);
+}
+
+static void run_build(void* p) {
+    lod_ctx_t* c = p;
+    mesh_lod_destroy(mesh_lod_build(c->mesh, MESH_LOD_MAX_LEVELS));
+}
+
+int main() {
+    bench_harness_t h;
+    bench_init(&h, "lod");
+
+    // 128 x 256 UV sphere: 32768 vertices, 65408 edges
+    const int rings = 128, sectors = 256;
+    indexed_mesh_t* mesh = indexed_mesh_create(rings * sectors, rings * sectors + (rings - 1) * sectors);
+    int e = 0;
+    for (int r = 0; r < rings; r++) {
+        float phi = 3.14159265f * (r + 1) / (rings + 1);
+        for (int s = 0; s < sectors; s++) {
+            float theta = 6.2831853f * s / sectors;
+            mesh->vertices[r * sectors + s] = vec3f_make(sinf(phi) * cosf(theta), cosf(phi),
+                                                         sinf(phi) * sinf(theta));
+            mesh->indices[2*e] = r * sectors + s;
+            mesh->indices[2*e + 1] = r * sectors + (s + 1) % sectors;
+            e++;
+            if (r + 1 < rings) {
+                mesh->indices[2*e] = r * sectors + s;
+                mesh->indices[2*e + 1] = (r + 1) * sectors + s;
+                e++;
+            }
+        }
+    }
+    indexed_mesh_compute_bounds(mesh);
+
+    canvas_t* canvas = create_canvas(640, 480);
+    lod_ctx_t ctx = { .renderer = renderer_create(canvas), .mesh = mesh };
+    ctx.lod = mesh_lod_build(mesh, MESH_LOD_MAX_LEVELS);
+    mat4_rotate_xyz(&ctx.world, 0.3f, 0.7f, 0.0f);
+    mat4_frustum_asymmetric(&ctx.proj, -0.5f, 0.5f, -0.375f, 0.375f, 1.0f, 1000.0f);
+
+    char params[64];
+    bench_work_t work = { .vertices = mesh->num_vertices, .edges = mesh->num_edges };
+    snprintf(params, sizeof(params), "%d edges, %d levels", mesh->num_edges, ctx.lod->num_levels);
+    bench_run(&h, "build", params, run_build, &ctx, work, NULL);
+
+    const float distances[] = { 3.0f, 20.0f, 80.0f, 320.0f };
+    for (int d = 0; d < 4; d++) {
+        mat4_translate(&ctx.view, 0.0f, 0.0f, -distances[d]);
+        float ppu = mesh_lod_pixels_per_unit(ctx.lod, &ctx.world, &ctx.view, &ctx.proj, canvas->height);
+        int level = mesh_lod_select(ctx.lod, ppu, ctx.renderer->lod_pixel_error);
+        const indexed_mesh_t* drawn = ctx.lod->levels[level].mesh;
+
+        snprintf(params, sizeof(params), "distance %.0f, full", distances[d]);
+        bench_run(&h, "draw", params, run_full, &ctx, work, NULL);
+        snprintf(params, sizeof(params), "distance %.0f, level %d (%d edges)", distances[d], level,
+                 drawn->num_edges);
+        bench_work_t lod_work = { .vertices = drawn->num_vertices, .edges = drawn->num_edges };
+        bench_run(&h, "draw", params, run_lod, &ctx, lod_work, NULL);
+    }
+
+    mesh_lod_destroy(ctx.lod);
+    renderer_destroy(ctx.renderer);
+    free_canvas(canvas);
+    indexed_mesh_destroy(mesh);
+    bench_finish(&h);
+    return 0;
+}
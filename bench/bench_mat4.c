@@ -0,0 +1,129 @@
+#include "bench_harness.h"
+#include "../include/math3d.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Matrix micro-benchmarks against the original scalar code (copied below):
+// general multiply, batch multiply, and building a rotation / TRS matrix.
+
+enum { N = 4096 };
+
+typedef struct {
+    mat4_t a;
+    mat4_t* bs;
+    mat4_t* out;
+    int next;       // Varies the angle and the output slot between builds
+} mat4_ctx_t;
+
+static void old_multiply(mat4_t* result, const mat4_t* a, const mat4_t* b) {
+    float temp[16];
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            temp[j*4+i] = 0.0f;
+            for (int k = 0; k < 4; ++k) temp[j*4+i] += a->m[k*4+i] * b->m[j*4+k];
+        }
+    }
+    for (int i = 0; i < 16; i++) result->m[i] = temp[i];
+}
+
+static void old_rotate_xyz(mat4_t* m, float rx, float ry, float rz) {
+    float cx = cosf(rx), sx = sinf(rx);
+    float cy = cosf(ry), sy = sinf(ry);
+    float cz = cosf(rz), sz = sinf(rz);
+    mat4_t x_rot = {{ 1,0,0,0, 0,cx,-sx,0, 0,sx,cx,0, 0,0,0,1 }};
+    mat4_t y_rot = {{ cy,0,sy,0, 0,1,0,0, -sy,0,cy,0, 0,0,0,1 }};
+    mat4_t z_rot = {{ cz,-sz,0,0, sz,cz,0,0, 0,0,1,0, 0,0,0,1 }};
+    mat4_t temp;
+    old_multiply(&temp, &x_rot, &y_rot);
+    old_multiply(m, &temp, &z_rot);
+}
+
+// Keeps the optimizer from discarding results
+static volatile float sink;
+
+static void run_old_multiply(void* p) {
+    mat4_ctx_t* c = p;
+    for (int n = 0; n < N; n++) old_multiply(&c->out[n], &c->a, &c->bs[n]);
+    sink = c->out[N - 1].m[5];
+}
+
+static void run_multiply(void* p) {
+    mat4_ctx_t* c = p;
+    for (int n = 0; n < N; n++) mat4_multiply(&c->out[n], &c->a, &c->bs[n]);
+    sink = c->out[N - 1].m[5];
+}
+
+static void run_multiply_batch(void* p) {
+    mat4_ctx_t* c = p;
+    mat4_multiply_batch(c->out, &c->a, c->bs, N);
+    sink = c->out[N - 1].m[5];
+}
+
+static void run_old_rotate(void* p) {
+    mat4_ctx_t* c = p;
+    int i = c->next++ & (N - 1);
+    old_rotate_xyz(&c->out[i], i * 1e-3f, 0.5f, 0.25f);
+    sink = c->out[i].m[1];
+}
+
+static void run_rotate(void* p) {
+    mat4_ctx_t* c = p;
+    int i = c->next++ & (N - 1);
+    mat4_rotate_xyz(&c->out[i], i * 1e-3f, 0.5f, 0.25f);
+    sink = c->out[i].m[1];
+}
+
+// T * R * S: three builders and two multiplies vs one closed-form pass
+static void run_old_trs(void* p) {
+    mat4_ctx_t* c = p;
+    int i = c->next++ & (N - 1);
+    mat4_t t, r, s, tr;
+    mat4_translate(&t, 1.0f, 2.0f, 3.0f);
+    old_rotate_xyz(&r, i * 1e-3f, 0.5f, 0.25f);
+    mat4_scale(&s, 2.0f, 2.0f, 2.0f);
+    old_multiply(&tr, &t, &r);
+    old_multiply(&c->out[i], &tr, &s);
+    sink = c->out[i].m[1];
+}
+
+static void run_trs(void* p) {
+    mat4_ctx_t* c = p;
+    int i = c->next++ & (N - 1);
+    mat4_trs(&c->out[i], vec3f_make(1.0f, 2.0f, 3.0f), vec3f_make(i * 1e-3f, 0.5f, 0.25f),
+             vec3f_make(2.0f, 2.0f, 2.0f));
+    sink = c->out[i].m[1];
+}
+
+int main() {
+    bench_harness_t h;
+    bench_init(&h, "mat4");
+
+    mat4_ctx_t ctx = { .bs = malloc(sizeof(mat4_t) * N), .out = malloc(sizeof(mat4_t) * N) };
+    bench_rng_t rng = { 5 };
+    for (int i = 0; i < 16; i++) ctx.a.m[i] = bench_rng_float(&rng, 0.0f, 1.0f);
+    for (int n = 0; n < N; n++) {
+        for (int i = 0; i < 16; i++) ctx.bs[n].m[i] = bench_rng_float(&rng, 0.0f, 1.0f);
+    }
+
+    const bench_work_t none = { 0 };
+    const char* batch = "4096 matrices";
+    bench_stats_t old_stats, stats;
+    bench_run(&h, "multiply_old", batch, run_old_multiply, &ctx, none, &old_stats);
+    bench_run(&h, "mat4_multiply", batch, run_multiply, &ctx, none, &stats);
+    printf("  mat4_multiply: %.1fx\n", old_stats.p50 / stats.p50);
+    bench_run(&h, "mat4_multiply_batch", batch, run_multiply_batch, &ctx, none, &stats);
+    printf("  mat4_multiply_batch: %.1fx\n", old_stats.p50 / stats.p50);
+
+    bench_run(&h, "rotate_xyz_old", "", run_old_rotate, &ctx, none, &old_stats);
+    bench_run(&h, "mat4_rotate_xyz", "", run_rotate, &ctx, none, &stats);
+    printf("  mat4_rotate_xyz: %.1fx\n", old_stats.p50 / stats.p50);
+    bench_run(&h, "trs_old", "", run_old_trs, &ctx, none, &old_stats);
+    bench_run(&h, "mat4_trs", "", run_trs, &ctx, none, &stats);
+    printf("  mat4_trs: %.1fx\n", old_stats.p50 / stats.p50);
+
+    free(ctx.bs);
+    free(ctx.out);
+    bench_finish(&h);
+    return 0;
+}
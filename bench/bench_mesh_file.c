@@ -0,0 +1,72 @@
+#include "bench_harness.h"
+#include "../include/mesh_file.h"
+#include <stdio.h>
+
+// Mesh loading benchmark: startup cost of a 1M-edge mesh parsed from OBJ
+// versus mapped from a binary mesh file, with and without validation.
+
+#define OBJ_PATH "bench_mesh_file.obj"
+#define MESH_PATH "bench_mesh_file.t3dm"
+
+typedef struct {
+    unsigned int verify;
+    long sink;
+} open_ctx_t;
+
+static void run_import_obj(void* p) {
+    open_ctx_t* c = p;
+    indexed_mesh_t* mesh = mesh_file_import_obj(OBJ_PATH, NULL);
+    c->sink += mesh->num_edges;
+    indexed_mesh_destroy(mesh);
+}
+
+static void run_open(void* p) {
+    open_ctx_t* c = p;
+    mesh_file_t* file = mesh_file_open(MESH_PATH, c->verify, NULL);
+    c->sink += file->mesh.num_edges;
+    mesh_file_close(file);
+}
+
+int main() {
+    enum { VERTICES = 250000, EDGES = 1000000 };
+    bench_harness_t h;
+    bench_init(&h, "mesh_file");
+
+    // Random-walk vertices with short edges, written as OBJ polylines
+    bench_rng_t rng = { 22 };
+    FILE* fp = fopen(OBJ_PATH, "w");
+    if (!fp) return 1;
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    for (int i = 0; i < VERTICES; i++) {
+        x += bench_rng_float(&rng, -0.01f, 0.01f);
+        y += bench_rng_float(&rng, -0.01f, 0.01f);
+        z += bench_rng_float(&rng, -0.01f, 0.01f);
+        fprintf(fp, "v %.6f %.6f %.6f\n", x, y, z);
+    }
+    for (int i = 0; i < EDGES; i++) {
+        int a = (int)(bench_rng_next(&rng) % VERTICES);
+        int b = (a + 1 + i / VERTICES) % VERTICES;  // Distinct edges
+        fprintf(fp, "l %d %d\n", a + 1, b + 1);
+    }
+    fclose(fp);
+    if (mesh_file_convert_obj(OBJ_PATH, MESH_PATH) != MESH_FILE_OK) return 1;
+
+    char params[64];
+    bench_work_t work = { .vertices = VERTICES, .edges = EDGES };
+    open_ctx_t ctx = { 0, 0 };
+    snprintf(params, sizeof(params), "%d edges", EDGES);
+    bench_run(&h, "import_obj", params, run_import_obj, &ctx, work, NULL);
+
+    const unsigned int verify[] = { MESH_FILE_TRUST_INDICES, 0, MESH_FILE_VERIFY_ALL };
+    const char* names[] = { " trusted", "", " +checksum" };
+    for (int v = 0; v < 3; v++) {
+        ctx.verify = verify[v];
+        snprintf(params, sizeof(params), "%d edges%s", EDGES, names[v]);
+        bench_run(&h, "mesh_file_open", params, run_open, &ctx, work, NULL);
+    }
+
+    remove(OBJ_PATH);
+    remove(MESH_PATH);
+    bench_finish(&h);
+    return ctx.sink == 0;
+}
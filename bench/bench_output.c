@@ -0,0 +1,95 @@
+#include "bench_harness.h"
+#include "../include/canvas.h"
+#include "../include/frame_sink.h"
+#include "../include/cpu.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Frame output benchmark: one PPM per frame (the old demo path) vs a single
+// y4m stream with a writer thread vs the memory-mapped ring. Each operation
+// writes a short clip, opening and closing included. Frames go to build/ and
+// are deleted afterwards.
+
+enum { WIDTH = 800, HEIGHT = 600, FRAMES = 16, QN = 1 << 20 };
+
+typedef struct {
+    canvas_t* canvas;
+    const float* values;
+    unsigned char* bytes;
+} output_ctx_t;
+
+static void run_quantize(void* p) {
+    output_ctx_t* c = p;
+    canvas_quantize_u8(c->values, c->bytes, QN);
+}
+
+static void run_ppm(void* p) {
+    output_ctx_t* c = p;
+    for (int f = 0; f < FRAMES; f++) canvas_save_ppm(c->canvas, "build/bench_output%03d.ppm", f);
+}
+
+static void run_y4m(void* p) {
+    output_ctx_t* c = p;
+    frame_sink_t* sink = frame_sink_open("build/bench_output.y4m", FRAME_SINK_Y4M, WIDTH, HEIGHT, 30);
+    for (int f = 0; f < FRAMES; f++) frame_sink_submit(sink, c->canvas);
+    frame_sink_close(sink);
+}
+
+static void run_ring(void* p) {
+    output_ctx_t* c = p;
+    frame_sink_t* sink = frame_sink_open_ring("build/bench_output.ring", WIDTH, HEIGHT, 8);
+    for (int f = 0; f < FRAMES; f++) frame_sink_submit(sink, c->canvas);
+    frame_sink_close(sink);
+}
+
+int main() {
+    bench_harness_t h;
+    bench_init(&h, "output");
+
+    output_ctx_t ctx = { .canvas = create_canvas(WIDTH, HEIGHT) };
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            ctx.canvas->pixels[y][x] = (float)((x ^ y) & 255) / 255.0f;
+        }
+    }
+
+    // Quantization kernels alone
+    float* values = malloc(sizeof(float) * QN);
+    ctx.values = values;
+    ctx.bytes = malloc(QN);
+    for (int i = 0; i < QN; i++) values[i] = (float)(i % 1000) / 900.0f - 0.05f;
+    const unsigned int masks[] = { 0, CPU_FEATURE_SSE2, ~0u };
+    const char* names[] = { "scalar", "sse2", "avx2" };
+    bench_work_t quantize_work = { .pixels = QN };
+    for (int m = 0; m < 3; m++) {
+        cpu_set_feature_mask(masks[m]);
+        bench_run(&h, "canvas_quantize_u8", names[m], run_quantize, &ctx, quantize_work, NULL);
+    }
+    cpu_set_feature_mask(~0u);
+    free(values);
+    free(ctx.bytes);
+
+    char params[64];
+    snprintf(params, sizeof(params), "%d frames %dx%d", FRAMES, WIDTH, HEIGHT);
+    bench_work_t work = { .pixels = (double)FRAMES * WIDTH * HEIGHT };
+    bench_run(&h, "ppm", params, run_ppm, &ctx, work, NULL);
+    char path[64];
+    for (int f = 0; f < FRAMES; f++) {
+        snprintf(path, sizeof(path), "build/bench_output%03d.ppm", f);
+        remove(path);
+    }
+
+    bench_run(&h, "y4m", params, run_y4m, &ctx, work, NULL);
+    remove("build/bench_output.y4m");
+
+    frame_sink_t* probe = frame_sink_open_ring("build/bench_output.ring", WIDTH, HEIGHT, 8);
+    if (probe) {
+        frame_sink_close(probe);
+        bench_run(&h, "ring", params, run_ring, &ctx, work, NULL);
+        remove("build/bench_output.ring");
+    }
+
+    free_canvas(ctx.canvas);
+    bench_finish(&h);
+    return 0;
+}
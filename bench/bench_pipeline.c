@@ -0,0 +1,358 @@
+#include "bench_harness.h"
+#include "bench_fixtures.h"
+#include "../include/tiny3d.h"
+#include <math.h>
+
+// Pipeline benchmark suite: one case per stage (matrix math, vertex
+// projection, line drawing, full wireframe frames, 8-bit conversion, lighting)
+// on reproducible synthetic meshes and canvases from 256x256 to 4K, float and
+// fixed-point. Run through `make bench` to append the results to
+// build/bench-<commit>.jsonl.
+
+typedef struct {
+    const char* name;
+    int width;
+    int height;
+} canvas_size_t;
+
+static const canvas_size_t sizes[] = {
+    { "256x256", 256, 256 },
+    { "800x600", 800, 600 },
+    { "1920x1080", 1920, 1080 },
+    { "3840x2160", 3840, 2160 }
+};
+#define NUM_SIZES (int)(sizeof(sizes) / sizeof(sizes[0]))
+
+// Synthetic meshes
+
+// Truncated icosahedron of unit radius (the demo's soccer ball, indexed)
+static indexed_mesh_t* make_soccer_ball(void) {
+    const float phi = (1.0f + sqrtf(5.0f)) / 2.0f;
+    const float base[3][3] = {
+        { 0.0f, 1.0f, 3.0f * phi },
+        { 1.0f, 2.0f + phi, 2.0f * phi },
+        { phi, 2.0f, 2.0f * phi + 1.0f }
+    };
+    indexed_mesh_t* mesh = indexed_mesh_create(60, 90);
+    int count = 0;
+    for (int b = 0; b < 3; b++) {
+        for (int signs = 0; signs < 8; signs++) {
+            float p[3];
+            int duplicate = 0;
+            for (int k = 0; k < 3; k++) {
+                p[k] = (signs & (1 << k)) ? -base[b][k] : base[b][k];
+                if (base[b][k] == 0.0f && (signs & (1 << k))) duplicate = 1;
+            }
+            if (duplicate) continue;
+            for (int rot = 0; rot < 3; rot++) {
+                mesh->vertices[count++] = vec3f_make(p[rot % 3], p[(rot + 1) % 3], p[(rot + 2) % 3]);
+            }
+        }
+    }
+
+    int edges = 0;
+    for (int i = 0; i < count; i++) {
+        for (int j = i + 1; j < count; j++) {
+            vec3f_t d = vec3f_sub(mesh->vertices[i], mesh->vertices[j]);
+            if (fabsf(vec3f_dot(d, d) - 4.0f) < 1e-3f && edges < 90) {
+                mesh->indices[2*edges] = i;
+                mesh->indices[2*edges + 1] = j;
+                edges++;
+            }
+        }
+    }
+    const float radius = sqrtf(9.0f * phi + 10.0f);
+    for (int i = 0; i < count; i++) mesh->vertices[i] = vec3f_scale(mesh->vertices[i], 1.0f / radius);
+    indexed_mesh_compute_bounds(mesh);
+    return mesh;
+}
+
+// Random graph: vertices on a clamped random walk, each edge joining a vertex
+// to one of its next 16, so edges stay short like a dense scanned mesh
+static indexed_mesh_t* make_random_graph(int num_vertices, int num_edges, unsigned long long seed) {
+    indexed_mesh_t* mesh = indexed_mesh_create(num_vertices, num_edges);
+    bench_rng_t rng = { seed };
+    vec3f_t p = vec3f_make(0.0f, 0.0f, 0.0f);
+    for (int i = 0; i < num_vertices; i++) {
+        p.x = fminf(fmaxf(p.x + bench_rng_float(&rng, -0.01f, 0.01f), -1.0f), 1.0f);
+        p.y = fminf(fmaxf(p.y + bench_rng_float(&rng, -0.01f, 0.01f), -1.0f), 1.0f);
+        p.z = fminf(fmaxf(p.z + bench_rng_float(&rng, -0.01f, 0.01f), -1.0f), 1.0f);
+        mesh->vertices[i] = p;
+    }
+    for (int i = 0; i < num_edges; i++) {
+        int a = (int)(bench_rng_next(&rng) % (unsigned)num_vertices);
+        mesh->indices[2*i] = a;
+        mesh->indices[2*i + 1] = (a + 1 + (int)(bench_rng_next(&rng) % 16)) % num_vertices;
+    }
+    indexed_mesh_compute_bounds(mesh);
+    return mesh;
+}
+
+static void camera_for(const canvas_size_t* size, mat4_t* world, mat4_t* view, mat4_t* proj) {
+    float aspect = (float)size->width / size->height;
+    mat4_rotate_xyz(world, 0.4f, 0.9f, 0.1f);
+    mat4_translate(view, 0.0f, 0.0f, -3.5f);
+    mat4_frustum_asymmetric(proj, -0.5f * aspect, 0.5f * aspect, -0.5f, 0.5f, 1.0f, 20.0f);
+}
+
+// Cases
+
+typedef struct {
+    mat4_t a, b, result;
+} mat4_ctx_t;
+
+static void run_mat4_multiply(void* p) {
+    mat4_ctx_t* c = p;
+    mat4_multiply(&c->result, &c->a, &c->b);
+}
+
+typedef struct {
+    mat4_t* a;
+    mat4_t* b;
+    mat4_t* results;
+    int count;
+} mat4_batch_ctx_t;
+
+static void run_mat4_multiply_batch(void* p) {
+    mat4_batch_ctx_t* c = p;
+    mat4_multiply_batch(c->results, c->a, c->b, c->count);
+}
+
+typedef struct {
+    const vec3f_t* vertices;
+    int count;
+    int next;
+    mat4_t world, view, proj;
+    int width, height;
+    float sink;
+} project_ctx_t;
+
+static void run_project_vertex(void* p) {
+    project_ctx_t* c = p;
+    vec3f_t v = project_vertex(c->vertices[c->next], c->world, c->view, c->proj, c->width, c->height);
+    c->sink += v.x;
+    c->next = c->next + 1 < c->count ? c->next + 1 : 0;
+}
+
+typedef struct {
+    mat4_t mvp;
+    const vec3f_t* vertices;
+    int count;
+    int width, height;
+    float* out_x;
+    float* out_y;
+    float* out_depth;
+} transform_ctx_t;
+
+static void run_transform_vertices(void* p) {
+    transform_ctx_t* c = p;
+    transform_vertices(&c->mvp, c->vertices, c->count, c->width, c->height,
+                       c->out_x, c->out_y, c->out_depth);
+}
+
+typedef struct {
+    canvas_t* canvas;
+    const float* coords;  // x0, y0, x1, y1 per line
+    int count;
+} lines_ctx_t;
+
+static void run_draw_line_f(void* p) {
+    lines_ctx_t* c = p;
+    for (int i = 0; i < c->count; i++) {
+        const float* l = c->coords + 4*i;
+        draw_line_f(c->canvas, l[0], l[1], l[2], l[3], 1.0f);
+    }
+}
+
+static void run_draw_line_aa(void* p) {
+    lines_ctx_t* c = p;
+    for (int i = 0; i < c->count; i++) {
+        const float* l = c->coords + 4*i;
+        draw_line_aa(c->canvas, l[0], l[1], l[2], l[3], 1.0f, 1.0f);
+    }
+}
+
+typedef struct {
+    canvas_t* canvas;
+    const indexed_mesh_t* mesh;
+    mat4_t world, view, proj;
+} frame_ctx_t;
+
+static void run_render_wireframe(void* p) {
+    frame_ctx_t* c = p;
+    canvas_clear(c->canvas, 0.0f);
+    render_wireframe(c->canvas, c->mesh, c->world, c->view, c->proj);
+}
+
+typedef struct {
+    canvas_t* canvas;
+    unsigned char* out;
+} quantize_ctx_t;
+
+static void run_quantize_frame(void* p) {
+    quantize_ctx_t* c = p;
+    for (int y = 0; y < c->canvas->height; y++) {
+        canvas_quantize_row_u8(c->canvas, y, c->out + (size_t)y * c->canvas->width);
+    }
+}
+
+typedef struct {
+    mesh_t* mesh;
+    light_t lights[4];
+} lighting_ctx_t;
+
+static void run_apply_lighting(void* p) {
+    lighting_ctx_t* c = p;
+    apply_lighting(c->mesh, c->lights, 4);
+}
+
+static mesh_t* edge_soup(const indexed_mesh_t* mesh, int num_edges) {
+    mesh_t* soup = malloc(sizeof(mesh_t));
+    soup->edges = calloc(num_edges, sizeof(edge_t));
+    soup->num_edges = num_edges;
+    for (int i = 0; i < num_edges; i++) {
+        vec3f_t a = mesh->vertices[mesh->indices[2*i]];
+        vec3f_t b = mesh->vertices[mesh->indices[2*i + 1]];
+        soup->edges[i].v0 = vec3_from_vec3f(a);
+        soup->edges[i].v1 = vec3_from_vec3f(b);
+    }
+    return soup;
+}
+
+static void free_edge_soup(mesh_t* soup) {
+    free(soup->edges);
+    free(soup);
+}
+
+int main() {
+    bench_harness_t h;
+    bench_init(&h, "pipeline");
+    bench_rng_t rng = { 20 };
+    char params[64];
+
+    indexed_mesh_t* cube = make_cube();
+    indexed_mesh_t* ball = make_soccer_ball();
+    indexed_mesh_t* graph = make_random_graph(250000, 1000000, 1);
+    const indexed_mesh_t* meshes[] = { cube, ball, graph };
+    const char* mesh_names[] = { "cube", "ball", "graph1M" };
+
+    // Matrix math
+    mat4_ctx_t m;
+    mat4_rotate_xyz(&m.a, 0.3f, 0.5f, 0.7f);
+    mat4_frustum_asymmetric(&m.b, -0.5f, 0.5f, -0.4f, 0.4f, 1.0f, 50.0f);
+    bench_run(&h, "mat4_multiply", "4x4", run_mat4_multiply, &m, (bench_work_t){ 0 }, NULL);
+
+    mat4_batch_ctx_t mb = { malloc(sizeof(mat4_t) * 1024), malloc(sizeof(mat4_t) * 1024),
+                            malloc(sizeof(mat4_t) * 1024), 1024 };
+    for (int i = 0; i < mb.count; i++) {
+        mat4_rotate_xyz(&mb.a[i], bench_rng_float(&rng, -3, 3), bench_rng_float(&rng, -3, 3), 0.0f);
+        mat4_translate(&mb.b[i], bench_rng_float(&rng, -5, 5), 0.0f, bench_rng_float(&rng, -5, 5));
+    }
+    bench_run(&h, "mat4_multiply_batch", "1024", run_mat4_multiply_batch, &mb,
+              (bench_work_t){ 0 }, NULL);
+    free(mb.a);
+    free(mb.b);
+    free(mb.results);
+
+    // Vertex projection, scalar per-vertex path and the batch transform
+    project_ctx_t pv = { graph->vertices, 4096, 0, .width = 1920, .height = 1080 };
+    camera_for(&sizes[2], &pv.world, &pv.view, &pv.proj);
+    bench_run(&h, "project_vertex", "1920x1080", run_project_vertex, &pv,
+              (bench_work_t){ .vertices = 1 }, NULL);
+
+    transform_ctx_t tv = { .vertices = graph->vertices, .count = 65536, .width = 1920, .height = 1080 };
+    mat4_t mv;
+    mat4_multiply(&mv, &pv.view, &pv.world);
+    mat4_multiply(&tv.mvp, &pv.proj, &mv);
+    tv.out_x = malloc(sizeof(float) * tv.count);
+    tv.out_y = malloc(sizeof(float) * tv.count);
+    tv.out_depth = malloc(sizeof(float) * tv.count);
+    snprintf(params, sizeof(params), "%d %s", tv.count, transform_kernel_name(transform_active_kernel()));
+    bench_run(&h, "transform_vertices", params, run_transform_vertices, &tv,
+              (bench_work_t){ .vertices = tv.count }, NULL);
+    free(tv.out_x);
+    free(tv.out_y);
+    free(tv.out_depth);
+
+    // Line drawing: 256 random lines about a quarter of the canvas long
+    for (int s = 0; s < NUM_SIZES; s++) {
+        canvas_t* canvas = create_canvas(sizes[s].width, sizes[s].height);
+        enum { LINES = 256 };
+        float coords[4 * LINES];
+        double pixels = 0.0;
+        float reach = 0.25f * (sizes[s].width < sizes[s].height ? sizes[s].width : sizes[s].height);
+        for (int i = 0; i < LINES; i++) {
+            float x = bench_rng_float(&rng, 0.0f, sizes[s].width);
+            float y = bench_rng_float(&rng, 0.0f, sizes[s].height);
+            float angle = bench_rng_float(&rng, 0.0f, 6.2831853f);
+            coords[4*i] = x;
+            coords[4*i + 1] = y;
+            coords[4*i + 2] = x + reach * cosf(angle);
+            coords[4*i + 3] = y + reach * sinf(angle);
+            pixels += reach;  // One pixel wide
+        }
+        canvas_t* canvas16 = create_canvas_format(sizes[s].width, sizes[s].height,
+                                                  CANVAS_FORMAT_UNORM16);
+        for (int f = 0; f < 2; f++) {
+            lines_ctx_t lc = { f ? canvas16 : canvas, coords, LINES };
+            snprintf(params, sizeof(params), "%d %s%s", LINES, sizes[s].name, f ? " u16" : "");
+            bench_run(&h, "draw_line_f", params, run_draw_line_f, &lc,
+                      (bench_work_t){ .edges = LINES, .pixels = pixels }, NULL);
+            bench_run(&h, "draw_line_aa", params, run_draw_line_aa, &lc,
+                      (bench_work_t){ .edges = LINES, .pixels = pixels }, NULL);
+        }
+        free_canvas(canvas);
+        free_canvas(canvas16);
+    }
+
+    // Full frames (clear + one-shot render_wireframe); pixels are frame pixels
+    for (int s = 0; s < NUM_SIZES; s++) {
+        canvas_t* canvas = create_canvas(sizes[s].width, sizes[s].height);
+        for (int k = 0; k < 3; k++) {
+            frame_ctx_t fc = { .canvas = canvas, .mesh = meshes[k] };
+            camera_for(&sizes[s], &fc.world, &fc.view, &fc.proj);
+            snprintf(params, sizeof(params), "%s %s", mesh_names[k], sizes[s].name);
+            bench_run(&h, "render_wireframe", params, run_render_wireframe, &fc,
+                      (bench_work_t){ meshes[k]->num_vertices, meshes[k]->num_edges,
+                                      (double)sizes[s].width * sizes[s].height }, NULL);
+        }
+        free_canvas(canvas);
+    }
+
+    // Frame conversion to 8-bit gray (what every output path does), per format
+    for (int s = 0; s < NUM_SIZES; s++) {
+        for (int f = 0; f < 2; f++) {
+            quantize_ctx_t qc;
+            qc.canvas = create_canvas_format(sizes[s].width, sizes[s].height,
+                                             f ? CANVAS_FORMAT_UNORM16 : CANVAS_FORMAT_FLOAT32);
+            qc.out = malloc((size_t)sizes[s].width * sizes[s].height);
+            canvas_clear(qc.canvas, 0.25f);
+            snprintf(params, sizeof(params), "%s%s", sizes[s].name, f ? " u16" : "");
+            bench_run(&h, "quantize_frame", params, run_quantize_frame, &qc,
+                      (bench_work_t){ .pixels = (double)sizes[s].width * sizes[s].height }, NULL);
+            free(qc.out);
+            free_canvas(qc.canvas);
+        }
+    }
+
+    // Lighting on edge soups
+    const int soup_edges[] = { 90, 65536 };
+    for (int k = 0; k < 2; k++) {
+        lighting_ctx_t lc;
+        lc.mesh = edge_soup(k == 0 ? ball : graph, soup_edges[k]);
+        for (int j = 0; j < 4; j++) {
+            lc.lights[j].direction = vec3f_make(bench_rng_float(&rng, -1, 1), bench_rng_float(&rng, -1, 1),
+                                                bench_rng_float(&rng, -1, 1));
+            lc.lights[j].intensity = bench_rng_float(&rng, 0.1f, 0.4f);
+        }
+        snprintf(params, sizeof(params), "%d edges 4 lights", soup_edges[k]);
+        bench_run(&h, "apply_lighting", params, run_apply_lighting, &lc,
+                  (bench_work_t){ .edges = soup_edges[k] }, NULL);
+        free_edge_soup(lc.mesh);
+    }
+
+    if (m.result.m[0] == 12345.0f || pv.sink == 12345.0f) printf("\n");  // Keep results live
+    for (int k = 0; k < 3; k++) indexed_mesh_destroy((indexed_mesh_t*)meshes[k]);
+    bench_finish(&h);
+    return 0;
+}
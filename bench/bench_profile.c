@@ -0,0 +1,75 @@
+#include "bench_harness.h"
+#include "../include/renderer.h"
+#include "../include/profile.h"
+#include <stdio.h>
+
+// Profiling overhead: the same wireframe frames with no profile attached,
+// with counters only, and with the trace log recording every stage call.
+// Small meshes show the fixed per-call cost, large ones the per-edge cost.
+
+typedef struct {
+    renderer_t* renderer;
+    indexed_mesh_t* mesh;
+    mat4_t world, view, proj;
+    profile_t* profile;
+} profile_ctx_t;
+
+static void run_frame(void* p) {
+    profile_ctx_t* c = p;
+    if (c->profile) {
+        if (c->profile->num_events > 100000) profile_reset(c->profile);  // Keep the log bounded
+        profile_begin_frame(c->profile);
+    }
+    renderer_begin_frame(c->renderer);
+    canvas_clear(c->renderer->canvas, 0.0f);
+    renderer_draw_wireframe(c->renderer, c->mesh, &c->world, &c->view, &c->proj);
+    if (c->profile) profile_end_frame(c->profile);
+}
+
+int main() {
+    bench_harness_t h;
+    bench_init(&h, "profile");
+
+    canvas_t* canvas = create_canvas(256, 256);
+    profile_ctx_t ctx = { .renderer = renderer_create(canvas) };
+    mat4_rotate_xyz(&ctx.world, 0.4f, 0.9f, 0.0f);
+    mat4_translate(&ctx.view, 0.0f, 0.0f, -4.0f);
+    mat4_frustum_asymmetric(&ctx.proj, -0.5f, 0.5f, -0.5f, 0.5f, 1.0f, 20.0f);
+
+    profile_t counters, tracing;
+    profile_init(&counters, 0);
+    profile_init(&tracing, 1 << 20);
+    profile_t* profiles[] = { NULL, &counters, &tracing };
+    const char* modes[] = { "off", "counters", "trace" };
+
+    const int sizes[] = { 12, 2000 };
+    bench_rng_t rng = { 24 };
+    char params[64];
+    for (int s = 0; s < 2; s++) {
+        int edges = sizes[s], vertices = edges / 2 + 2;
+        ctx.mesh = indexed_mesh_create(vertices, edges);
+        for (int i = 0; i < vertices; i++) {
+            ctx.mesh->vertices[i] = vec3f_make(bench_rng_float(&rng, -0.5f, 0.5f),
+                                               bench_rng_float(&rng, -0.5f, 0.5f),
+                                               bench_rng_float(&rng, -0.5f, 0.5f));
+        }
+        for (int i = 0; i < 2 * edges; i++) ctx.mesh->indices[i] = (int)(bench_rng_next(&rng) % vertices);
+        indexed_mesh_compute_bounds(ctx.mesh);
+
+        bench_work_t work = { .vertices = vertices, .edges = edges };
+        for (int m = 0; m < 3; m++) {
+            ctx.profile = profiles[m];
+            ctx.renderer->profile = profiles[m];
+            snprintf(params, sizeof(params), "%d edges, %s", edges, modes[m]);
+            bench_run(&h, "profiled_frame", params, run_frame, &ctx, work, NULL);
+        }
+        indexed_mesh_destroy(ctx.mesh);
+    }
+
+    profile_destroy(&counters);
+    profile_destroy(&tracing);
+    renderer_destroy(ctx.renderer);
+    free_canvas(canvas);
+    bench_finish(&h);
+    return 0;
+}
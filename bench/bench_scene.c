@@ -0,0 +1,59 @@
+#include "bench_harness.h"
+#include "../include/scene.h"
+#include <stdio.h>
+
+// Scene graph benchmark: world-matrix update of a 4-ary tree when a small
+// fraction of nodes moves each frame, versus recomputing every node.
+
+enum { NUM_NODES = 100000 };
+
+typedef struct {
+    scene_t scene;
+    bench_rng_t rng;
+    int moving;         // Nodes moved per frame
+    int frame;
+    long recomputed;
+    long frames;
+} scene_ctx_t;
+
+static void run_update(void* p) {
+    scene_ctx_t* c = p;
+    for (int m = 0; m < c->moving; m++) {
+        int node = c->moving == NUM_NODES ? m : (int)(bench_rng_next(&c->rng) % NUM_NODES);
+        scene_set_rotation(&c->scene, node, vec3f_make(0.01f * c->frame, 0.0f, 0.0f));
+    }
+    c->recomputed += scene_update(&c->scene);
+    c->frames++;
+    c->frame++;
+}
+
+int main() {
+    bench_harness_t h;
+    bench_init(&h, "scene");
+
+    scene_ctx_t ctx = { .rng = { 4 } };
+    scene_init(&ctx.scene, NUM_NODES);
+    scene_add_node(&ctx.scene, -1);
+    for (int i = 1; i < NUM_NODES; i++) {
+        int node = scene_add_node(&ctx.scene, (i - 1) / 4);
+        scene_set_trs(&ctx.scene, node, vec3f_make(0.1f * (i % 7), 0.2f, 0.0f),
+                      vec3f_make(0.01f * (i % 11), 0.0f, 0.0f), vec3f_make(1.0f, 1.0f, 1.0f));
+    }
+    scene_update(&ctx.scene);
+
+    const double fractions[] = { 0.001, 0.01, 0.1, 1.0 };
+    const bench_work_t none = { 0 };
+    char params[64];
+    for (int k = 0; k < 4; k++) {
+        ctx.moving = (int)(NUM_NODES * fractions[k]);
+        ctx.recomputed = ctx.frames = 0;
+        snprintf(params, sizeof(params), "%d nodes, %.1f%% moving", NUM_NODES, 100.0 * fractions[k]);
+        bench_run(&h, "scene_update", params, run_update, &ctx, none, NULL);
+        printf("  %.1f%% moving: %ld nodes recomputed per frame\n", 100.0 * fractions[k],
+               ctx.recomputed / ctx.frames);
+    }
+
+    scene_destroy(&ctx.scene);
+    bench_finish(&h);
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "bench_harness.h"
+#include "../include/sequence.h"
+#include "../include/threadpool.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Offline sequence benchmark: a 32-frame 800x600 animation of a random-walk
+// mesh rendered on 1, 2, 4 and one-per-CPU threads, with every frame
+// converted to 8-bit in order as a sink would. Speedup is reported against
+// one thread; it can only exceed 1 on a machine with more than one CPU.
+
+enum { WIDTH = 800, HEIGHT = 600, FRAMES = 32, VERTICES = 5000, EDGES = 20000 };
+
+typedef struct {
+    indexed_mesh_t* mesh;
+    mat4_t view;
+    mat4_t proj;
+    unsigned char* frame;  // 8-bit output of the latest frame
+    long sink;
+    int threads;
+} sequence_ctx_t;
+
+static void draw_frame(void* user, renderer_t* renderer, int worker, int frame, double time) {
+    (void)worker;
+    (void)frame;
+    sequence_ctx_t* c = user;
+    float angle = (float)time;
+    mat4_t world;
+    mat4_rotate_xyz(&world, angle, angle * 0.7f, angle * 0.3f);
+    renderer_draw_wireframe(renderer, c->mesh, &world, &c->view, &c->proj);
+}
+
+static int consume_frame(void* user, const canvas_t* canvas, int frame) {
+    (void)frame;
+    sequence_ctx_t* c = user;
+    for (int y = 0; y < canvas->height; y++) {
+        canvas_quantize_row_u8(canvas, y, c->frame + (size_t)y * canvas->width);
+    }
+    const unsigned char* row = c->frame + (size_t)(canvas->height / 2) * canvas->width;
+    for (int x = 0; x < canvas->width; x++) c->sink += row[x];
+    return 0;
+}
+
+static void run_sequence(void* p) {
+    sequence_ctx_t* c = p;
+    sequence_desc_t desc;
+    sequence_desc_init(&desc, WIDTH, HEIGHT);
+    desc.num_frames = FRAMES;
+    desc.draw = draw_frame;
+    desc.user = c;
+    desc.output = consume_frame;
+    desc.output_user = c;
+    sequence_render(&desc, c->threads, NULL);
+}
+
+int main() {
+    bench_harness_t h;
+    bench_init(&h, "sequence");
+
+    sequence_ctx_t ctx = { 0 };
+    ctx.mesh = indexed_mesh_create(VERTICES, EDGES);
+    bench_rng_t rng = { 23 };
+    // Random walk with short edges between nearby vertices
+    vec3f_t p = vec3f_make(0.0f, 0.0f, 0.0f);
+    for (int i = 0; i < VERTICES; i++) {
+        p = vec3f_make(p.x + bench_rng_float(&rng, -0.01f, 0.01f),
+                       p.y + bench_rng_float(&rng, -0.01f, 0.01f),
+                       p.z + bench_rng_float(&rng, -0.01f, 0.01f));
+        ctx.mesh->vertices[i] = p;
+    }
+    for (int i = 0; i < EDGES; i++) {
+        int a = (int)(bench_rng_next(&rng) % VERTICES);
+        ctx.mesh->indices[2*i] = a;
+        ctx.mesh->indices[2*i + 1] = (a + 1 + i % 4) % VERTICES;
+    }
+    indexed_mesh_compute_bounds(ctx.mesh);
+    mat4_translate(&ctx.view, 0.0f, 0.0f, -4.0f);
+    mat4_frustum_asymmetric(&ctx.proj, -0.5f, 0.5f, -0.375f, 0.375f, 1.0f, 20.0f);
+    ctx.frame = malloc((size_t)WIDTH * HEIGHT);
+
+    const int cpus = threadpool_cpu_count();
+    const int threads[] = { 1, 2, 4, cpus };
+    bench_work_t work = { .edges = (double)FRAMES * EDGES, .pixels = (double)FRAMES * WIDTH * HEIGHT };
+    double single = 0.0;
+    char params[64];
+    for (int t = 0; t < 4; t++) {
+        if (t == 3 && (cpus == 1 || cpus == 2 || cpus == 4)) break;  // Already measured
+        ctx.threads = threads[t];
+        bench_stats_t stats;
+        snprintf(params, sizeof(params), "%d frames, %d thr", FRAMES, ctx.threads);
+        bench_run(&h, "sequence_render", params, run_sequence, &ctx, work, &stats);
+        if (t == 0) single = stats.p50;
+        printf("  %d thread(s): %.2f ms/frame, speedup %.2fx on %d CPU(s)\n", ctx.threads,
+               stats.p50 / FRAMES * 1e-6, single / stats.p50, cpus);
+    }
+
+    free(ctx.frame);
+    indexed_mesh_destroy(ctx.mesh);
+    bench_finish(&h);
+    return ctx.sink == 0;
+}
@@ -0,0 +1,78 @@
+#include "bench_harness.h"
+#include "../include/depth_sort.h"
+#include "../include/renderer.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Depth sort benchmark: qsort of edge_depth_t records vs radix sort of keys.
+// Times qsort, pure radix and the renderer's hybrid path across sizes, and
+// reports where radix overtakes qsort.
+
+typedef struct {
+    const float* depths;
+    edge_depth_t* edges;
+    arena_t arena;
+    int count;
+} sort_ctx_t;
+
+static int compare_edges(const void* a, const void* b) {
+    const edge_depth_t* ea = a;
+    const edge_depth_t* eb = b;
+    return (ea->depth < eb->depth) - (ea->depth > eb->depth); // Back-to-front
+}
+
+static void run_qsort(void* p) {
+    sort_ctx_t* c = p;
+    for (int i = 0; i < c->count; i++) {
+        c->edges[i] = (edge_depth_t){ .segment = i, .depth = c->depths[i] };
+    }
+    qsort(c->edges, c->count, sizeof(edge_depth_t), compare_edges);
+}
+
+static void run_radix(void* p) {
+    sort_ctx_t* c = p;
+    arena_reset(&c->arena);
+    depth_sort_radix(&c->arena, c->depths, c->count);
+}
+
+static void run_hybrid(void* p) {
+    sort_ctx_t* c = p;
+    arena_reset(&c->arena);
+    depth_sort_back_to_front(&c->arena, c->depths, c->count);
+}
+
+int main() {
+    const int max_count = 1 << 20;
+    bench_harness_t h;
+    bench_init(&h, "sort");
+
+    float* depths = malloc(sizeof(float) * max_count);
+    sort_ctx_t ctx = { .depths = depths, .edges = malloc(sizeof(edge_depth_t) * max_count) };
+    arena_init(&ctx.arena, 0);
+    bench_rng_t rng = { 42 };
+    for (int i = 0; i < max_count; i++) depths[i] = bench_rng_float(&rng, -1.0f, 1.0f);
+
+    int crossover = -1;
+    char params[64];
+    for (int count = 8; count <= max_count; count *= 4) {
+        ctx.count = count;
+        bench_work_t work = { .edges = count };
+        bench_stats_t qsort_stats, radix_stats;
+        snprintf(params, sizeof(params), "%d edges", count);
+        bench_run(&h, "qsort", params, run_qsort, &ctx, work, &qsort_stats);
+        bench_run(&h, "radix", params, run_radix, &ctx, work, &radix_stats);
+        bench_run(&h, "hybrid", params, run_hybrid, &ctx, work, NULL);
+        if (crossover < 0 && radix_stats.p50 < qsort_stats.p50) crossover = count;
+    }
+    if (crossover > 0) {
+        printf("Radix sort is faster from %d edges\n", crossover);
+    } else {
+        printf("Radix sort was not faster at any measured size\n");
+    }
+
+    arena_destroy(&ctx.arena);
+    free(ctx.edges);
+    free(depths);
+    bench_finish(&h);
+    return 0;
+}
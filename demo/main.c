@@ -1,5 +1,6 @@
-#include "include/tiny3d.h"
+#include "../include/tiny3d.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 
 // Enable/disable specific demos
@@ -8,10 +9,70 @@
 #define DEMO_TASK3 1
 #define DEMO_TASK4 1
 
+// Truncated icosahedron (60 vertices, 90 edges) as a legacy edge soup.
+// Vertices are the cyclic permutations of (0, ±1, ±3φ), (±1, ±(2+φ), ±2φ)
+// and (±φ, ±2, ±(2φ+1)); with these coordinates every edge has length 2.
+mesh_t* generate_soccer_ball(void) {
+    const float phi = (1.0f + sqrtf(5.0f)) / 2.0f;
+    const float base[3][3] = {
+        { 0.0f, 1.0f, 3.0f * phi },
+        { 1.0f, 2.0f + phi, 2.0f * phi },
+        { phi, 2.0f, 2.0f * phi + 1.0f }
+    };
+
+    vec3_t verts[60];
+    int count = 0;
+    for (int b = 0; b < 3; b++) {
+        for (int signs = 0; signs < 8; signs++) {
+            float p[3];
+            int duplicate = 0;
+            for (int k = 0; k < 3; k++) {
+                p[k] = (signs & (1 << k)) ? -base[b][k] : base[b][k];
+                if (base[b][k] == 0.0f && (signs & (1 << k))) duplicate = 1;
+            }
+            if (duplicate) continue;  // -0 is the same point as +0
+            for (int rot = 0; rot < 3; rot++) {
+                verts[count++] = (vec3_t){ .x = p[rot % 3],
+                                           .y = p[(rot + 1) % 3],
+                                           .z = p[(rot + 2) % 3] };
+            }
+        }
+    }
+
+    mesh_t* mesh = malloc(sizeof(mesh_t));
+    mesh->edges = malloc(sizeof(edge_t) * 90);
+    mesh->num_edges = 0;
+
+    // Connect every pair of vertices at edge distance, scaled to unit radius
+    const float radius = sqrtf(9.0f * phi + 10.0f);
+    for (int i = 0; i < count; i++) {
+        for (int j = i + 1; j < count; j++) {
+            float dx = verts[i].x - verts[j].x;
+            float dy = verts[i].y - verts[j].y;
+            float dz = verts[i].z - verts[j].z;
+            if (fabsf(dx*dx + dy*dy + dz*dz - 4.0f) < 1e-3f && mesh->num_edges < 90) {
+                edge_t* e = &mesh->edges[mesh->num_edges++];
+                e->v0 = (vec3_t){ .x = verts[i].x / radius, .y = verts[i].y / radius,
+                                  .z = verts[i].z / radius };
+                e->v1 = (vec3_t){ .x = verts[j].x / radius, .y = verts[j].y / radius,
+                                  .z = verts[j].z / radius };
+            }
+        }
+    }
+    return mesh;
+}
+
+void mesh_destroy(mesh_t* mesh) {
+    if (mesh) {
+        free(mesh->edges);
+        free(mesh);
+    }
+}
+
 void demo_task1() {
     #if DEMO_TASK1
     printf("\n=== Running Task 1 Demo ===\n");
-    canvas_t* canvas = canvas_create(800, 600);
+    canvas_t* canvas = create_canvas(800, 600);
     
     // Draw clock-like lines from center
     float cx = canvas->width/2.0f;
@@ -26,7 +87,7 @@ void demo_task1() {
     }
     
     canvas_save_ppm(canvas, "task1_demo.ppm");
-    canvas_destroy(canvas);
+    free_canvas(canvas);
     #endif
 }
 
@@ -36,9 +97,8 @@ void demo_task2() {
     // Create and transform a cube
     mat4_t model, view, projection;
     
-    mat4_identity(&model);
-    mat4_translate(&model, 2.0f, 3.0f, -5.0f);
-    mat4_rotate_xyz(&model, 0.5f, 0.2f, 0.3f);
+    mat4_trs(&model, vec3f_make(2.0f, 3.0f, -5.0f), vec3f_make(0.5f, 0.2f, 0.3f),
+             vec3f_make(1.0f, 1.0f, 1.0f));
     
     mat4_identity(&view);
     mat4_translate(&view, 0.0f, 0.0f, -10.0f);
@@ -47,8 +107,7 @@ void demo_task2() {
     
     // Print combined matrix
     mat4_t mvp;
-    mat4_multiply(&mvp, &model, &view);
-    mat4_multiply(&mvp, &mvp, &projection);
+    mat4_mvp(&mvp, &model, &view, &projection);
     
     printf("Model-View-Projection Matrix:\n");
     for(int i = 0; i < 4; i++) {
@@ -60,40 +119,60 @@ void demo_task2() {
     #endif
 }
 
+// Task 3 scene: one rotating soccer ball; each frame's pose is a pure
+// function of the frame number, so frames can be drawn in any order
+typedef struct {
+    const indexed_mesh_t* ball;
+    mat4_t view;
+    mat4_t proj;
+} task3_scene_t;
+
+static void task3_draw(void* user, renderer_t* renderer, int worker, int frame, double time) {
+    (void)worker;
+    (void)time;
+    const task3_scene_t* scene = user;
+    const float rotation_speed = 0.02f;
+    float angle = frame * rotation_speed;
+
+    mat4_t model;
+    mat4_rotate_xyz(&model, angle, angle*0.7f, angle*0.3f);
+    renderer_draw_wireframe(renderer, scene->ball, &model, &scene->view, &scene->proj);
+}
+
 void demo_task3() {
     #if DEMO_TASK3
     printf("\n=== Running Task 3 Demo ===\n");
-    canvas_t* canvas = canvas_create(800, 600);
-    renderer_t renderer = {
-        .canvas = canvas,
-        .fov = 60.0f,
-        .near = 0.1f,
-        .far = 100.0f
-    };
-    
-    // Generate soccer ball mesh
-    mesh_t* ball = generate_soccer_ball();
-    
-    // Animation parameters
-    float angle = 0.0f;
-    const float rotation_speed = 0.02f;
-    
-    for(int frame = 0; frame < 100; frame++) {
-        canvas_clear(canvas, 0.0f);
-        
-        // Update rotation
-        mat4_rotate_xyz(&ball->transform, 
-                       angle, 
-                       angle*0.7f, 
-                       angle*0.3f);
-        angle += rotation_speed;
-        
-        render_wireframe(&renderer, ball);
-        canvas_save_ppm(canvas, "task3_frame%03d.ppm", frame);
+
+    // Generate soccer ball mesh and convert it to the indexed format once
+    mesh_t* ball_edges = generate_soccer_ball();
+    indexed_mesh_t* ball = indexed_mesh_from_mesh(ball_edges);
+    mesh_destroy(ball_edges);
+    printf("Soccer ball: %d vertices, %d edges\n", ball->num_vertices, ball->num_edges);
+
+    task3_scene_t scene = { .ball = ball };
+    mat4_identity(&scene.view);
+    mat4_translate(&scene.view, 0.0f, 0.0f, -3.0f);
+    mat4_frustum_asymmetric(&scene.proj, -0.4f, 0.4f, -0.3f, 0.3f, 1.0f, 100.0f);
+
+    // All frames go to one y4m stream, in order; frames render on every CPU
+    // and a writer thread overlaps the I/O
+    sequence_desc_t desc;
+    sequence_desc_init(&desc, 800, 600);
+    desc.num_frames = 100;
+    desc.draw = task3_draw;
+    desc.user = &scene;
+    desc.sink = frame_sink_open("task3.y4m", FRAME_SINK_Y4M, desc.width, desc.height, 30);
+    if (!desc.sink) printf("Could not open task3.y4m; frames will not be saved\n");
+
+    sequence_stats_t stats;
+    int rendered = sequence_render(&desc, 0, &stats);
+    if (frame_sink_close(desc.sink) == 0 && rendered == 0) {
+        printf("Wrote 100 frames to task3.y4m (e.g. ffmpeg -i task3.y4m task3.mp4)\n");
     }
-    
-    mesh_destroy(ball);
-    canvas_destroy(canvas);
+    printf("Rendered %d frames on %d workers in %.3f s\n",
+           stats.frames, stats.workers, stats.wall_seconds);
+
+    indexed_mesh_destroy(ball);
     #endif
 }
 
@@ -0,0 +1,69 @@
+#ifndef ANIM_POOL_H
+#define ANIM_POOL_H
+
+#include <stdint.h>
+#include "animation.h"  // For bezier_animation_t
+
+// Animation pool: many animated objects in structure-of-arrays form.
+//
+// Each object owns two cubic Bézier tracks (position and rotation). Control
+// points, durations, start times and loop flags live in contiguous arrays,
+// and anim_pool_update evaluates every track in one vectorized pass into a
+// packed pose array. Objects are densely packed (removal moves the last
+// object into the hole), so callers hold handles, which stay valid until
+// the object is removed.
+
+// Shorter (or non-positive) durations are raised to this
+#define ANIM_POOL_MIN_DURATION 1e-6f
+
+typedef struct {
+    uint32_t slot;
+    uint32_t generation;
+} anim_handle_t;
+
+// Output record, one per object in dense order
+typedef struct {
+    vec3f_t position;
+    vec3f_t rotation;
+} anim_pose_t;
+
+typedef struct {
+    int count;               // Live objects
+    int capacity;
+
+    // Per-track SoA data; object i owns tracks 2*i (position) and 2*i + 1 (rotation)
+    float* block;            // Single allocation behind the float arrays below
+    float* ctrl[12];         // p0.x, p0.y, p0.z, p1.x, ... p3.z
+    float* duration;         // Seconds, at least ANIM_POOL_MIN_DURATION
+    float* loop;             // 1.0f for looping tracks, 0.0f for one-shot
+    double* start_time;      // Double, like bezier_animation_t, so long uptimes keep precision
+
+    anim_pose_t* poses;      // Written by anim_pool_update, count entries
+
+    // Stable handles: slot -> dense index, dense index -> slot
+    int* slot_to_dense;      // Negative for free slots
+    uint32_t* generations;
+    int* dense_to_slot;
+    int free_head;           // Free slot list threaded through slot_to_dense as -2 - next
+} anim_pool_t;
+
+void anim_pool_init(anim_pool_t* pool, int initial_capacity);
+void anim_pool_destroy(anim_pool_t* pool);
+
+// Add an object; curves are copied (always evaluated exactly, ignoring
+// sample_mode). A NULL rotation keeps the rotation at zero.
+anim_handle_t anim_pool_add(anim_pool_t* pool, const bezier_animation_t* position,
+                            const bezier_animation_t* rotation);
+int anim_pool_remove(anim_pool_t* pool, anim_handle_t handle);
+int anim_pool_valid(const anim_pool_t* pool, anim_handle_t handle);
+
+// Dense index of a live object (its pose is pool->poses[index]), or -1
+int anim_pool_index(const anim_pool_t* pool, anim_handle_t handle);
+
+// Restart every track at sync_time (batch form of sync_animations)
+void anim_pool_sync(anim_pool_t* pool, double sync_time);
+
+// Evaluate every track at the given absolute time into pool->poses
+void anim_pool_update(anim_pool_t* pool, double current_time);
+
+#endif // ANIM_POOL_H
@@ -1,44 +1,84 @@
 #pragma once
 
 #include "math3d.h"
+#include "timebase.h"
 
+// How animation_get_position samples the curve
+typedef enum {
+    BEZIER_SAMPLE_EXACT = 0,  // Evaluate the cubic every call
+    BEZIER_SAMPLE_TABLE,      // O(1) interpolation in the baked table
+    BEZIER_SAMPLE_UNIFORM     // Baked table, reparameterized by arc length (constant speed)
+} bezier_sample_mode_t;
+
+#define BEZIER_TABLE_DEFAULT_ERROR 1e-3f  // Max distance from the true curve
+#define BEZIER_TABLE_MAX_SEGMENTS 4096
+
+// Baked lookup table: the curve as a polyline of forward-differenced samples
+// plus cumulative arc length. Built lazily and rebuilt when the control
+// points or the error bound no longer match the ones it was baked from.
 typedef struct {
-    vec3_t p0, p1, p2, p3;  // Control points
+    vec3f_t key[4];     // Control points at bake time
+    float max_error;    // Error bound at bake time
+    int segments;       // samples = segments + 1
+    float length;       // Polyline arc length
+    vec3f_t* points;    // segments + 1 samples, uniform in t
+    float* arc;         // Cumulative length at each sample
+    int* arc_segment;   // Segment containing length * k / segments, for O(1) uniform lookups
+} bezier_table_t;
+
+typedef struct {
+    vec3f_t p0, p1, p2, p3;  // Control points
     float duration;         // Animation duration in seconds
-    float start_time;       // When animation started
+    double start_time;      // When animation started (seconds, see get_time_seconds)
     int loop;              // 1 for looping, 0 for one-shot
+    bezier_sample_mode_t sample_mode;
+    float max_error;        // Table error bound; 0 means BEZIER_TABLE_DEFAULT_ERROR
+    bezier_table_t* table;  // Lazily baked, owned by the animation
 } bezier_animation_t;
 
 typedef struct {
-    vec3_t position;
-    vec3_t rotation;
-    vec3_t scale;
+    vec3f_t position;
+    vec3f_t rotation;
+    vec3f_t scale;
     bezier_animation_t* pos_anim;
     bezier_animation_t* rot_anim;
-    float current_time;
+    double current_time;
 } animated_object_t;
 
 // Core Bézier functions
-vec3_t vec3_bezier(const vec3_t* p0, const vec3_t* p1, const vec3_t* p2, const vec3_t* p3, float t);
+vec3f_t vec3_bezier(const vec3f_t* p0, const vec3f_t* p1, const vec3f_t* p2, const vec3f_t* p3, float t);
 float bezier_ease_in_out(float t);
 float bezier_ease_in(float t);
 float bezier_ease_out(float t);
 
 // Animation management
-bezier_animation_t* animation_create(const vec3_t* p0, const vec3_t* p1, 
-                                   const vec3_t* p2, const vec3_t* p3, 
+bezier_animation_t* animation_create(const vec3f_t* p0, const vec3f_t* p1, 
+                                   const vec3f_t* p2, const vec3f_t* p3, 
                                    float duration, int loop);
 void animation_destroy(bezier_animation_t* anim);
-vec3_t animation_get_position(bezier_animation_t* anim, float current_time);
-float animation_get_progress(bezier_animation_t* anim, float current_time);
+vec3f_t animation_get_position(bezier_animation_t* anim, double current_time);
+vec3f_t animation_sample(bezier_animation_t* anim, float t);  // t in [0, 1], honours sample_mode
+float animation_get_progress(bezier_animation_t* anim, double current_time);
+
+// Lookup tables (baking is lazy; these are for control and warm-up)
+void animation_set_control_points(bezier_animation_t* anim, const vec3f_t* p0, const vec3f_t* p1,
+                                  const vec3f_t* p2, const vec3f_t* p3);
+void animation_set_sample_mode(bezier_animation_t* anim, bezier_sample_mode_t mode, float max_error);
+int animation_bake(bezier_animation_t* anim);   // Bake now if stale; -1 on allocation failure
+void animation_invalidate(bezier_animation_t* anim);
+float animation_arc_length(bezier_animation_t* anim);
 
 // Object animation
 animated_object_t* animated_object_create(void);
 void animated_object_destroy(animated_object_t* obj);
 void animated_object_update(animated_object_t* obj, float delta_time);
+void animated_object_set_time(animated_object_t* obj, double current_time);  // For scheduler-driven updates
 void animated_object_set_position_animation(animated_object_t* obj, bezier_animation_t* anim);
 void animated_object_set_rotation_animation(animated_object_t* obj, bezier_animation_t* anim);
 
-// Timing utilities
-float get_time(void);  // Returns current time in seconds
-void sync_animations(animated_object_t** objects, int count, float sync_time);
+// Timing utilities. Animation time comes from a time source: the monotonic
+// clock by default, or an injected (e.g. manual) source for deterministic replays.
+void animation_set_time_source(const time_source_t* source);  // NULL restores the default
+double get_time_seconds(void);  // Seconds since the time source's origin
+float get_time(void);           // Same, as float (loses precision after long uptimes)
+void sync_animations(animated_object_t** objects, int count, double sync_time);
@@ -0,0 +1,48 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Every arena allocation is aligned for SIMD loads and stores
+#define ARENA_ALIGNMENT 64
+
+// Overflow block taken from the heap when a frame outgrows the main block
+typedef struct arena_block {
+    struct arena_block* next;
+    size_t size;
+} arena_block_t;
+
+// Bump allocator for per-frame scratch memory.
+// Allocations are only released all at once by arena_reset. A frame that
+// outgrows the main block spills into overflow blocks; the next reset folds
+// them back into one main block sized for the high-water mark, so steady-state
+// frames make no heap calls.
+typedef struct {
+    unsigned char* base;       // Main block (ARENA_ALIGNMENT-aligned)
+    void* raw;                 // Pointer returned by malloc for the main block
+    size_t capacity;
+    size_t used;
+    arena_block_t* overflow;   // Spill blocks for the current frame
+    size_t overflow_used;      // Bytes served from spill blocks this frame
+
+    // Monitoring
+    size_t peak_bytes;         // Largest total usage seen in one frame
+    unsigned long resets;
+    unsigned long heap_allocs; // System allocations made by the arena
+} arena_t;
+
+typedef struct {
+    size_t capacity;
+    size_t used;
+    size_t peak_bytes;
+    unsigned long resets;
+    unsigned long heap_allocs;
+} arena_stats_t;
+
+void arena_init(arena_t* arena, size_t initial_capacity);
+void arena_destroy(arena_t* arena);
+void* arena_alloc(arena_t* arena, size_t size);
+void arena_reset(arena_t* arena);
+arena_stats_t arena_get_stats(const arena_t* arena);
+
+#endif // ARENA_H
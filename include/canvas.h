@@ -1,16 +1,145 @@
 #ifndef CANVAS_H
 #define CANVAS_H
 
+#include <stddef.h>
+#include <stdint.h>
+#include "depth_buffer.h"  // For depth_buffer_t
+
+// Every canvas row starts on a 64-byte boundary (one cache line / one AVX-512 register)
+#define CANVAS_ALIGNMENT 64
+
+// Pixel storage. FLOAT32 accumulates without bound and clamps on output.
+// UNORM16 stores round(v * 65535) and accumulates with saturating adds, so it
+// takes half the memory and converts to 8-bit without floating point. Since
+// contributions are never negative, saturating early gives the same clamped
+// result; each contribution is rounded to 1/65535, which keeps 8-bit output
+// within one step of the float path.
+typedef enum {
+    CANVAS_FORMAT_FLOAT32 = 0,
+    CANVAS_FORMAT_UNORM16
+} canvas_format_t;
+
+#define CANVAS_UNORM16_MAX 65535
+
 typedef struct {
     int width;
     int height;
-    float** pixels;  // 2D array [height][width] of brightness values (0.0 to 1.0)
+    int stride;      // Distance between rows in pixels (>= width)
+    float* data;     // Contiguous [height][stride] brightness values (0.0 to 1.0); FLOAT32 only
+    float** pixels;  // Row pointers into data, kept so pixels[y][x] still works; FLOAT32 only
+    int owns_data;   // 0 when data is caller-owned memory (see canvas_wrap)
+    depth_buffer_t* depth;  // Optional, owned; see canvas_attach_depth
+    canvas_format_t format;
+    uint16_t* data16;       // [height][stride] fixed-point pixels; UNORM16 only
 } canvas_t;
 
+// Half-open pixel rectangle [x0, x1) x [y0, y1)
+typedef struct {
+    int x0, y0, x1, y1;
+} canvas_rect_t;
+
+// Row accessor for code that walks the framebuffer directly
+static inline float* canvas_row(const canvas_t* canvas, int y) {
+    return canvas->data + (size_t)y * canvas->stride;
+}
+
+static inline uint16_t* canvas_row16(const canvas_t* canvas, int y) {
+    return canvas->data16 + (size_t)y * canvas->stride;
+}
+
+// Fixed-point value of a float contribution: clamp to [0, 1], round(v * 65535)
+static inline uint16_t canvas_fixed16(float v) {
+    if (!(v > 0.0f)) v = 0.0f;  // Also maps NaN to 0
+    if (v > 1.0f) v = 1.0f;
+    return (uint16_t)(v * 65535.0f + 0.5f);
+}
+
 // Function declarations
 canvas_t* create_canvas(int width, int height);
+canvas_t* create_canvas_format(int width, int height, canvas_format_t format);
+canvas_t* canvas_wrap(float* data, int width, int height, int stride);
 void free_canvas(canvas_t* canvas);
 void set_pixel_f(canvas_t* canvas, float x, float y, float intensity);
 void draw_line_f(canvas_t* canvas, float x0, float y0, float x1, float y1, float thickness);
 
+// Same samples as draw_line_f, but only pixels inside clip are written (NULL = whole
+// canvas). Splitting a line across disjoint clip rectangles is bit-identical to
+// drawing it once.
+void draw_line_f_clipped(canvas_t* canvas, float x0, float y0, float x1, float y1,
+                         float thickness, const canvas_rect_t* clip);
+
+// Anti-aliased lines: Xiaolin Wu for thickness <= 1. Thicker lines take, in each
+// major-axis column, each pixel's 1-D overlap with the band's minor-axis span
+// at the column centre, scaled by the column's coverage of the segment. That
+// is an approximation: there are no end caps and no 2-D area coverage. The
+// line is clipped to the canvas (and clip) once up front; like
+// draw_line_f_clipped, tiling it across clip rectangles is bit-identical to
+// drawing it whole.
+void draw_line_aa(canvas_t* canvas, float x0, float y0, float x1, float y1,
+                  float thickness, float intensity);
+void draw_line_aa_clipped(canvas_t* canvas, float x0, float y0, float x1, float y1,
+                          float thickness, float intensity, const canvas_rect_t* clip);
+
+// Depth-tested variants: z0 and z1 are the endpoints' NDC depths, interpolated
+// linearly along the line (NDC z is affine in screen space, so this is exact).
+// Each pixel write is tested against the canvas depth buffer; without one they
+// draw exactly like the untested functions (draw_line_f_depth with intensity 1
+// matches draw_line_f_clipped). Tiling stays bit-identical as long as clip
+// rectangles are aligned to DEPTH_TILE_SIZE.
+void draw_line_f_depth(canvas_t* canvas, float x0, float y0, float z0,
+                       float x1, float y1, float z1, float thickness, float intensity,
+                       const canvas_rect_t* clip);
+void draw_line_aa_depth(canvas_t* canvas, float x0, float y0, float z0,
+                        float x1, float y1, float z1, float thickness, float intensity,
+                        const canvas_rect_t* clip);
+
+// Lines shorter than one pixel draw a single sample (a thickness-wide square
+// of bilinear splats at the first endpoint). canvas_point_from_line captures
+// that sample and returns 1 for such lines (0 < major-axis length < 1);
+// draw_points_f_depth then draws a batch of them exactly as draw_line_f_depth
+// would draw each line, in order, without the per-line setup.
+typedef struct {
+    float x, y, z;     // First endpoint and its NDC depth
+    float intensity;
+    float bias;        // The line's self-occlusion depth bias
+} canvas_point_t;
+
+int canvas_point_from_line(float x0, float y0, float z0, float x1, float y1, float z1,
+                           float thickness, float intensity, canvas_point_t* point);
+void draw_points_f_depth(canvas_t* canvas, const canvas_point_t* points, int count,
+                         float thickness, const canvas_rect_t* clip);
+
+// Give the canvas a depth buffer of the given format (replacing any existing
+// one), cleared to the far plane. Returns -1 on allocation failure.
+int canvas_attach_depth(canvas_t* canvas, depth_format_t format);
+void canvas_detach_depth(canvas_t* canvas);
+
+// Bulk operations (canvas_clear also clears the attached depth buffer).
+// Copy and blit need both canvases in the same format; canvas_copy returns -1
+// and canvas_blit does nothing otherwise. canvas_blit may copy within one
+// canvas, with the source and destination rectangles overlapping.
+void canvas_clear(canvas_t* canvas, float value);
+int canvas_copy(canvas_t* dst, const canvas_t* src);
+void canvas_blit(canvas_t* dst, const canvas_t* src,
+                 int src_x, int src_y, int width, int height,
+                 int dst_x, int dst_y);
+
+// Brightness of one pixel as a float, whatever the format
+float canvas_get_pixel(const canvas_t* canvas, int x, int y);
+
+// Convert floats to 8-bit gray: clamp to [0, 1], then round(v * 255).
+// SIMD kernels are picked at runtime and match the scalar result exactly.
+void canvas_quantize_u8(const float* src, unsigned char* dst, int count);
+
+// Convert fixed-point pixels to 8-bit gray: round(v / 257), integer only
+// (SIMD kernels match the scalar result exactly)
+void canvas_quantize16_u8(const uint16_t* src, unsigned char* dst, int count);
+
+// One canvas row as 8-bit gray, using the converter for the canvas format
+void canvas_quantize_row_u8(const canvas_t* canvas, int y, unsigned char* dst);
+
+// Output (filename is a printf-style format)
+int canvas_save_ppm(const canvas_t* canvas, const char* filename, ...);
+int canvas_save_pgm(const canvas_t* canvas, const char* filename, ...);
+
 #endif
@@ -0,0 +1,28 @@
+#ifndef CLIP_H
+#define CLIP_H
+
+#include "math3d.h"  // For vec3f_t/vec4_t/mat4_t
+#include "raster.h"  // For segment_t
+
+// Six frustum planes (left, right, bottom, top, near, far) in the space the
+// MVP maps from. Each plane is normalized so dot(plane.xyz, p) + plane.w is a
+// signed distance, positive inside.
+typedef struct {
+    vec4_t planes[6];
+} frustum_t;
+
+void frustum_from_mvp(frustum_t* frustum, const mat4_t* mvp);
+
+// Conservative sphere test: 0 only if the sphere is entirely outside one plane
+int frustum_sphere_visible(const frustum_t* frustum, vec3f_t center, float radius);
+
+// Clip a clip-space segment to the near and far planes (-w <= z <= w) before
+// the perspective divide. Returns 0 if nothing remains.
+int clip_homogeneous_near_far(vec4_t* a, vec4_t* b);
+
+// Trim a screen-space segment to a circle by analytic line-circle intersection.
+// Segments entirely inside are left untouched. Returns 0 if nothing remains,
+// 2 if an endpoint moved and 1 otherwise.
+int clip_segment_circle(segment_t* segment, float cx, float cy, float radius);
+
+#endif // CLIP_H
@@ -0,0 +1,17 @@
+#ifndef CPU_H
+#define CPU_H
+
+// Instruction-set features used to pick SIMD kernels at runtime
+#define CPU_FEATURE_SSE2   0x1u
+#define CPU_FEATURE_SSE41  0x2u
+#define CPU_FEATURE_AVX2   0x4u
+#define CPU_FEATURE_FMA    0x8u
+
+// Features supported by this CPU, restricted by the current feature mask
+unsigned int cpu_features(void);
+
+// Restrict dispatch to a subset of features (e.g. 0 forces scalar kernels).
+// Intended for tests and benchmarks; pass ~0u to restore full detection.
+void cpu_set_feature_mask(unsigned int mask);
+
+#endif // CPU_H
@@ -0,0 +1,97 @@
+#ifndef DEPTH_BUFFER_H
+#define DEPTH_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Per-pixel depth buffer for depth-tested line rasterization.
+//
+// Depths are NDC z in [-1, 1], smaller is nearer. A fragment passes when its
+// depth is <= the stored depth, and the stored depth keeps the minimum.
+//
+// Clearing is hierarchical: depth_buffer_clear only resets one flag per
+// DEPTH_TILE_SIZE tile, and a tile is filled with the far value the first time
+// a fragment lands in it. Untouched tiles cost nothing per frame.
+
+// Matches RASTER_TILE_SIZE, so tiled rasterization never shares a depth tile
+// between workers
+#define DEPTH_TILE_SIZE 64
+
+typedef enum {
+    DEPTH_FORMAT_FLOAT32 = 0,  // Full float precision
+    DEPTH_FORMAT_UNORM16       // [-1, 1] mapped to 0..65535, half the memory traffic
+} depth_format_t;
+
+typedef struct depth_buffer {
+    int width;
+    int height;
+    depth_format_t format;
+    void* data;                // [height][width] float or uint16_t
+    int tiles_x;
+    int tiles_y;
+    unsigned char* tile_ready; // Nonzero once the tile holds this frame's depths
+
+    // Fragment counts since the last clear (updated atomically, one add per line)
+    uint64_t tests;
+    uint64_t passes;
+} depth_buffer_t;
+
+typedef struct {
+    uint64_t tests;           // Fragments depth-tested
+    uint64_t passes;          // Fragments that passed and were written
+    uint64_t covered;         // Pixels nearer than the far plane
+    float pass_rate;          // passes / tests
+    float overdraw;           // passes / covered: fragments written per covered pixel
+} depth_stats_t;
+
+depth_buffer_t* depth_buffer_create(int width, int height, depth_format_t format);
+void depth_buffer_destroy(depth_buffer_t* depth);
+
+// Reset every pixel to the far plane and zero the counters (O(tiles))
+void depth_buffer_clear(depth_buffer_t* depth);
+
+// Stored depth at a pixel as NDC z (1.0 for pixels not written since the clear)
+float depth_buffer_read(const depth_buffer_t* depth, int x, int y);
+
+// Counters plus coverage; walks the touched tiles, so call once per frame at most
+void depth_buffer_stats(const depth_buffer_t* depth, depth_stats_t* stats);
+
+// Fill one tile with the far value and mark it ready (the lazy half of the clear)
+void depth_buffer_prepare_tile(depth_buffer_t* depth, int tile);
+
+static inline uint16_t depth_quantize16(float z) {
+    float v = z * 0.5f + 0.5f;
+    if (!(v > 0.0f)) v = 0.0f;
+    if (v > 1.0f) v = 1.0f;
+    return (uint16_t)(v * 65535.0f + 0.5f);
+}
+
+// Depth test one fragment at (x, y), which must be on the buffer. Passes when
+// z - bias is not behind the stored depth; on a pass the stored depth becomes
+// min(stored, z). The bias lets a line's own overlapping splats pass.
+static inline int depth_buffer_test(depth_buffer_t* depth, int x, int y, float z, float bias) {
+    // Unsigned so the divisions become shifts
+    unsigned tile = (unsigned)y / DEPTH_TILE_SIZE * (unsigned)depth->tiles_x + (unsigned)x / DEPTH_TILE_SIZE;
+    if (!depth->tile_ready[tile]) depth_buffer_prepare_tile(depth, (int)tile);
+
+    size_t i = (size_t)y * depth->width + x;
+    if (depth->format == DEPTH_FORMAT_UNORM16) {
+        uint16_t* d = depth->data;
+        if (depth_quantize16(z - bias) > d[i]) return 0;
+        uint16_t q = depth_quantize16(z);
+        if (q < d[i]) d[i] = q;
+    } else {
+        float* d = depth->data;
+        if (!(z - bias <= d[i])) return 0;  // Also rejects NaN
+        if (z < d[i]) d[i] = z;
+    }
+    return 1;
+}
+
+// Fold one line's fragment counts into the buffer (safe across threads)
+static inline void depth_buffer_count(depth_buffer_t* depth, uint64_t tests, uint64_t passes) {
+    __atomic_fetch_add(&depth->tests, tests, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&depth->passes, passes, __ATOMIC_RELAXED);
+}
+
+#endif // DEPTH_BUFFER_H
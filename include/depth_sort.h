@@ -0,0 +1,25 @@
+#ifndef DEPTH_SORT_H
+#define DEPTH_SORT_H
+
+#include <stdint.h>
+#include "arena.h"  // For arena_t
+
+// Map a float depth to an unsigned key with the same ordering
+static inline uint32_t depth_sort_key(float depth) {
+    union { float f; uint32_t u; } bits = { depth + 0.0f };  // -0 becomes +0
+    return (bits.u & 0x80000000u) ? ~bits.u : (bits.u | 0x80000000u);
+}
+
+// Below this many edges an insertion sort beats the radix histogram setup
+// (crossover measured with bench/bench_sort.c)
+#define DEPTH_SORT_RADIX_THRESHOLD 128
+
+// Back-to-front (largest depth first) order of count depths. Equal depths keep
+// their input order. The returned permutation and all scratch come from the
+// arena; NULL on allocation failure.
+int* depth_sort_back_to_front(arena_t* arena, const float* depths, int count);
+
+// Always use the LSD radix sort on (key, index) pairs, whatever the count
+int* depth_sort_radix(arena_t* arena, const float* depths, int count);
+
+#endif // DEPTH_SORT_H
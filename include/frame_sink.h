@@ -0,0 +1,59 @@
+#ifndef FRAME_SINK_H
+#define FRAME_SINK_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "canvas.h"
+
+// Frame sink: streams 8-bit gray frames to one file or pipe, or into a
+// memory-mapped ring of preallocated frames, instead of one image per frame.
+//
+// Stream sinks quantize on the calling thread (vectorized) and hand the bytes
+// to a writer thread, so I/O overlaps rendering of the next frame. A sink has
+// a single producer: submit frames from one thread.
+
+typedef enum {
+    FRAME_SINK_RAW = 0,  // Headerless frames (ffmpeg -f rawvideo -pix_fmt gray -s WxH)
+    FRAME_SINK_Y4M       // YUV4MPEG2 with Cmono frames (ffmpeg -i file.y4m)
+} frame_sink_format_t;
+
+// Frames in flight between the renderer and the writer thread
+#define FRAME_SINK_QUEUE_DEPTH 3
+
+// Header at the start of a ring file; frame data follows at header_size.
+// Frame n lives in slot n % slots; frames_written is stored after the slot
+// is complete, so a reader polling it never sees a partial newest frame.
+typedef struct {
+    char magic[8];            // "T3DRING1"
+    uint32_t width;
+    uint32_t height;
+    uint32_t slots;
+    uint32_t header_size;     // Byte offset of slot 0
+    uint64_t frames_written;
+} frame_ring_header_t;
+
+typedef struct frame_sink frame_sink_t;
+
+// Stream to a file; "-" writes to stdout
+frame_sink_t* frame_sink_open(const char* path, frame_sink_format_t format,
+                              int width, int height, int fps);
+
+// Stream to an already open FILE* (e.g. from popen); the caller closes it
+frame_sink_t* frame_sink_open_stream(FILE* fp, frame_sink_format_t format,
+                                     int width, int height, int fps);
+
+// Memory-mapped ring of `slots` preallocated frames in a file of fixed size
+frame_sink_t* frame_sink_open_ring(const char* path, int width, int height, int slots);
+
+// Queue one frame (canvas size must match). Returns -1 on a size mismatch or
+// after any earlier write error.
+int frame_sink_submit(frame_sink_t* sink, const canvas_t* canvas);
+
+// Frames accepted so far
+unsigned long frame_sink_frames(const frame_sink_t* sink);
+
+// Flush pending frames, stop the writer and release the sink.
+// Returns 0 if every frame was written.
+int frame_sink_close(frame_sink_t* sink);
+
+#endif // FRAME_SINK_H
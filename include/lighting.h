@@ -1,6 +1,48 @@
+#ifndef LIGHTING_H
+#define LIGHTING_H
+
+#include "math3d.h"  // For vec3f_t
+#include "mesh.h"    // For mesh_t/indexed_mesh_t
+
 typedef struct {
-    vec3_t direction;
+    vec3f_t direction;
     float intensity;
 } light_t;
 
+// Per-frame light state in structure-of-arrays form: directions normalized
+// once, lights below the threshold dropped, so evaluation is one dot product,
+// one max and one multiply-add per (edge, light) pair.
+typedef struct {
+    int count;          // Lights kept by the last prepare
+    int capacity;
+    float* x;           // Unit directions
+    float* y;
+    float* z;
+    float* intensity;
+    int all_positive;   // Lets evaluation stop once every edge in a block saturates
+    int culled;         // Lights dropped by the last prepare
+} light_set_t;
+
+float calculate_lambert_intensity(vec3f_t edge_dir, vec3f_t light_dir);
+
+void light_set_init(light_set_t* set);
+void light_set_destroy(light_set_t* set);
+
+// Normalize and pack lights; lights with |intensity| <= threshold are culled.
+// Returns -1 on allocation failure.
+int light_set_prepare(light_set_t* set, const light_t* lights, int num_lights, float threshold);
+
+// Clamped Lambert sum for count edge directions (need not be normalized),
+// written to out. Matches calculate_lambert_intensity summed over the lights.
+void lighting_evaluate_soa(const light_set_t* set,
+                           const float* dx, const float* dy, const float* dz, int count,
+                           float* out);
+
+// One intensity per edge of an indexed mesh; the mesh is not modified.
+// This and apply_lighting are profiled into profile_bound().
+void lighting_evaluate_indexed(const light_set_t* set, const indexed_mesh_t* mesh, float* out);
+
+// Legacy entry point: writes edges[i].intensity of an edge soup
 void apply_lighting(mesh_t* mesh, light_t lights[], int num_lights);
+
+#endif // LIGHTING_H
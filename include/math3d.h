@@ -8,6 +8,18 @@ typedef struct {
     float r, theta, phi;
 } vec3_t;
 
+// Compact Cartesian-only vector (12 bytes) for vertex arrays and hot loops.
+// Spherical coordinates are only computed through the explicit conversions below.
+typedef struct {
+    float x, y, z;
+} vec3f_t;
+
+// Padded 16-byte variant: homogeneous coordinates, or a vec3f_t with one spare lane
+typedef struct {
+    _Alignas(16) float x;
+    float y, z, w;
+} vec4_t;
+
 typedef struct {
     float m[16]; // Column-major 4x4 matrix
 } mat4_t;
@@ -17,10 +29,74 @@ vec3_t vec3_from_spherical(float r, float theta, float phi);
 void vec3_normalize_fast(vec3_t* v);
 vec3_t vec3_slerp(const vec3_t* a, const vec3_t* b, float t);
 
-// Matrix operations
+// Compact vector functions (no transcendental math)
+static inline vec3f_t vec3f_make(float x, float y, float z) {
+    return (vec3f_t){ x, y, z };
+}
+
+static inline vec3f_t vec3f_add(vec3f_t a, vec3f_t b) {
+    return (vec3f_t){ a.x + b.x, a.y + b.y, a.z + b.z };
+}
+
+static inline vec3f_t vec3f_sub(vec3f_t a, vec3f_t b) {
+    return (vec3f_t){ a.x - b.x, a.y - b.y, a.z - b.z };
+}
+
+static inline vec3f_t vec3f_scale(vec3f_t v, float s) {
+    return (vec3f_t){ v.x * s, v.y * s, v.z * s };
+}
+
+static inline float vec3f_dot(vec3f_t a, vec3f_t b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+static inline vec3f_t vec3f_cross(vec3f_t a, vec3f_t b) {
+    return (vec3f_t){ a.y * b.z - a.z * b.y,
+                      a.z * b.x - a.x * b.z,
+                      a.x * b.y - a.y * b.x };
+}
+
+static inline float vec3f_length(vec3f_t v) {
+    return sqrtf(vec3f_dot(v, v));
+}
+
+static inline vec3f_t vec3f_normalize(vec3f_t v) {
+    float len_sq = vec3f_dot(v, v);
+    if (len_sq < 1e-16f) return v;  // Leave degenerate vectors untouched
+    return vec3f_scale(v, 1.0f / sqrtf(len_sq));
+}
+
+// Explicit conversions between the compact and spherical-cached forms
+vec3f_t vec3f_from_vec3(const vec3_t* v);
+vec3_t vec3_from_vec3f(vec3f_t v);
+vec3f_t vec3f_from_spherical(float r, float theta, float phi);
+void vec3f_to_spherical(vec3f_t v, float* r, float* theta, float* phi);
+
+// Matrix builders (overwrite m)
 void mat4_identity(mat4_t* m);
 void mat4_translate(mat4_t* m, float tx, float ty, float tz);
 void mat4_scale(mat4_t* m, float sx, float sy, float sz);
-void mat4_rotate_xyz(mat4_t* m, float rx, float ry, float rz);
+void mat4_rotate_xyz(mat4_t* m, float rx, float ry, float rz);  // X(rx) * Y(ry) * Z(rz), closed form
 void mat4_frustum_asymmetric(mat4_t* m, float l, float r, float b, float t, float n, float f);
+
+// T * R * S in one pass, R as in mat4_rotate_xyz (rotation holds the Euler angles)
+void mat4_trs(mat4_t* m, vec3f_t translation, vec3f_t rotation, vec3f_t scale);
+
+// result = a * b; result may alias a or b
 void mat4_multiply(mat4_t* result, const mat4_t* a, const mat4_t* b);
+
+// results[i] = a * b[i] for count matrices (e.g. one view-projection times many worlds).
+// The AVX2 path uses fused multiply-adds, so it may differ from mat4_multiply in the last bits.
+void mat4_multiply_batch(mat4_t* results, const mat4_t* a, const mat4_t* b, int count);
+
+// In-place composition: m = m * x, i.e. x is applied to points first
+void mat4_compose(mat4_t* m, const mat4_t* x);
+void mat4_compose_translate(mat4_t* m, float tx, float ty, float tz);
+void mat4_compose_scale(mat4_t* m, float sx, float sy, float sz);
+void mat4_compose_rotate_xyz(mat4_t* m, float rx, float ry, float rz);
+
+// Inverse of an affine matrix (last row 0 0 0 1). Returns -1 if the 3x3 part is singular.
+int mat4_inverse_affine(mat4_t* result, const mat4_t* m);
+
+vec4_t mat4_mul(const mat4_t* m, vec4_t v);
+void mat4_mvp(mat4_t* result, const mat4_t* world, const mat4_t* view, const mat4_t* proj);
@@ -0,0 +1,44 @@
+#ifndef MESH_H
+#define MESH_H
+
+#include "math3d.h"  // For vec3_t/vec3f_t
+
+// Structure for representing edges between vertices
+typedef struct {
+    vec3_t v0;
+    vec3_t v1;
+    float intensity;  // Written by apply_lighting
+} edge_t;
+
+// Complete mesh structure (edge soup: every edge carries copies of its endpoints)
+typedef struct {
+    edge_t* edges;
+    int num_edges;
+} mesh_t;
+
+// Indexed mesh: one shared vertex buffer plus an edge index list.
+// Edge i connects vertices[indices[2*i]] and vertices[indices[2*i + 1]].
+typedef struct {
+    vec3f_t* vertices;
+    int num_vertices;
+    int* indices;
+    int num_edges;
+    vec3f_t bounds_center;  // Object-space bounding sphere used for culling;
+    float bounds_radius;    // negative until indexed_mesh_compute_bounds runs
+    unsigned int version;   // Bumped by indexed_mesh_touch so caches notice edits
+} indexed_mesh_t;
+
+// Indexed mesh management
+indexed_mesh_t* indexed_mesh_create(int num_vertices, int num_edges);
+void indexed_mesh_destroy(indexed_mesh_t* mesh);
+
+// Mark the mesh as edited (invalidates cached projections of it)
+void indexed_mesh_touch(indexed_mesh_t* mesh);
+
+// Recompute the bounding sphere after editing vertices (also touches the mesh)
+void indexed_mesh_compute_bounds(indexed_mesh_t* mesh);
+
+// Build an indexed mesh from an edge soup, merging bit-identical endpoints
+indexed_mesh_t* indexed_mesh_from_mesh(const mesh_t* mesh);
+
+#endif // MESH_H
@@ -0,0 +1,90 @@
+#ifndef MESH_FILE_H
+#define MESH_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "mesh.h"  // For indexed_mesh_t/mesh_t
+
+// Binary mesh files: a fixed header followed by the vertex and edge-index
+// blocks laid out exactly as indexed_mesh_t stores them (float x, y, z per
+// vertex; two int32 per edge; little-endian). mesh_file_open maps the file
+// and points the mesh straight into the mapping: nothing is copied, the
+// index block is read once to range-check it and vertex pages load on first
+// use.
+//
+// Blocks start on MESH_FILE_ALIGNMENT boundaries. Readers must reject files
+// whose version they do not know; new versions may add header fields in the
+// reserved space or grow header_size, and blocks are always found through
+// their offsets.
+
+#define MESH_FILE_VERSION   1
+#define MESH_FILE_ALIGNMENT 64
+
+typedef struct {
+    char magic[8];            // "T3DMESH\0"
+    uint32_t version;         // MESH_FILE_VERSION
+    uint32_t header_size;     // Bytes before the first block (>= sizeof this header)
+    uint32_t num_vertices;
+    uint32_t num_edges;
+    uint64_t vertex_offset;   // float[3] per vertex
+    uint64_t index_offset;    // int32[2] per edge
+    float bounds_center[3];   // Bounding sphere (radius < 0: unknown)
+    float bounds_radius;
+    uint32_t checksum;        // FNV-1a over the vertex block, then the index block
+    uint32_t reserved;        // 0
+} mesh_file_header_t;
+
+typedef enum {
+    MESH_FILE_OK = 0,
+    MESH_FILE_ERROR_IO,        // Could not open, read, write or map the file
+    MESH_FILE_ERROR_MEMORY,
+    MESH_FILE_ERROR_FORMAT,    // Not a mesh file (magic or size)
+    MESH_FILE_ERROR_VERSION,   // Unknown version or foreign byte order
+    MESH_FILE_ERROR_LAYOUT,    // Blocks misaligned, overlapping or past the end
+    MESH_FILE_ERROR_INDICES,   // An edge references a missing vertex
+    MESH_FILE_ERROR_CHECKSUM,
+    MESH_FILE_ERROR_PARSE      // Malformed OBJ input
+} mesh_file_status_t;
+
+// Flags for mesh_file_open. The header, the layout and every edge index are
+// always checked unless MESH_FILE_TRUST_INDICES opts out of the index pass.
+#define MESH_FILE_VERIFY_CHECKSUM 0x2u  // Reads the whole file
+#define MESH_FILE_TRUST_INDICES   0x4u  // Skip reading the index block; only for files you wrote
+#define MESH_FILE_VERIFY_ALL      MESH_FILE_VERIFY_CHECKSUM
+
+typedef struct {
+    // Vertices and indices point into the mapping. The mapping is private and
+    // writable: edits are copy-on-write and never reach the file. Release with
+    // mesh_file_close, not indexed_mesh_destroy.
+    indexed_mesh_t mesh;
+    const mesh_file_header_t* header;
+    void* data;               // Whole file
+    size_t size;
+    int mapped;               // 0 when the file was read into memory (no mmap)
+} mesh_file_t;
+
+// Map and validate a mesh file; NULL on failure with the reason in status
+// (which may be NULL). With MESH_FILE_TRUST_INDICES an out-of-range index in
+// the file makes rendering read outside the vertex block.
+mesh_file_t* mesh_file_open(const char* path, unsigned int verify, mesh_file_status_t* status);
+void mesh_file_close(mesh_file_t* file);
+
+// Write an indexed mesh. Indices must be in range; missing bounds are computed.
+mesh_file_status_t mesh_file_write(const char* path, const indexed_mesh_t* mesh);
+
+// Write an edge soup, welding bit-identical endpoints (indexed_mesh_from_mesh)
+mesh_file_status_t mesh_file_write_soup(const char* path, const mesh_t* mesh);
+
+// Import a Wavefront OBJ: `v` vertices plus edges from `l` polylines and `f`
+// polygon outlines (1-based or negative relative indices; texture and normal
+// references are ignored). Shared edges are stored once, in first-seen
+// order. Other statements are skipped. The mesh comes with bounds; free it
+// with indexed_mesh_destroy.
+indexed_mesh_t* mesh_file_import_obj(const char* path, mesh_file_status_t* status);
+
+// OBJ (or edge list as `l` statements) to mesh file in one call
+mesh_file_status_t mesh_file_convert_obj(const char* obj_path, const char* mesh_path);
+
+const char* mesh_file_status_string(mesh_file_status_t status);
+
+#endif // MESH_FILE_H
@@ -0,0 +1,46 @@
+#ifndef MESH_LOD_H
+#define MESH_LOD_H
+
+#include "math3d.h"  // For mat4_t
+#include "mesh.h"    // For indexed_mesh_t
+
+// Screen-space level of detail: a chain of progressively simplified edge sets
+// built by edge collapse, each tagged with its geometric error, so a renderer
+// can draw the coarsest level whose error projects below a pixel budget.
+//
+// Every level collapses a matching of the previous level's edges, shortest
+// first, merging both endpoints into their weighted centroid; collapsed and
+// duplicate edges are dropped. A level's error is the farthest any source
+// vertex has moved from its representative, an object-space bound that
+// selection scales by the world matrix and the projected distance.
+
+#define MESH_LOD_MAX_LEVELS 16
+
+typedef struct {
+    const indexed_mesh_t* mesh;  // Level 0 is the source mesh
+    float error;                 // Object-space error bound (0 for level 0)
+} mesh_lod_level_t;
+
+typedef struct {
+    mesh_lod_level_t levels[MESH_LOD_MAX_LEVELS];
+    int num_levels;
+    vec3f_t bounds_center;       // Object-space bounding sphere of every level
+    float bounds_radius;
+} mesh_lod_t;
+
+// Build up to max_levels levels (including the source, which must outlive the
+// result). Simplification stops early once a collapse pass removes less than
+// a fifth of the edges. Returns NULL on allocation failure.
+mesh_lod_t* mesh_lod_build(const indexed_mesh_t* mesh, int max_levels);
+void mesh_lod_destroy(mesh_lod_t* lod);
+
+// Pixels per object-space unit at the mesh's nearest bounding-sphere point
+// for a perspective projection onto a viewport viewport_height pixels tall;
+// 0 when the sphere reaches behind the eye (no simplification is safe).
+float mesh_lod_pixels_per_unit(const mesh_lod_t* lod, const mat4_t* world, const mat4_t* view,
+                               const mat4_t* proj, int viewport_height);
+
+// Coarsest level whose error stays within max_pixel_error at that scale
+int mesh_lod_select(const mesh_lod_t* lod, float pixels_per_unit, float max_pixel_error);
+
+#endif // MESH_LOD_H
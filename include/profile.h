@@ -0,0 +1,116 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "timebase.h"  // For time_ns_t
+
+// Per-stage profiling: timers and work counters for the wireframe pipeline
+// and lighting, kept per frame and exportable as a Chrome trace
+// (chrome://tracing or ui.perfetto.dev).
+//
+// Profiling is opt-in per renderer (renderer_t::profile) or, for the free
+// functions render_wireframe / apply_lighting / lighting_evaluate_indexed,
+// per thread (profile_bind). With no profile attached the cost is one
+// predictable branch per stage per draw call. A profile must only be fed
+// from one thread at a time.
+
+typedef enum {
+    PROFILE_PROJECT = 0,  // Bounding-sphere cull and vertex transform
+    PROFILE_CLIP,         // Near/far and viewport clipping
+    PROFILE_SORT,         // Back-to-front ordering (skipped with a depth buffer)
+    PROFILE_RASTER,       // Line drawing
+    PROFILE_LIGHTING,     // Per-edge Lambert intensities
+    PROFILE_STAGE_COUNT
+} profile_stage_t;
+
+typedef struct {
+    time_ns_t ns[PROFILE_STAGE_COUNT];
+    uint64_t cycles[PROFILE_STAGE_COUNT];  // Time-stamp counter ticks (0 where unavailable)
+    uint64_t calls[PROFILE_STAGE_COUNT];
+
+    uint64_t meshes_culled;       // Meshes / instances rejected by bounding sphere
+    uint64_t vertices_projected;
+    uint64_t edges_culled;        // Edges rejected outright by clipping
+    uint64_t edges_clipped;       // Edges trimmed at near/far or the viewport
+    uint64_t edges_drawn;
+    uint64_t pixels_touched;      // Estimate: major-axis length x line thickness
+    uint64_t edges_lit;
+    uint64_t scratch_allocs;      // Heap allocations made by the frame arena
+    uint64_t scratch_bytes;       // Peak frame-arena use (a maximum, not a sum)
+} profile_stats_t;
+
+// One timed stage call (stage < 0: a whole frame)
+typedef struct {
+    time_ns_t start;              // Relative to the profile's origin
+    time_ns_t duration;
+    int stage;
+    int frame;
+} profile_event_t;
+
+typedef struct {
+    profile_stats_t frame;        // Frame in progress
+    profile_stats_t last;         // Last completed frame
+    profile_stats_t total;        // Sum over completed frames
+    int frames;                   // Completed frames
+    int in_frame;
+    time_ns_t frame_start;
+    time_ns_t origin;
+
+    // Trace log: stage calls and frames, plus per-frame counters
+    profile_event_t* events;
+    size_t num_events;
+    size_t event_capacity;
+    size_t max_events;            // 0: counters only, no trace log
+    unsigned long dropped_events; // Events past max_events
+    profile_stats_t* history;     // Counters of each completed frame while tracing
+    int history_count;
+    int history_capacity;
+} profile_t;
+
+// Start of a timed region
+typedef struct {
+    time_ns_t ns;
+    uint64_t cycles;
+} profile_mark_t;
+
+// max_events bounds the trace log (0 keeps counters only)
+void profile_init(profile_t* profile, size_t max_events);
+void profile_destroy(profile_t* profile);
+void profile_reset(profile_t* profile);
+
+// Frame boundaries: counters accumulate in `frame` until profile_end_frame
+// moves them to `last` and `total`. begin_frame ends an open frame first.
+void profile_begin_frame(profile_t* profile);
+void profile_end_frame(profile_t* profile);
+
+// Write the trace log as Chrome trace-event JSON: one complete event per
+// stage call and per frame (with the frame's counters as arguments) and
+// counter tracks for edges, vertices and pixels. Returns 0 on success.
+int profile_write_trace(const profile_t* profile, FILE* fp);
+int profile_save_trace(const profile_t* profile, const char* path);
+
+const char* profile_stage_name(profile_stage_t stage);
+
+// Profile used by the free functions on the calling thread (NULL = off)
+void profile_bind(profile_t* profile);
+profile_t* profile_bound(void);
+
+// Instrumentation: time one stage call with
+//     profile_mark_t mark = profile_mark(profile);
+//     ...
+//     profile_stage_end(profile, PROFILE_CLIP, mark);
+profile_mark_t profile_now(void);
+void profile_record(profile_t* profile, profile_stage_t stage, profile_mark_t start);
+
+static inline profile_mark_t profile_mark(const profile_t* profile) {
+    if (!profile) return (profile_mark_t){ 0, 0 };
+    return profile_now();
+}
+
+static inline void profile_stage_end(profile_t* profile, profile_stage_t stage, profile_mark_t start) {
+    if (profile) profile_record(profile, stage, start);
+}
+
+#endif // PROFILE_H
@@ -0,0 +1,52 @@
+#ifndef PROJECTION_CACHE_H
+#define PROJECTION_CACHE_H
+
+#include "math3d.h"  // For mat4_t
+#include "mesh.h"    // For indexed_mesh_t
+#include "raster.h"  // For segment_t
+
+// Per-object projection cache.
+//
+// Holds one mesh's projected, culled and clipped screen-space edges together
+// with the key they were computed from: the mesh and its version, the exact
+// bits of the combined MVP, and the canvas size. While the key is unchanged
+// (a still object under a still camera) renderer_draw_wireframe_cached skips
+// projection and clipping and rasterizes the cached segments directly.
+// Editing the mesh requires indexed_mesh_touch.
+
+typedef struct {
+    // Key of the cached result
+    int valid;
+    const indexed_mesh_t* mesh;
+    unsigned int mesh_version;
+    mat4_t mvp;
+    int width;
+    int height;
+
+    segment_t* segments;  // Clipped edges, count entries
+    float* depths;        // Average NDC depth per segment, for the painter's sort
+    int count;
+    int capacity;
+
+    unsigned long hits;   // Lookups answered from the cache
+    unsigned long misses; // Lookups that had to re-project
+} projection_cache_t;
+
+void projection_cache_init(projection_cache_t* cache);
+void projection_cache_destroy(projection_cache_t* cache);
+
+// Drop the cached result (counters are kept)
+void projection_cache_invalidate(projection_cache_t* cache);
+
+// 1 if the cached result matches the key (counted as a hit), else 0 (a miss)
+int projection_cache_lookup(projection_cache_t* cache, const indexed_mesh_t* mesh,
+                            const mat4_t* mvp, int width, int height);
+
+// Make room for count segments; invalidates the cache. Returns -1 on failure.
+int projection_cache_reserve(projection_cache_t* cache, int count);
+
+// Record the key for the count segments just written into the cache buffers
+void projection_cache_store(projection_cache_t* cache, const indexed_mesh_t* mesh,
+                            const mat4_t* mvp, int width, int height, int count);
+
+#endif // PROJECTION_CACHE_H
@@ -0,0 +1,46 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include "canvas.h"      // For canvas_t
+#include "arena.h"       // For arena_t
+#include "threadpool.h"  // For threadpool_t
+
+// Screen tiles for the parallel rasterizer are RASTER_TILE_SIZE pixels square
+#define RASTER_TILE_SIZE 64
+
+// Line engine used for every segment
+typedef enum {
+    RASTER_LINE_SPLAT = 0,  // draw_line_f: bilinear splats along the major axis
+    RASTER_LINE_AA          // draw_line_aa: Wu / analytic coverage, clipped up front
+} raster_line_mode_t;
+
+// Screen-space line segment ready for rasterization
+typedef struct {
+    float x0, y0;
+    float x1, y1;
+    float z0, z1;  // NDC depth of each end, used only when the canvas has a depth buffer
+} segment_t;
+
+// Draw segments in order on the calling thread. With a depth buffer attached
+// to the canvas, every pixel is depth-tested and the order no longer matters
+// for occlusion.
+void raster_segments(canvas_t* canvas, const segment_t* segments, int count,
+                     float thickness, raster_line_mode_t mode);
+
+// Bin segments into screen tiles and rasterize the tiles in parallel. Each tile
+// replays its segments in list order and writes only its own pixels, so the
+// result is bit-identical to raster_segments. Bins come from the arena.
+void raster_segments_tiled(canvas_t* canvas, const segment_t* segments, int count,
+                           float thickness, raster_line_mode_t mode,
+                           threadpool_t* pool, arena_t* arena);
+
+// As above with a per-segment intensity (NULL = 1.0 for every segment)
+void raster_segments_weighted(canvas_t* canvas, const segment_t* segments,
+                              const float* intensities, int count,
+                              float thickness, raster_line_mode_t mode);
+void raster_segments_tiled_weighted(canvas_t* canvas, const segment_t* segments,
+                                    const float* intensities, int count,
+                                    float thickness, raster_line_mode_t mode,
+                                    threadpool_t* pool, arena_t* arena);
+
+#endif // RASTER_H
@@ -1,33 +1,99 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
-#include "math3d.h"  // For vec3_t/mat4_t definitions
+#include <stdbool.h>
+#include "math3d.h"  // For vec3f_t/mat4_t definitions
 #include "canvas.h"  // For canvas_t
+#include "mesh.h"    // For mesh_t/indexed_mesh_t
+#include "arena.h"   // For arena_t
+#include "raster.h"  // For segment_t/threadpool_t
+#include "projection_cache.h"  // For projection_cache_t
+#include "scene.h"     // For scene_t
+#include "profile.h"   // For profile_t
+#include "mesh_lod.h"  // For mesh_lod_t
 
-// Structure for representing edges between vertices
+// Structure for depth-sorted edges (indexes the frame's clipped segment list)
 typedef struct {
-    vec3_t v0;
-    vec3_t v1;
-} edge_t;
+    int segment;
+    float depth;
+} edge_depth_t;
 
-// Complete mesh structure
-typedef struct {
-    edge_t* edges;
-    int num_edges;
-} mesh_t;
+// Back-to-front ordering strategy
+typedef enum {
+    RENDER_SORT_RADIX = 0,  // LSD radix sort of (depth key, edge index) pairs
+    RENDER_SORT_QSORT       // qsort of edge_depth_t records (reference path)
+} render_sort_mode_t;
+
+// Rasterization strategy
+typedef enum {
+    RENDER_RASTER_DIRECT = 0,  // Draw the sorted edge list on the calling thread
+    RENDER_RASTER_TILED        // Bin edges into screen tiles, rasterize tiles in parallel
+} render_raster_mode_t;
 
-// Structure for depth-sorted edges
+// Renderer context: target canvas plus reusable per-frame scratch memory
 typedef struct {
-    vec3_t v0;
-    vec3_t v1;
-    float depth;
-} edge_depth_t;
+    canvas_t* canvas;
+    render_sort_mode_t sort_mode;
+    render_raster_mode_t raster_mode;
+    raster_line_mode_t line_mode;  // RASTER_LINE_SPLAT keeps the original look
+    float line_thickness;
+    threadpool_t* pool;   // Workers for RENDER_RASTER_TILED (see renderer_set_threads)
+    arena_t frame_arena;  // Projected vertices, depth keys, clip results
+    profile_t* profile;   // Optional stage timers and counters (NULL = off)
+    float lod_pixel_error;  // Screen-space error renderer_draw_lod accepts, in pixels
+} renderer_t;
 
 // Function declarations
-vec3_t project_vertex(vec3_t vertex, mat4_t world, mat4_t view, mat4_t proj, 
+vec3f_t project_vertex(vec3f_t vertex, mat4_t world, mat4_t view, mat4_t proj,
                       int width, int height);
 bool clip_to_circular_viewport(canvas_t* canvas, float x, float y);
-void render_wireframe(canvas_t* canvas, const mesh_t* mesh,
+
+// One-shot draw through a throwaway context (profiled into profile_bound())
+void render_wireframe(canvas_t* canvas, const indexed_mesh_t* mesh,
                      mat4_t world, mat4_t view, mat4_t proj);
 
+// Context-based rendering: per-frame scratch comes from the frame arena, which
+// grows to its high-water mark once and is then reused frame after frame.
+//
+// Depth buffer mode: when the canvas has a depth buffer (canvas_attach_depth),
+// edges are depth-tested per pixel and the back-to-front sort is skipped;
+// clear it each frame with canvas_clear or depth_buffer_clear.
+renderer_t* renderer_create(canvas_t* canvas);
+void renderer_destroy(renderer_t* renderer);
+void renderer_begin_frame(renderer_t* renderer);
+
+// Switch to tiled rasterization on num_threads threads (including the caller;
+// 0 = one per CPU). Output is bit-identical to RENDER_RASTER_DIRECT.
+int renderer_set_threads(renderer_t* renderer, int num_threads);
+void renderer_draw_wireframe(renderer_t* renderer, const indexed_mesh_t* mesh,
+                             const mat4_t* world, const mat4_t* view, const mat4_t* proj);
+
+// As renderer_draw_wireframe, reusing the cache's clipped segments while the
+// mesh, MVP and canvas size are unchanged (keep one cache per drawn object).
+// Output is bit-identical to the uncached call.
+void renderer_draw_wireframe_cached(renderer_t* renderer, const indexed_mesh_t* mesh,
+                                    projection_cache_t* cache, const mat4_t* world,
+                                    const mat4_t* view, const mat4_t* proj);
+
+// Draw count copies of one mesh, instance i with worlds[i] and brightness
+// intensities[i] (NULL = 1.0). Instances outside the frustum are culled by
+// bounding sphere; the rest are projected with one batched MVP multiply and
+// the SoA transform kernel, and all their edges go through a single shared
+// depth sort. Scratch grows with count * mesh->num_edges. Returns the number
+// of instances that survived culling.
+int renderer_draw_instances(renderer_t* renderer, const indexed_mesh_t* mesh,
+                             const mat4_t* worlds, const float* intensities, int count,
+                             const mat4_t* view, const mat4_t* proj);
+
+// Draw the coarsest level of lod whose error projects to at most
+// renderer->lod_pixel_error pixels at the mesh's nearest point. Returns the
+// level drawn.
+int renderer_draw_lod(renderer_t* renderer, const mesh_lod_t* lod, const mat4_t* world,
+                      const mat4_t* view, const mat4_t* proj);
+
+// Draw every scene node that has a mesh with its cached world matrix, each
+// through the node's own projection cache. Call scene_update first.
+void renderer_draw_scene(renderer_t* renderer, scene_t* scene,
+                         const mat4_t* view, const mat4_t* proj);
+
 #endif // RENDERER_H
@@ -0,0 +1,82 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include "math3d.h"            // For vec3f_t/mat4_t
+#include "mesh.h"              // For indexed_mesh_t
+#include "animation.h"         // For animated_object_t
+#include "anim_pool.h"         // For anim_pool_t/anim_handle_t
+#include "projection_cache.h"  // For projection_cache_t
+
+// Scene graph: nodes with a local translation / rotation (Euler, as in
+// mat4_rotate_xyz) / scale, an optional parent and a cached world matrix.
+//
+// Nodes live in one flat array and are only appended, so every parent comes
+// before its children. scene_update then recomputes world matrices in a single
+// linear pass, touching only nodes whose local transform changed and their
+// descendants. Nodes can follow an animated_object_t or an animation pool
+// entry; scene_update copies the animated pose in and marks the node dirty
+// only if the pose actually changed.
+
+typedef enum {
+    SCENE_BIND_NONE = 0,
+    SCENE_BIND_OBJECT,  // animated_object_t position / rotation / scale
+    SCENE_BIND_POOL     // anim_pool_t pose (position / rotation)
+} scene_binding_t;
+
+typedef struct {
+    vec3f_t translation;
+    vec3f_t rotation;
+    vec3f_t scale;
+    mat4_t world;            // Valid after scene_update
+    unsigned int world_version;  // Incremented whenever world is recomputed
+
+    // Optional animation source
+    scene_binding_t binding;
+    const animated_object_t* object;
+    const anim_pool_t* pool;
+    anim_handle_t handle;
+
+    // Optional drawable (see renderer_draw_scene)
+    const indexed_mesh_t* mesh;
+    projection_cache_t cache;
+} scene_node_t;
+
+// Parent links and per-node flags sit in their own compact arrays, so the
+// update pass streams a few bytes per clean node instead of whole nodes
+typedef struct {
+    scene_node_t* nodes;
+    int* parent;             // Index of each node's parent, -1 for roots
+    unsigned char* flags;    // Dirty / bound / changed bits used by scene_update
+    int count;
+    int capacity;
+} scene_t;
+
+void scene_init(scene_t* scene, int initial_capacity);
+void scene_destroy(scene_t* scene);
+
+// Append a node with an identity transform under parent (-1 for a root).
+// Returns its index, or -1 if parent is invalid or allocation fails.
+int scene_add_node(scene_t* scene, int parent);
+
+// Local transform setters; each marks the node dirty
+void scene_set_trs(scene_t* scene, int node, vec3f_t translation, vec3f_t rotation, vec3f_t scale);
+void scene_set_translation(scene_t* scene, int node, vec3f_t translation);
+void scene_set_rotation(scene_t* scene, int node, vec3f_t rotation);
+void scene_set_scale(scene_t* scene, int node, vec3f_t scale);
+
+// Drive a node's local transform from an animation (NULL / invalid unbinds)
+void scene_bind_object(scene_t* scene, int node, const animated_object_t* object);
+void scene_bind_pool(scene_t* scene, int node, const anim_pool_t* pool, anim_handle_t handle);
+
+// Attach a mesh for renderer_draw_scene (NULL detaches)
+void scene_set_mesh(scene_t* scene, int node, const indexed_mesh_t* mesh);
+
+// Pull animated poses, then recompute dirty subtrees. Returns the number of
+// world matrices recomputed.
+int scene_update(scene_t* scene);
+
+static inline const mat4_t* scene_world(const scene_t* scene, int node) {
+    return &scene->nodes[node].world;
+}
+
+#endif // SCENE_H
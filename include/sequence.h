@@ -0,0 +1,78 @@
+#ifndef SEQUENCE_H
+#define SEQUENCE_H
+
+#include "canvas.h"      // For canvas_t/canvas_format_t
+#include "renderer.h"    // For renderer_t
+#include "frame_sink.h"  // For frame_sink_t
+
+// Offline sequence rendering: frames of an animation are rendered
+// concurrently, each worker with its own canvas and renderer (frame arena),
+// and handed to the output strictly in frame order. Output is byte-identical
+// whatever the thread count, since each frame is drawn from scratch by the
+// same code on a freshly cleared canvas.
+//
+// Frames are claimed in order, so at most one frame per worker is in flight;
+// a worker that finishes early waits for its turn to emit before claiming
+// the next frame.
+
+// Draw frame `frame` (animation time `time` seconds) with renderer, whose
+// canvas has been cleared and whose frame has begun. Called concurrently from
+// several threads: the result must depend only on frame / time and on state
+// owned by `worker` (in [0, sequence_worker_count)). Shared animation state
+// must be evaluated read-only, e.g. a pure function of time.
+typedef void (*sequence_draw_fn)(void* user, renderer_t* renderer, int worker,
+                                 int frame, double time);
+
+// Ordered output: called once per frame in increasing frame order, never
+// concurrently. A nonzero return stops the sequence.
+typedef int (*sequence_output_fn)(void* user, const canvas_t* canvas, int frame);
+
+typedef struct {
+    // Frame buffers
+    int width;
+    int height;
+    canvas_format_t format;
+    float clear_value;
+    int depth;                    // Attach a depth buffer of depth_format to each canvas
+    depth_format_t depth_format;
+    raster_line_mode_t line_mode;
+    float line_thickness;
+
+    // Frames first_frame .. first_frame + num_frames - 1 at
+    // time = start_time + frame / fps
+    int first_frame;
+    int num_frames;
+    double fps;
+    double start_time;
+
+    sequence_draw_fn draw;
+    void* user;
+
+    // Destinations, in this order (either may be NULL)
+    frame_sink_t* sink;
+    sequence_output_fn output;
+    void* output_user;
+} sequence_desc_t;
+
+typedef struct {
+    int frames;            // Frames emitted
+    int workers;
+    double wall_seconds;
+    double draw_seconds;   // Summed over workers: clear + draw
+    double wait_seconds;   // Summed over workers: blocked on frame order
+} sequence_stats_t;
+
+// Defaults: float canvas cleared to 0, no depth, the renderer's line style,
+// 30 fps from time 0, no frames and no destinations
+void sequence_desc_init(sequence_desc_t* desc, int width, int height);
+
+// Workers sequence_render uses for num_threads (0 = one per CPU)
+int sequence_worker_count(int num_threads);
+
+// Render the range on num_threads threads (including the caller; 0 = one per
+// CPU; 1 renders sequentially on the calling thread). Returns 0, or -1 if
+// allocation failed or a destination reported an error; frames after the
+// failing one are skipped. stats may be NULL.
+int sequence_render(const sequence_desc_t* desc, int num_threads, sequence_stats_t* stats);
+
+#endif // SEQUENCE_H
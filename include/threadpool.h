@@ -0,0 +1,22 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+// Task callback: task_index in [0, num_tasks), worker_index in [0, threadpool_size)
+typedef void (*threadpool_task_fn)(void* ctx, int task_index, int worker_index);
+
+typedef struct threadpool threadpool_t;
+
+// num_threads counts the calling thread: 1 runs every task inline, 0 picks
+// the number of online CPUs
+threadpool_t* threadpool_create(int num_threads);
+void threadpool_destroy(threadpool_t* pool);
+int threadpool_size(const threadpool_t* pool);
+
+// Run num_tasks tasks across the pool and wait for all of them. Tasks are
+// claimed dynamically, so their completion order is unspecified.
+void threadpool_run(threadpool_t* pool, threadpool_task_fn fn, void* ctx, int num_tasks);
+
+// Number of online CPUs (at least 1)
+int threadpool_cpu_count(void);
+
+#endif // THREADPOOL_H
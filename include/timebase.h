@@ -0,0 +1,71 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <stdint.h>
+
+// Wall-clock time for animation: a monotonic nanosecond clock, injectable
+// time sources, and a fixed-timestep tick scheduler.
+//
+// Times are int64 nanoseconds internally (exact, ~292 years of range) and
+// converted to double seconds at the edges, so nothing drifts as uptime grows.
+
+typedef int64_t time_ns_t;
+
+#define TIME_NS_PER_SECOND INT64_C(1000000000)
+
+// Monotonic clock in nanoseconds from an arbitrary origin
+time_ns_t time_monotonic_ns(void);
+
+static inline double time_ns_to_seconds(time_ns_t ns) {
+    return (double)ns / (double)TIME_NS_PER_SECOND;
+}
+
+static inline time_ns_t time_seconds_to_ns(double seconds) {
+    return (time_ns_t)(seconds * (double)TIME_NS_PER_SECOND + (seconds < 0 ? -0.5 : 0.5));
+}
+
+// Time source: either the monotonic clock, or manual time that only moves when
+// told to. Manual sources make offline renders and tests replay identically.
+typedef struct {
+    int manual;
+    time_ns_t origin;  // Monotonic reading that maps to time 0
+    time_ns_t now;     // Current manual time
+} time_source_t;
+
+void time_source_init_monotonic(time_source_t* source);
+void time_source_init_manual(time_source_t* source, time_ns_t start);
+
+// Nanoseconds since the source's origin
+time_ns_t time_source_now(const time_source_t* source);
+double time_source_seconds(const time_source_t* source);
+
+// Manual sources only; ignored for monotonic sources
+void time_source_set(time_source_t* source, time_ns_t now);
+void time_source_advance(time_source_t* source, time_ns_t delta);
+
+// Fixed-timestep scheduler. Each frame, tick_scheduler_advance reports how
+// many fixed steps have come due; the caller simulates that many ticks and
+// renders with tick_scheduler_alpha to interpolate between the last two.
+// Tick times are step * tick index, never a running sum, so they cannot drift.
+typedef struct {
+    const time_source_t* source;
+    time_ns_t step;         // Fixed step length
+    time_ns_t last;         // Source time at the previous advance
+    time_ns_t accumulator;  // Unsimulated time, < step after each advance
+    int64_t tick;           // Ticks simulated so far
+    int max_steps;          // Cap per advance; excess time is dropped
+} tick_scheduler_t;
+
+void tick_scheduler_init(tick_scheduler_t* scheduler, const time_source_t* source,
+                         time_ns_t step, int max_steps);
+
+// Number of ticks to simulate now (also advances the tick counter)
+int tick_scheduler_advance(tick_scheduler_t* scheduler);
+
+// Simulation time of a tick, in seconds
+double tick_scheduler_tick_time(const tick_scheduler_t* scheduler, int64_t tick);
+
+// Fraction of a step elapsed since the latest tick, in [0, 1)
+float tick_scheduler_alpha(const tick_scheduler_t* scheduler);
+
+#endif // TIMEBASE_H
@@ -0,0 +1,25 @@
+#ifndef TINY3D_H
+#define TINY3D_H
+
+// Umbrella header for the whole library
+#include "math3d.h"
+#include "canvas.h"
+#include "depth_buffer.h"
+#include "mesh.h"
+#include "mesh_file.h"
+#include "mesh_lod.h"
+#include "arena.h"
+#include "transform.h"
+#include "clip.h"
+#include "projection_cache.h"
+#include "scene.h"
+#include "renderer.h"
+#include "lighting.h"
+#include "animation.h"
+#include "anim_pool.h"
+#include "timebase.h"
+#include "profile.h"
+#include "frame_sink.h"
+#include "sequence.h"
+
+#endif // TINY3D_H
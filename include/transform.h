@@ -0,0 +1,56 @@
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include "math3d.h"  // For vec3f_t/mat4_t
+
+// Batch vertex transform: object space -> screen space through one combined MVP.
+//
+// The scalar kernel is the reference. SIMD kernels evaluate the same formula
+// but may fuse multiply-adds, so results can differ in the last few bits.
+// For vertices in front of the near plane (clip w >= near) the difference from
+// the scalar kernel stays within the tolerances below, checked by test_transform.
+#define TRANSFORM_TOLERANCE_PX    1e-3f  // Screen x/y, canvases up to 8192 pixels
+#define TRANSFORM_TOLERANCE_DEPTH 1e-5f  // NDC depth
+
+typedef enum {
+    TRANSFORM_KERNEL_AUTO = 0,  // Best kernel supported by the running CPU
+    TRANSFORM_KERNEL_SCALAR,
+    TRANSFORM_KERNEL_SSE,       // 4 vertices per iteration
+    TRANSFORM_KERNEL_AVX2       // 8 vertices per iteration (with FMA)
+} transform_kernel_t;
+
+// Structure-of-arrays transform. Writes screen x/y (Y flipped) and NDC depth.
+void transform_vertices_soa(const mat4_t* mvp,
+                            const float* x, const float* y, const float* z, int count,
+                            int width, int height,
+                            float* out_x, float* out_y, float* out_depth);
+
+// Same as above with an explicit kernel; unsupported kernels fall back to AUTO
+void transform_vertices_soa_kernel(transform_kernel_t kernel, const mat4_t* mvp,
+                                   const float* x, const float* y, const float* z, int count,
+                                   int width, int height,
+                                   float* out_x, float* out_y, float* out_depth);
+
+// SoA transform that also stores clip-space w (out_w may be NULL). Callers
+// that project one mesh many times (instancing) deinterleave it once and use this.
+void transform_vertices_soa_clip(const mat4_t* mvp,
+                                 const float* x, const float* y, const float* z, int count,
+                                 int width, int height,
+                                 float* out_x, float* out_y, float* out_depth, float* out_w);
+
+// Array-of-structures convenience: deinterleaves in small stack blocks
+void transform_vertices(const mat4_t* mvp, const vec3f_t* vertices, int count,
+                        int width, int height,
+                        float* out_x, float* out_y, float* out_depth);
+
+// As transform_vertices, also storing clip-space w (out_w may be NULL) so
+// callers can classify vertices against the near/far planes
+void transform_vertices_clip(const mat4_t* mvp, const vec3f_t* vertices, int count,
+                             int width, int height,
+                             float* out_x, float* out_y, float* out_depth, float* out_w);
+
+// Kernel that AUTO resolves to on this CPU, and a printable name for it
+transform_kernel_t transform_active_kernel(void);
+const char* transform_kernel_name(transform_kernel_t kernel);
+
+#endif // TRANSFORM_H
@@ -0,0 +1,263 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "anim_pool.h"
+#include "cpu.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define ANIM_POOL_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#define ANIM_POOL_ARRAYS 14  // 12 control point coordinates + duration, loop (floats)
+
+// anim_pool_update writes poses as a flat float array
+_Static_assert(sizeof(anim_pose_t) == 6 * sizeof(float), "anim_pose_t must be packed");
+
+// Point every SoA array into a block sized for `capacity` objects
+static void bind_arrays(anim_pool_t* pool, float* block, int capacity) {
+    size_t tracks = (size_t)capacity * 2;
+    for (int k = 0; k < 12; k++) pool->ctrl[k] = block + k * tracks;
+    pool->duration = block + 12 * tracks;
+    pool->loop = block + 13 * tracks;
+    pool->block = block;
+}
+
+static int grow(anim_pool_t* pool) {
+    int capacity = pool->capacity ? pool->capacity * 2 : 64;
+    size_t tracks = (size_t)capacity * 2;
+    float* block = malloc(sizeof(float) * ANIM_POOL_ARRAYS * tracks);
+    double* start_time = malloc(sizeof(double) * tracks);
+    anim_pose_t* poses = malloc(sizeof(anim_pose_t) * capacity);
+    int* slot_to_dense = malloc(sizeof(int) * capacity);
+    uint32_t* generations = malloc(sizeof(uint32_t) * capacity);
+    int* dense_to_slot = malloc(sizeof(int) * capacity);
+    if (!block || !start_time || !poses || !slot_to_dense || !generations || !dense_to_slot) {
+        free(block); free(start_time); free(poses); free(slot_to_dense); free(generations); free(dense_to_slot);
+        return -1;
+    }
+
+    // Copy the live prefix of every array into its new position
+    size_t live = (size_t)pool->count * 2;
+    float* old_arrays[ANIM_POOL_ARRAYS];
+    for (int k = 0; k < 12; k++) old_arrays[k] = pool->ctrl[k];
+    old_arrays[12] = pool->duration;
+    old_arrays[13] = pool->loop;
+    for (int k = 0; k < ANIM_POOL_ARRAYS; k++) {
+        if (live) memcpy(block + k * tracks, old_arrays[k], sizeof(float) * live);
+    }
+    if (live) memcpy(start_time, pool->start_time, sizeof(double) * live);
+    if (pool->capacity) {
+        memcpy(poses, pool->poses, sizeof(anim_pose_t) * pool->count);
+        memcpy(slot_to_dense, pool->slot_to_dense, sizeof(int) * pool->capacity);
+        memcpy(generations, pool->generations, sizeof(uint32_t) * pool->capacity);
+        memcpy(dense_to_slot, pool->dense_to_slot, sizeof(int) * pool->count);
+    }
+
+    // New slots join the free list in ascending order
+    for (int s = capacity - 1; s >= pool->capacity; s--) {
+        slot_to_dense[s] = -2 - pool->free_head;
+        generations[s] = 0;
+        pool->free_head = s;
+    }
+
+    free(pool->block);
+    free(pool->start_time);
+    free(pool->poses);
+    free(pool->slot_to_dense);
+    free(pool->generations);
+    free(pool->dense_to_slot);
+    bind_arrays(pool, block, capacity);
+    pool->start_time = start_time;
+    pool->poses = poses;
+    pool->slot_to_dense = slot_to_dense;
+    pool->generations = generations;
+    pool->dense_to_slot = dense_to_slot;
+    pool->capacity = capacity;
+    return 0;
+}
+
+void anim_pool_init(anim_pool_t* pool, int initial_capacity) {
+    memset(pool, 0, sizeof(anim_pool_t));
+    pool->free_head = -1;
+    while (pool->capacity < initial_capacity) {
+        if (grow(pool) != 0) break;
+    }
+}
+
+void anim_pool_destroy(anim_pool_t* pool) {
+    free(pool->block);
+    free(pool->start_time);
+    free(pool->poses);
+    free(pool->slot_to_dense);
+    free(pool->generations);
+    free(pool->dense_to_slot);
+    memset(pool, 0, sizeof(anim_pool_t));
+    pool->free_head = -1;
+}
+
+static void store_track(anim_pool_t* pool, int track, const bezier_animation_t* anim) {
+    static const bezier_animation_t still = { .duration = 1.0f };
+    if (!anim) anim = &still;
+    const vec3f_t* p[4] = { &anim->p0, &anim->p1, &anim->p2, &anim->p3 };
+    for (int i = 0; i < 4; i++) {
+        pool->ctrl[3*i][track] = p[i]->x;
+        pool->ctrl[3*i + 1][track] = p[i]->y;
+        pool->ctrl[3*i + 2][track] = p[i]->z;
+    }
+    pool->duration[track] = fmaxf(anim->duration, ANIM_POOL_MIN_DURATION);
+    pool->start_time[track] = anim->start_time;
+    pool->loop[track] = anim->loop ? 1.0f : 0.0f;
+}
+
+anim_handle_t anim_pool_add(anim_pool_t* pool, const bezier_animation_t* position,
+                            const bezier_animation_t* rotation) {
+    anim_handle_t handle = { UINT32_MAX, 0 };
+    if (pool->free_head < 0 && grow(pool) != 0) return handle;
+
+    int slot = pool->free_head;
+    pool->free_head = -2 - pool->slot_to_dense[slot];
+    int dense = pool->count++;
+    pool->slot_to_dense[slot] = dense;
+    pool->dense_to_slot[dense] = slot;
+
+    store_track(pool, 2*dense, position);
+    store_track(pool, 2*dense + 1, rotation);
+    pool->poses[dense] = (anim_pose_t){ position ? position->p0 : vec3f_make(0, 0, 0),
+                                        vec3f_make(0, 0, 0) };
+
+    handle.slot = (uint32_t)slot;
+    handle.generation = pool->generations[slot];
+    return handle;
+}
+
+int anim_pool_valid(const anim_pool_t* pool, anim_handle_t handle) {
+    return handle.slot < (uint32_t)pool->capacity &&
+           pool->generations[handle.slot] == handle.generation &&
+           pool->slot_to_dense[handle.slot] >= 0;
+}
+
+int anim_pool_index(const anim_pool_t* pool, anim_handle_t handle) {
+    return anim_pool_valid(pool, handle) ? pool->slot_to_dense[handle.slot] : -1;
+}
+
+int anim_pool_remove(anim_pool_t* pool, anim_handle_t handle) {
+    if (!anim_pool_valid(pool, handle)) return -1;
+    int dense = pool->slot_to_dense[handle.slot];
+    int last = --pool->count;
+
+    // Move the last object into the hole to keep the arrays dense
+    if (dense != last) {
+        for (int t = 0; t < 2; t++) {
+            for (int k = 0; k < 12; k++) pool->ctrl[k][2*dense + t] = pool->ctrl[k][2*last + t];
+            pool->duration[2*dense + t] = pool->duration[2*last + t];
+            pool->start_time[2*dense + t] = pool->start_time[2*last + t];
+            pool->loop[2*dense + t] = pool->loop[2*last + t];
+        }
+        pool->poses[dense] = pool->poses[last];
+        int moved_slot = pool->dense_to_slot[last];
+        pool->dense_to_slot[dense] = moved_slot;
+        pool->slot_to_dense[moved_slot] = dense;
+    }
+
+    // Retire the handle and recycle the slot
+    pool->generations[handle.slot]++;
+    pool->slot_to_dense[handle.slot] = -2 - pool->free_head;
+    pool->free_head = (int)handle.slot;
+    return 0;
+}
+
+void anim_pool_sync(anim_pool_t* pool, double sync_time) {
+    for (int i = 0; i < pool->count * 2; i++) pool->start_time[i] = sync_time;
+}
+
+// Scalar kernel: same math as animation_get_position without the per-track branches.
+// Progress is computed in double (as there) and only the curve runs in float.
+static void update_scalar(anim_pool_t* pool, int begin, int end, double time) {
+    float* out = (float*)pool->poses;
+    for (int i = begin; i < end; i++) {
+        double progress = (time - pool->start_time[i]) / pool->duration[i];
+        float wrapped = (float)(progress - floor(progress));
+        float clamped = (float)fmin(fmax(progress, 0.0), 1.0);
+        float t = pool->loop[i] != 0.0f ? wrapped : clamped;
+
+        float m = 1.0f - t;
+        float a = m * m * m;
+        float b = 3.0f * m * m * t;
+        float c = 3.0f * m * t * t;
+        float d = t * t * t;
+        for (int k = 0; k < 3; k++) {
+            out[3*i + k] = a * pool->ctrl[k][i] + b * pool->ctrl[3 + k][i] +
+                           c * pool->ctrl[6 + k][i] + d * pool->ctrl[9 + k][i];
+        }
+    }
+}
+
+#ifdef ANIM_POOL_HAVE_X86
+// AVX2 kernel: 8 tracks per iteration, blends instead of branches
+__attribute__((target("avx2,fma")))
+static int update_avx2(anim_pool_t* pool, int count, double time) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 three = _mm256_set1_ps(3.0f);
+    const __m256d zero_d = _mm256_setzero_pd();
+    const __m256d one_d = _mm256_set1_pd(1.0);
+    const __m256d now = _mm256_set1_pd(time);
+    float* out = (float*)pool->poses;
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // Progress in double, four tracks per half
+        __m128 wrapped_half[2], clamped_half[2];
+        for (int h = 0; h < 2; h++) {
+            __m256d start = _mm256_loadu_pd(pool->start_time + i + 4*h);
+            __m256d duration = _mm256_cvtps_pd(_mm_loadu_ps(pool->duration + i + 4*h));
+            __m256d progress = _mm256_div_pd(_mm256_sub_pd(now, start), duration);
+            wrapped_half[h] = _mm256_cvtpd_ps(_mm256_sub_pd(progress, _mm256_floor_pd(progress)));
+            clamped_half[h] = _mm256_cvtpd_ps(_mm256_min_pd(_mm256_max_pd(progress, zero_d), one_d));
+        }
+        __m256 wrapped = _mm256_set_m128(wrapped_half[1], wrapped_half[0]);
+        __m256 clamped = _mm256_set_m128(clamped_half[1], clamped_half[0]);
+        __m256 looping = _mm256_cmp_ps(_mm256_loadu_ps(pool->loop + i), zero, _CMP_NEQ_OQ);
+        __m256 t = _mm256_blendv_ps(clamped, wrapped, looping);
+
+        __m256 m = _mm256_sub_ps(one, t);
+        __m256 mt3 = _mm256_mul_ps(three, _mm256_mul_ps(m, t));
+        __m256 a = _mm256_mul_ps(_mm256_mul_ps(m, m), m);
+        __m256 b = _mm256_mul_ps(mt3, m);
+        __m256 c = _mm256_mul_ps(mt3, t);
+        __m256 d = _mm256_mul_ps(_mm256_mul_ps(t, t), t);
+
+        float lanes[3][8];
+        for (int k = 0; k < 3; k++) {
+            __m256 v = _mm256_mul_ps(a, _mm256_loadu_ps(pool->ctrl[k] + i));
+            v = _mm256_fmadd_ps(b, _mm256_loadu_ps(pool->ctrl[3 + k] + i), v);
+            v = _mm256_fmadd_ps(c, _mm256_loadu_ps(pool->ctrl[6 + k] + i), v);
+            v = _mm256_fmadd_ps(d, _mm256_loadu_ps(pool->ctrl[9 + k] + i), v);
+            _mm256_storeu_ps(lanes[k], v);
+        }
+
+        // Interleave into the packed x, y, z output
+        for (int j = 0; j < 8; j++) {
+            out[3*(i + j)] = lanes[0][j];
+            out[3*(i + j) + 1] = lanes[1][j];
+            out[3*(i + j) + 2] = lanes[2][j];
+        }
+    }
+    return i;
+}
+#endif
+
+void anim_pool_update(anim_pool_t* pool, double current_time) {
+    // Tracks 2i and 2i+1 write poses[i].position and poses[i].rotation,
+    // so the pose array is exactly the track outputs back to back
+    int tracks = pool->count * 2;
+    int done = 0;
+#ifdef ANIM_POOL_HAVE_X86
+    unsigned int features = cpu_features();
+    if ((features & CPU_FEATURE_AVX2) && (features & CPU_FEATURE_FMA)) {
+        done = update_avx2(pool, tracks, current_time);
+    }
+#endif
+    update_scalar(pool, done, tracks, current_time);
+}
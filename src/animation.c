@@ -1,10 +1,11 @@
 #include "animation.h"
 #include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
 #include <math.h>
-#include <time.h>
 
 // Core cubic Bézier implementation
-vec3_t vec3_bezier(const vec3_t* p0, const vec3_t* p1, const vec3_t* p2, const vec3_t* p3, float t) {
+vec3f_t vec3_bezier(const vec3f_t* p0, const vec3f_t* p1, const vec3f_t* p2, const vec3f_t* p3, float t) {
     // Clamp t to [0, 1]
     if (t < 0.0f) t = 0.0f;
     if (t > 1.0f) t = 1.0f;
@@ -15,7 +16,7 @@ vec3_t vec3_bezier(const vec3_t* p0, const vec3_t* p1, const vec3_t* p2, const v
     float c = 3.0f * m * t * t;
     float d = t * t * t;
     
-    vec3_t result;
+    vec3f_t result;
     result.x = a * p0->x + b * p1->x + c * p2->x + d * p3->x;
     result.y = a * p0->y + b * p1->y + c * p2->y + d * p3->y;
     result.z = a * p0->z + b * p1->z + c * p2->z + d * p3->z;
@@ -43,8 +44,8 @@ float bezier_ease_out(float t) {
 }
 
 // Animation creation and management
-bezier_animation_t* animation_create(const vec3_t* p0, const vec3_t* p1, 
-                                   const vec3_t* p2, const vec3_t* p3, 
+bezier_animation_t* animation_create(const vec3f_t* p0, const vec3f_t* p1, 
+                                   const vec3f_t* p2, const vec3f_t* p3, 
                                    float duration, int loop) {
     bezier_animation_t* anim = malloc(sizeof(bezier_animation_t));
     if (!anim) return NULL;
@@ -54,55 +55,201 @@ bezier_animation_t* animation_create(const vec3_t* p0, const vec3_t* p1,
     anim->p2 = *p2;
     anim->p3 = *p3;
     anim->duration = duration;
-    anim->start_time = get_time();
+    anim->start_time = get_time_seconds();
     anim->loop = loop;
+    anim->sample_mode = BEZIER_SAMPLE_EXACT;
+    anim->max_error = BEZIER_TABLE_DEFAULT_ERROR;
+    anim->table = NULL;
     
     return anim;
 }
 
 void animation_destroy(bezier_animation_t* anim) {
     if (anim) {
+        animation_invalidate(anim);
         free(anim);
     }
 }
 
-vec3_t animation_get_position(bezier_animation_t* anim, float current_time) {
-    if (!anim) {
-        vec3_t zero = {0, 0, 0};
-        return zero;
+// Lookup tables
+_Static_assert(offsetof(bezier_animation_t, p3) == offsetof(bezier_animation_t, p0) + 3 * sizeof(vec3f_t),
+               "control points must be adjacent");
+
+static float table_error_bound(const bezier_animation_t* anim) {
+    return anim->max_error > 0.0f ? anim->max_error : BEZIER_TABLE_DEFAULT_ERROR;
+}
+
+static int table_is_current(const bezier_animation_t* anim) {
+    const bezier_table_t* table = anim->table;
+    if (!table || table->max_error != table_error_bound(anim)) return 0;
+    // p0..p3 are adjacent in the struct, so one bitwise compare covers all four
+    return memcmp(table->key, &anim->p0, sizeof(table->key)) == 0;
+}
+
+// Chords of a curve sampled every h deviate from it by at most h^2/8 * max|B''|,
+// and |B''| <= 6 * max(|p0 - 2p1 + p2|, |p1 - 2p2 + p3|) for a cubic
+static int table_segments(const bezier_animation_t* anim, float max_error) {
+    vec3f_t d0 = vec3f_add(vec3f_sub(anim->p0, vec3f_scale(anim->p1, 2.0f)), anim->p2);
+    vec3f_t d1 = vec3f_add(vec3f_sub(anim->p1, vec3f_scale(anim->p2, 2.0f)), anim->p3);
+    float curvature = 6.0f * fmaxf(vec3f_length(d0), vec3f_length(d1));
+    int segments = (int)ceilf(sqrtf(curvature / (8.0f * max_error)));
+    if (segments < 1) segments = 1;
+    if (segments > BEZIER_TABLE_MAX_SEGMENTS) segments = BEZIER_TABLE_MAX_SEGMENTS;
+    return segments;
+}
+
+int animation_bake(bezier_animation_t* anim) {
+    if (!anim) return -1;
+    if (table_is_current(anim)) return 0;
+    animation_invalidate(anim);
+
+    float max_error = table_error_bound(anim);
+    int n = table_segments(anim, max_error);
+    bezier_table_t* table = malloc(sizeof(bezier_table_t) + sizeof(vec3f_t) * (n + 1) +
+                                   sizeof(float) * (n + 1) + sizeof(int) * (n + 1));
+    if (!table) return -1;
+    table->points = (vec3f_t*)(table + 1);
+    table->arc = (float*)(table->points + n + 1);
+    table->arc_segment = (int*)(table->arc + n + 1);
+    table->key[0] = anim->p0;
+    table->key[1] = anim->p1;
+    table->key[2] = anim->p2;
+    table->key[3] = anim->p3;
+    table->max_error = max_error;
+    table->segments = n;
+
+    // Forward differencing of B(t) = a t^3 + b t^2 + c t + d, in double so
+    // the accumulated error stays far below the requested bound
+    const float* p[4] = { &anim->p0.x, &anim->p1.x, &anim->p2.x, &anim->p3.x };
+    double h = 1.0 / n;
+    for (int k = 0; k < 3; k++) {
+        double a = -p[0][k] + 3.0 * p[1][k] - 3.0 * p[2][k] + p[3][k];
+        double b = 3.0 * p[0][k] - 6.0 * p[1][k] + 3.0 * p[2][k];
+        double c = -3.0 * p[0][k] + 3.0 * p[1][k];
+        double f = p[0][k];
+        double df = a * h * h * h + b * h * h + c * h;
+        double ddf = 6.0 * a * h * h * h + 2.0 * b * h * h;
+        double dddf = 6.0 * a * h * h * h;
+        for (int i = 0; i <= n; i++) {
+            (&table->points[i].x)[k] = (float)f;
+            f += df;
+            df += ddf;
+            ddf += dddf;
+        }
     }
-    
-    float elapsed = current_time - anim->start_time;
-    float t = elapsed / anim->duration;
-    
+    table->points[n] = anim->p3;  // Exact endpoint
+
+    // Cumulative arc length of the polyline
+    double length = 0.0;
+    table->arc[0] = 0.0f;
+    for (int i = 1; i <= n; i++) {
+        length += vec3f_length(vec3f_sub(table->points[i], table->points[i - 1]));
+        table->arc[i] = (float)length;
+    }
+    table->length = (float)length;
+
+    // Bucket k starts in the segment containing arc length k * length / n
+    int segment = 0;
+    for (int k = 0; k <= n; k++) {
+        float s = table->length * k / n;
+        while (segment < n - 1 && table->arc[segment + 1] <= s) segment++;
+        table->arc_segment[k] = segment;
+    }
+
+    anim->table = table;
+    return 0;
+}
+
+void animation_invalidate(bezier_animation_t* anim) {
+    if (anim && anim->table) {
+        free(anim->table);
+        anim->table = NULL;
+    }
+}
+
+void animation_set_control_points(bezier_animation_t* anim, const vec3f_t* p0, const vec3f_t* p1,
+                                  const vec3f_t* p2, const vec3f_t* p3) {
+    if (!anim) return;
+    anim->p0 = *p0;
+    anim->p1 = *p1;
+    anim->p2 = *p2;
+    anim->p3 = *p3;
+    animation_invalidate(anim);
+}
+
+void animation_set_sample_mode(bezier_animation_t* anim, bezier_sample_mode_t mode, float max_error) {
+    if (!anim) return;
+    anim->sample_mode = mode;
+    anim->max_error = max_error;  // A changed bound is picked up by the staleness check
+}
+
+float animation_arc_length(bezier_animation_t* anim) {
+    if (animation_bake(anim) != 0) return 0.0f;
+    return anim->table->length;
+}
+
+// Interpolate within segment i of the polyline
+static vec3f_t table_lerp(const bezier_table_t* table, int i, float frac) {
+    vec3f_t a = table->points[i], b = table->points[i + 1];
+    return vec3f_add(a, vec3f_scale(vec3f_sub(b, a), frac));
+}
+
+vec3f_t animation_sample(bezier_animation_t* anim, float t) {
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+    if (anim->sample_mode == BEZIER_SAMPLE_EXACT || animation_bake(anim) != 0) {
+        return vec3_bezier(&anim->p0, &anim->p1, &anim->p2, &anim->p3, t);
+    }
+
+    const bezier_table_t* table = anim->table;
+    int n = table->segments;
+    if (anim->sample_mode == BEZIER_SAMPLE_TABLE) {
+        float x = t * n;
+        int i = (int)x;
+        if (i > n - 1) i = n - 1;
+        return table_lerp(table, i, x - i);
+    }
+
+    // Uniform speed: start from the bucket's segment and walk forward; buckets
+    // and segments are equally many, so the walk is short unless speed varies wildly
+    float s = t * table->length;
+    int bucket = (int)(t * n);
+    if (bucket > n) bucket = n;
+    int i = table->arc_segment[bucket];
+    while (i < n - 1 && table->arc[i + 1] < s) i++;
+    float span = table->arc[i + 1] - table->arc[i];
+    float frac = span > 0.0f ? (s - table->arc[i]) / span : 0.0f;
+    return table_lerp(table, i, fminf(fmaxf(frac, 0.0f), 1.0f));
+}
+
+// Normalized progress; the division and wrap run in double so long-running
+// clocks do not lose precision before the result is narrowed
+static float animation_progress(const bezier_animation_t* anim, double current_time) {
+    double t = (current_time - anim->start_time) / anim->duration;
+
     if (anim->loop) {
-        // For looping, use fmod to wrap around
-        t = fmodf(t, 1.0f);
-        if (t < 0) t += 1.0f;
+        // For looping, wrap into [0, 1)
+        t -= floor(t);
     } else {
         // Clamp to [0, 1] for one-shot animations
-        if (t < 0.0f) t = 0.0f;
-        if (t > 1.0f) t = 1.0f;
+        if (t < 0.0) t = 0.0;
+        if (t > 1.0) t = 1.0;
     }
-    
-    return vec3_bezier(&anim->p0, &anim->p1, &anim->p2, &anim->p3, t);
+    return (float)t;
 }
 
-float animation_get_progress(bezier_animation_t* anim, float current_time) {
-    if (!anim) return 0.0f;
-    
-    float elapsed = current_time - anim->start_time;
-    float t = elapsed / anim->duration;
-    
-    if (anim->loop) {
-        t = fmodf(t, 1.0f);
-        if (t < 0) t += 1.0f;
-    } else {
-        if (t < 0.0f) t = 0.0f;
-        if (t > 1.0f) t = 1.0f;
+vec3f_t animation_get_position(bezier_animation_t* anim, double current_time) {
+    if (!anim) {
+        vec3f_t zero = {0, 0, 0};
+        return zero;
     }
-    
-    return t;
+
+    return animation_sample(anim, animation_progress(anim, current_time));
+}
+
+float animation_get_progress(bezier_animation_t* anim, double current_time) {
+    if (!anim) return 0.0f;
+    return animation_progress(anim, current_time);
 }
 
 // Animated object management
@@ -111,12 +258,12 @@ animated_object_t* animated_object_create(void) {
     if (!obj) return NULL;
     
     // Initialize with default values
-    obj->position = (vec3_t){0, 0, 0};
-    obj->rotation = (vec3_t){0, 0, 0};
-    obj->scale = (vec3_t){1, 1, 1};
+    obj->position = (vec3f_t){0, 0, 0};
+    obj->rotation = (vec3f_t){0, 0, 0};
+    obj->scale = (vec3f_t){1, 1, 1};
     obj->pos_anim = NULL;
     obj->rot_anim = NULL;
-    obj->current_time = get_time();
+    obj->current_time = get_time_seconds();
     
     return obj;
 }
@@ -159,12 +306,36 @@ void animated_object_set_rotation_animation(animated_object_t* obj, bezier_anima
     }
 }
 
+void animated_object_set_time(animated_object_t* obj, double current_time) {
+    if (!obj) return;
+    obj->current_time = current_time;
+    animated_object_update(obj, 0.0f);
+}
+
 // Timing utilities
+static time_source_t default_source;
+static int default_source_ready = 0;
+static const time_source_t* active_source = NULL;
+
+void animation_set_time_source(const time_source_t* source) {
+    active_source = source;
+}
+
+double get_time_seconds(void) {
+    if (active_source) return time_source_seconds(active_source);
+    if (!default_source_ready) {
+        // Origin is the first query, so the float get_time stays small
+        time_source_init_monotonic(&default_source);
+        default_source_ready = 1;
+    }
+    return time_source_seconds(&default_source);
+}
+
 float get_time(void) {
-    return (float)clock() / CLOCKS_PER_SEC;
+    return (float)get_time_seconds();
 }
 
-void sync_animations(animated_object_t** objects, int count, float sync_time) {
+void sync_animations(animated_object_t** objects, int count, double sync_time) {
     for (int i = 0; i < count; i++) {
         if (objects[i]) {
             objects[i]->current_time = sync_time;
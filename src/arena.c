@@ -0,0 +1,109 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "arena.h"
+
+static size_t align_up(size_t value) {
+    return (value + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+static unsigned char* align_ptr(void* ptr) {
+    return (unsigned char*)align_up((size_t)(uintptr_t)ptr);
+}
+
+// (Re)allocate the main block; over-allocate so the base can be aligned
+static void arena_alloc_main(arena_t* arena, size_t capacity) {
+    free(arena->raw);
+    arena->raw = NULL;
+    arena->base = NULL;
+    arena->capacity = 0;
+    if (capacity == 0) return;
+
+    capacity = align_up(capacity);
+    arena->raw = malloc(capacity + ARENA_ALIGNMENT);
+    if (!arena->raw) return;
+    arena->heap_allocs++;
+    arena->base = align_ptr(arena->raw);
+    arena->capacity = capacity;
+}
+
+static void arena_free_overflow(arena_t* arena) {
+    arena_block_t* block = arena->overflow;
+    while (block) {
+        arena_block_t* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->overflow = NULL;
+    arena->overflow_used = 0;
+}
+
+void arena_init(arena_t* arena, size_t initial_capacity) {
+    arena->base = NULL;
+    arena->raw = NULL;
+    arena->capacity = 0;
+    arena->used = 0;
+    arena->overflow = NULL;
+    arena->overflow_used = 0;
+    arena->peak_bytes = 0;
+    arena->resets = 0;
+    arena->heap_allocs = 0;
+    arena_alloc_main(arena, initial_capacity);
+}
+
+void arena_destroy(arena_t* arena) {
+    if (!arena) return;
+    arena_free_overflow(arena);
+    free(arena->raw);
+    arena->raw = NULL;
+    arena->base = NULL;
+    arena->capacity = 0;
+    arena->used = 0;
+}
+
+void* arena_alloc(arena_t* arena, size_t size) {
+    size = align_up(size ? size : 1);
+
+    // Fast path: bump the main block
+    if (arena->used + size <= arena->capacity) {
+        void* ptr = arena->base + arena->used;
+        arena->used += size;
+        return ptr;
+    }
+
+    // Spill: one dedicated heap block per oversized request this frame
+    size_t header = align_up(sizeof(arena_block_t));
+    arena_block_t* block = malloc(header + size + ARENA_ALIGNMENT);
+    if (!block) return NULL;
+    arena->heap_allocs++;
+    block->size = size;
+    block->next = arena->overflow;
+    arena->overflow = block;
+    arena->overflow_used += size;
+    return align_ptr((unsigned char*)block + header);
+}
+
+void arena_reset(arena_t* arena) {
+    size_t frame_bytes = arena->used + arena->overflow_used;
+    if (frame_bytes > arena->peak_bytes) arena->peak_bytes = frame_bytes;
+
+    // Grow the main block to the high-water mark so the next frame fits
+    if (arena->overflow) {
+        arena_free_overflow(arena);
+        arena_alloc_main(arena, arena->peak_bytes);
+    }
+
+    arena->used = 0;
+    arena->resets++;
+}
+
+arena_stats_t arena_get_stats(const arena_t* arena) {
+    size_t used = arena->used + arena->overflow_used;
+    arena_stats_t stats = {
+        .capacity = arena->capacity,
+        .used = used,
+        .peak_bytes = used > arena->peak_bytes ? used : arena->peak_bytes,
+        .resets = arena->resets,
+        .heap_allocs = arena->heap_allocs
+    };
+    return stats;
+}
@@ -1,33 +1,134 @@
 #include <stdlib.h>
 #include "canvas.h"
+#include "cpu.h"
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CANVAS_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+// Aligned allocation helpers (posix_memalign is not available on Windows)
+static void* canvas_aligned_alloc(size_t size) {
+#ifdef _WIN32
+    return _aligned_malloc(size, CANVAS_ALIGNMENT);
+#else
+    void* ptr = NULL;
+    if (posix_memalign(&ptr, CANVAS_ALIGNMENT, size) != 0) return NULL;
+    return ptr;
+#endif
+}
+
+static void canvas_aligned_free(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+static size_t canvas_pixel_size(canvas_format_t format) {
+    return format == CANVAS_FORMAT_UNORM16 ? sizeof(uint16_t) : sizeof(float);
+}
+
+// Allocate the canvas header and its row table in a single block (the row
+// table only exists for float canvases)
+static canvas_t* canvas_alloc_header(void* data, int width, int height, int stride,
+                                     canvas_format_t format) {
+    int rows = format == CANVAS_FORMAT_FLOAT32 ? height : 0;
+    canvas_t* canvas = malloc(sizeof(canvas_t) + sizeof(float*) * rows);
+    if (!canvas) return NULL;
 
-// Create a canvas with the given width and height
-canvas_t* create_canvas(int width, int height) {
-    canvas_t* canvas = malloc(sizeof(canvas_t));
     canvas->width = width;
     canvas->height = height;
-
-    // Allocate 2D array for pixel brightness
-    canvas->pixels = malloc(sizeof(float*) * height);
+    canvas->stride = stride;
+    canvas->format = format;
+    canvas->data = NULL;
+    canvas->data16 = NULL;
+    canvas->pixels = NULL;
+    canvas->owns_data = 0;
+    canvas->depth = NULL;
+    if (format == CANVAS_FORMAT_UNORM16) {
+        canvas->data16 = data;
+        return canvas;
+    }
+    canvas->data = data;
+    canvas->pixels = (float**)(canvas + 1);
     for (int i = 0; i < height; i++) {
-        canvas->pixels[i] = calloc(width, sizeof(float)); // init to 0.0
+        canvas->pixels[i] = canvas->data + (size_t)i * stride;
     }
+    return canvas;
+}
+
+// Create a canvas with the given width, height and pixel format
+canvas_t* create_canvas_format(int width, int height, canvas_format_t format) {
+    if (width <= 0 || height <= 0) return NULL;
+    if (format != CANVAS_FORMAT_FLOAT32 && format != CANVAS_FORMAT_UNORM16) return NULL;
+
+    // Round each row up to a whole number of cache lines
+    const size_t pixel_size = canvas_pixel_size(format);
+    const int pixels_per_line = (int)(CANVAS_ALIGNMENT / pixel_size);
+    int stride = (width + pixels_per_line - 1) / pixels_per_line * pixels_per_line;
 
+    size_t bytes = (size_t)stride * height * pixel_size;
+    void* data = canvas_aligned_alloc(bytes);
+    if (!data) return NULL;
+    memset(data, 0, bytes); // init to 0.0
+
+    canvas_t* canvas = canvas_alloc_header(data, width, height, stride, format);
+    if (!canvas) {
+        canvas_aligned_free(data);
+        return NULL;
+    }
+    canvas->owns_data = 1;
     return canvas;
 }
 
+canvas_t* create_canvas(int width, int height) {
+    return create_canvas_format(width, height, CANVAS_FORMAT_FLOAT32);
+}
+
+// Wrap caller-owned memory; stride is in floats (0 means tightly packed rows)
+canvas_t* canvas_wrap(float* data, int width, int height, int stride) {
+    if (!data || width <= 0 || height <= 0) return NULL;
+    if (stride == 0) stride = width;
+    if (stride < width) return NULL;
+    return canvas_alloc_header(data, width, height, stride, CANVAS_FORMAT_FLOAT32);
+}
+
 // Free the canvas memory
 void free_canvas(canvas_t* canvas) {
     if (canvas) {
-        for (int i = 0; i < canvas->height; i++) {
-            free(canvas->pixels[i]);
+        if (canvas->owns_data) {
+            canvas_aligned_free(canvas->format == CANVAS_FORMAT_UNORM16 ? (void*)canvas->data16
+                                                                        : (void*)canvas->data);
         }
-        free(canvas->pixels);
+        depth_buffer_destroy(canvas->depth);
         free(canvas);
     }
 }
+
+// Saturating fixed-point accumulate
+static inline void add16(uint16_t* pixel, uint16_t value) {
+    unsigned int sum = (unsigned int)*pixel + value;
+    *pixel = sum > CANVAS_UNORM16_MAX ? CANVAS_UNORM16_MAX : (uint16_t)sum;
+}
+
+// Add a contribution to one pixel in the canvas format
+static inline void accumulate(canvas_t* canvas, int x, int y, float value) {
+    if (canvas->format == CANVAS_FORMAT_UNORM16) {
+        add16(canvas_row16(canvas, y) + x, canvas_fixed16(value));
+    } else {
+        canvas_row(canvas, y)[x] += value;
+    }
+}
+
 void set_pixel_f(canvas_t* canvas, float x, float y, float intensity) {
     int x0 = (int)floorf(x);
     int y0 = (int)floorf(y);
@@ -43,10 +144,22 @@ void set_pixel_f(canvas_t* canvas, float x, float y, float intensity) {
     float w01 = (1 - fx) * fy;
     float w11 = fx * fy;
 
+    // Fast path: the whole 2x2 footprint lies on the canvas
+    if (x0 >= 0 && x1 < canvas->width && y0 >= 0 && y1 < canvas->height &&
+        canvas->format == CANVAS_FORMAT_FLOAT32) {
+        float* row0 = canvas_row(canvas, y0);
+        float* row1 = row0 + canvas->stride;
+        row0[x0] += intensity * w00;
+        row0[x1] += intensity * w10;
+        row1[x0] += intensity * w01;
+        row1[x1] += intensity * w11;
+        return;
+    }
+
     // Helper macro to safely set pixel with bounds check
     #define SET_PIXEL_SAFE(xx, yy, value) \
         if ((xx) >= 0 && (xx) < canvas->width && (yy) >= 0 && (yy) < canvas->height) \
-            canvas->pixels[yy][xx] += (value);
+            accumulate(canvas, xx, yy, value);
 
     SET_PIXEL_SAFE(x0, y0, intensity * w00);
     SET_PIXEL_SAFE(x1, y0, intensity * w10);
@@ -55,27 +168,838 @@ void set_pixel_f(canvas_t* canvas, float x, float y, float intensity) {
 
     #undef SET_PIXEL_SAFE
 }
-void draw_line_f(canvas_t* canvas, float x0, float y0, float x1, float y1, float thickness) {
+
+// Depth test state for one line: target buffer, the line's bias and its counters
+typedef struct {
+    depth_buffer_t* buffer;
+    float bias;
+    uint64_t tests;
+    uint64_t passes;
+} depth_pass_t;
+
+static inline int depth_pass(depth_pass_t* pass, int x, int y, float z) {
+    pass->tests++;
+    if (!depth_buffer_test(pass->buffer, x, y, z, pass->bias)) return 0;
+    pass->passes++;
+    return 1;
+}
+
+// Bilinear splat restricted to a clip rectangle already inside the canvas.
+// Computes exactly the same contributions as set_pixel_f. With a depth pass,
+// each of the four pixels is written only if depth z passes there.
+static inline void splat_clipped(canvas_t* canvas, float x, float y, float intensity,
+                                 const canvas_rect_t* clip, float z, depth_pass_t* depth) {
+    int x0 = (int)floorf(x);
+    int y0 = (int)floorf(y);
+    int x1 = x0 + 1;
+    int y1 = y0 + 1;
+
+    float fx = x - x0;
+    float fy = y - y0;
+
+    // Bilinear weights
+    float w00 = (1 - fx) * (1 - fy);
+    float w10 = fx * (1 - fy);
+    float w01 = (1 - fx) * fy;
+    float w11 = fx * fy;
+
+    #define SET_PIXEL_CLIPPED(xx, yy, value) \
+        if ((xx) >= clip->x0 && (xx) < clip->x1 && (yy) >= clip->y0 && (yy) < clip->y1 && \
+            (!depth || depth_pass(depth, xx, yy, z))) \
+            accumulate(canvas, xx, yy, value);
+
+    SET_PIXEL_CLIPPED(x0, y0, intensity * w00);
+    SET_PIXEL_CLIPPED(x1, y0, intensity * w10);
+    SET_PIXEL_CLIPPED(x0, y1, intensity * w01);
+    SET_PIXEL_CLIPPED(x1, y1, intensity * w11);
+
+    #undef SET_PIXEL_CLIPPED
+}
+
+// Narrow the sample range [*lo, *hi] to samples whose footprint can reach the
+// band [band_lo, band_hi) along one axis (start + i * step)
+static void limit_steps(float start, float step, float band_lo, float band_hi,
+                        float* lo, float* hi) {
+    if (step == 0.0f) {
+        if (start < band_lo || start >= band_hi) *hi = -1.0f;  // Never enters the band
+        return;
+    }
+    float a = (band_lo - start) / step;
+    float b = (band_hi - start) / step;
+    if (a > b) { float t = a; a = b; b = t; }
+    // One extra step either side keeps the bound conservative under rounding
+    if (a - 1.0f > *lo) *lo = floorf(a - 1.0f);
+    if (b + 1.0f < *hi) *hi = ceilf(b + 1.0f);
+}
+
+// Fixed-point splat lines (UNORM16, no depth test)
+//
+// The SIMD kernels compute the samples' positions, bilinear weights and
+// fixed-point contributions with the same float operations as splat_clipped,
+// several samples per iteration, so any split between kernels and the scalar
+// tail gives identical pixels. Footprints inside the clip rectangle are added
+// one pixel pair (low word = left pixel) per row with a saturating add.
+
+typedef struct {
+    float x0, y0;
+    float step_x, step_y;
+    float intensity;
+    int half;             // Thickness square is [-half, half] in each axis
+    canvas_rect_t r;      // Clip rectangle, already inside the canvas
+} splat16_line_t;
+
+// Commit one footprint: 2x2 pixels at (x, y), contributions packed as pixel pairs
+static inline void splat16_commit(canvas_t* canvas, const canvas_rect_t* r, int x, int y,
+                                  uint32_t top, uint32_t bottom) {
+    if (x >= r->x0 && x + 1 < r->x1 && y >= r->y0 && y + 1 < r->y1) {
+        uint16_t* row0 = canvas_row16(canvas, y) + x;
+        uint16_t* row1 = row0 + canvas->stride;
+        add16(row0, (uint16_t)top);
+        add16(row0 + 1, (uint16_t)(top >> 16));
+        add16(row1, (uint16_t)bottom);
+        add16(row1 + 1, (uint16_t)(bottom >> 16));
+        return;
+    }
+    const uint16_t values[4] = { (uint16_t)top, (uint16_t)(top >> 16),
+                                 (uint16_t)bottom, (uint16_t)(bottom >> 16) };
+    for (int k = 0; k < 4; k++) {
+        int xx = x + (k & 1), yy = y + (k >> 1);
+        if (xx >= r->x0 && xx < r->x1 && yy >= r->y0 && yy < r->y1) {
+            add16(canvas_row16(canvas, yy) + xx, values[k]);
+        }
+    }
+}
+
+#ifdef CANVAS_HAVE_X86
+// Both rows of an inside footprint as two 32-bit saturating adds
+__attribute__((target("sse2")))
+static inline void add16_pair(uint16_t* pixels, uint32_t pair) {
+    uint32_t current;
+    memcpy(&current, pixels, sizeof(current));
+    __m128i sum = _mm_adds_epu16(_mm_cvtsi32_si128((int)current), _mm_cvtsi32_si128((int)pair));
+    current = (uint32_t)_mm_cvtsi128_si32(sum);
+    memcpy(pixels, &current, sizeof(current));
+}
+
+// Lanes computed by a kernel: footprint corners and packed contributions
+typedef struct {
+    int32_t x[8];
+    int32_t y[8];
+    uint32_t top[8];
+    uint32_t bottom[8];
+} splat16_lanes_t;
+
+__attribute__((target("sse2")))
+static inline void splat16_commit_lanes(canvas_t* canvas, const canvas_rect_t* r,
+                                        const splat16_lanes_t* lanes, int count) {
+    for (int l = 0; l < count; l++) {
+        int x = lanes->x[l], y = lanes->y[l];
+        if (x >= r->x0 && x + 1 < r->x1 && y >= r->y0 && y + 1 < r->y1) {
+            uint16_t* row0 = canvas_row16(canvas, y) + x;
+            add16_pair(row0, lanes->top[l]);
+            add16_pair(row0 + canvas->stride, lanes->bottom[l]);
+        } else {
+            splat16_commit(canvas, r, x, y, lanes->top[l], lanes->bottom[l]);
+        }
+    }
+}
+
+// SSE2: 4 samples per iteration; floor is built from truncation
+__attribute__((target("sse2")))
+static float splat16_sse2(canvas_t* canvas, const splat16_line_t* line, float i, float last) {
+    const __m128 lane = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(65535.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 intensity = _mm_set1_ps(line->intensity);
+    splat16_lanes_t lanes;
+
+    for (; i + 3.0f <= last; i += 4.0f) {
+        __m128 index = _mm_add_ps(_mm_set1_ps(i), lane);
+        __m128 sx = _mm_add_ps(_mm_set1_ps(line->x0), _mm_mul_ps(index, _mm_set1_ps(line->step_x)));
+        __m128 sy = _mm_add_ps(_mm_set1_ps(line->y0), _mm_mul_ps(index, _mm_set1_ps(line->step_y)));
+        for (int dx = -line->half; dx <= line->half; dx++) {
+            for (int dy = -line->half; dy <= line->half; dy++) {
+                __m128 px = _mm_add_ps(sx, _mm_set1_ps((float)dx));
+                __m128 py = _mm_add_ps(sy, _mm_set1_ps((float)dy));
+
+                // floor: truncate, then step down where truncation rounded up
+                __m128i ix = _mm_cvttps_epi32(px);
+                __m128i iy = _mm_cvttps_epi32(py);
+                ix = _mm_add_epi32(ix, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(ix), px)));
+                iy = _mm_add_epi32(iy, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(iy), py)));
+                __m128 fx = _mm_sub_ps(px, _mm_cvtepi32_ps(ix));
+                __m128 fy = _mm_sub_ps(py, _mm_cvtepi32_ps(iy));
+                __m128 gx = _mm_sub_ps(one, fx);
+                __m128 gy = _mm_sub_ps(one, fy);
+
+                __m128 w[4] = { _mm_mul_ps(gx, gy), _mm_mul_ps(fx, gy),
+                                _mm_mul_ps(gx, fy), _mm_mul_ps(fx, fy) };
+                __m128i q[4];
+                for (int k = 0; k < 4; k++) {
+                    __m128 v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(intensity, w[k]), zero), one);
+                    q[k] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), half));
+                }
+                _mm_storeu_si128((__m128i*)lanes.x, ix);
+                _mm_storeu_si128((__m128i*)lanes.y, iy);
+                _mm_storeu_si128((__m128i*)lanes.top, _mm_or_si128(q[0], _mm_slli_epi32(q[1], 16)));
+                _mm_storeu_si128((__m128i*)lanes.bottom, _mm_or_si128(q[2], _mm_slli_epi32(q[3], 16)));
+                splat16_commit_lanes(canvas, &line->r, &lanes, 4);
+            }
+        }
+    }
+    return i;
+}
+
+// AVX2: 8 samples per iteration. No FMA, so the arithmetic matches the scalar path.
+__attribute__((target("avx2")))
+static float splat16_avx2(canvas_t* canvas, const splat16_line_t* line, float i, float last) {
+    const __m256 lane = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 scale = _mm256_set1_ps(65535.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 intensity = _mm256_set1_ps(line->intensity);
+    splat16_lanes_t lanes;
+
+    for (; i + 7.0f <= last; i += 8.0f) {
+        __m256 index = _mm256_add_ps(_mm256_set1_ps(i), lane);
+        __m256 sx = _mm256_add_ps(_mm256_set1_ps(line->x0),
+                                  _mm256_mul_ps(index, _mm256_set1_ps(line->step_x)));
+        __m256 sy = _mm256_add_ps(_mm256_set1_ps(line->y0),
+                                  _mm256_mul_ps(index, _mm256_set1_ps(line->step_y)));
+        for (int dx = -line->half; dx <= line->half; dx++) {
+            for (int dy = -line->half; dy <= line->half; dy++) {
+                __m256 px = _mm256_add_ps(sx, _mm256_set1_ps((float)dx));
+                __m256 py = _mm256_add_ps(sy, _mm256_set1_ps((float)dy));
+                __m256 floor_x = _mm256_floor_ps(px);
+                __m256 floor_y = _mm256_floor_ps(py);
+                __m256 fx = _mm256_sub_ps(px, floor_x);
+                __m256 fy = _mm256_sub_ps(py, floor_y);
+                __m256 gx = _mm256_sub_ps(one, fx);
+                __m256 gy = _mm256_sub_ps(one, fy);
+
+                __m256 w[4] = { _mm256_mul_ps(gx, gy), _mm256_mul_ps(fx, gy),
+                                _mm256_mul_ps(gx, fy), _mm256_mul_ps(fx, fy) };
+                __m256i q[4];
+                for (int k = 0; k < 4; k++) {
+                    __m256 v = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(intensity, w[k]), zero), one);
+                    q[k] = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(v, scale), half));
+                }
+                _mm256_storeu_si256((__m256i*)lanes.x, _mm256_cvttps_epi32(floor_x));
+                _mm256_storeu_si256((__m256i*)lanes.y, _mm256_cvttps_epi32(floor_y));
+                _mm256_storeu_si256((__m256i*)lanes.top,
+                                    _mm256_or_si256(q[0], _mm256_slli_epi32(q[1], 16)));
+                _mm256_storeu_si256((__m256i*)lanes.bottom,
+                                    _mm256_or_si256(q[2], _mm256_slli_epi32(q[3], 16)));
+                splat16_commit_lanes(canvas, &line->r, &lanes, 8);
+            }
+        }
+    }
+    return i;
+}
+#endif
+
+static void splat_line16(canvas_t* canvas, const splat16_line_t* line, float first, float last) {
+    float i = first;
+#ifdef CANVAS_HAVE_X86
+    unsigned int features = cpu_features();
+    if (features & CPU_FEATURE_AVX2) {
+        i = splat16_avx2(canvas, line, i, last);
+    } else if (features & CPU_FEATURE_SSE2) {
+        i = splat16_sse2(canvas, line, i, last);
+    }
+#endif
+    for (; i <= last; i++) {
+        float x = line->x0 + i * line->step_x;
+        float y = line->y0 + i * line->step_y;
+        for (int dx = -line->half; dx <= line->half; dx++) {
+            for (int dy = -line->half; dy <= line->half; dy++) {
+                splat_clipped(canvas, x + dx, y + dy, line->intensity, &line->r, 0.0f, NULL);
+            }
+        }
+    }
+}
+
+static void line_f(canvas_t* canvas, float x0, float y0, float z0,
+                   float x1, float y1, float z1, float thickness, float intensity,
+                   const canvas_rect_t* clip, depth_pass_t* depth) {
+    canvas_rect_t r = { 0, 0, canvas->width, canvas->height };
+    if (clip) {
+        if (clip->x0 > r.x0) r.x0 = clip->x0;
+        if (clip->y0 > r.y0) r.y0 = clip->y0;
+        if (clip->x1 < r.x1) r.x1 = clip->x1;
+        if (clip->y1 < r.y1) r.y1 = clip->y1;
+    }
+    if (r.x0 >= r.x1 || r.y0 >= r.y1) return;
+
     float dx = x1 - x0;
     float dy = y1 - y0;
     float length = fmaxf(fabsf(dx), fabsf(dy));
-    
+
     if (length == 0.0f) return;  // Avoid division by zero
 
     float step_x = dx / length;
     float step_y = dy / length;
+    float step_z = (z1 - z0) / length;
+    int half = (int)(thickness / 2);
+
+    // Splats up to 2 * half + 1 samples apart share pixels; biasing by that much
+    // depth keeps the line from occluding itself
+    if (depth) depth->bias = fabsf(step_z) * (float)(2 * half + 2);
 
-    for (float i = 0; i <= length; i++) {
+    // Only walk the samples whose splats can touch the clip rectangle
+    float first = 0.0f, last = length;
+    limit_steps(x0, step_x, (float)(r.x0 - half - 1), (float)(r.x1 + half), &first, &last);
+    limit_steps(y0, step_y, (float)(r.y0 - half - 1), (float)(r.y1 + half), &first, &last);
+
+    if (canvas->format == CANVAS_FORMAT_UNORM16 && !depth) {
+        splat16_line_t line = { x0, y0, step_x, step_y, intensity, half, r };
+        splat_line16(canvas, &line, first, last);
+        return;
+    }
+
+    for (float i = first; i <= last; i++) {
         float x = x0 + i * step_x;
         float y = y0 + i * step_y;
+        float z = depth ? z0 + i * step_z : 0.0f;
 
         // Draw square around the point for thickness
-        int half = (int)(thickness / 2);
         for (int dx = -half; dx <= half; dx++) {
             for (int dy = -half; dy <= half; dy++) {
-                set_pixel_f(canvas, x + dx, y + dy, 1.0f);  // Max brightness
+                splat_clipped(canvas, x + dx, y + dy, intensity, &r, z, depth);
             }
         }
     }
 }
 
+void draw_line_f_clipped(canvas_t* canvas, float x0, float y0, float x1, float y1,
+                         float thickness, const canvas_rect_t* clip) {
+    line_f(canvas, x0, y0, 0.0f, x1, y1, 0.0f, thickness, 1.0f, clip, NULL);  // Max brightness
+}
+
+void draw_line_f_depth(canvas_t* canvas, float x0, float y0, float z0,
+                       float x1, float y1, float z1, float thickness, float intensity,
+                       const canvas_rect_t* clip) {
+    if (!canvas->depth) {
+        line_f(canvas, x0, y0, z0, x1, y1, z1, thickness, intensity, clip, NULL);
+        return;
+    }
+    depth_pass_t depth = { canvas->depth, 0.0f, 0, 0 };
+    line_f(canvas, x0, y0, z0, x1, y1, z1, thickness, intensity, clip, &depth);
+    depth_buffer_count(canvas->depth, depth.tests, depth.passes);
+}
+
+void draw_line_f(canvas_t* canvas, float x0, float y0, float x1, float y1, float thickness) {
+    draw_line_f_clipped(canvas, x0, y0, x1, y1, thickness, NULL);
+}
+
+// Sub-pixel lines: line_f walks only sample 0, so keep its position, depth
+// and bias (computed with the same operations)
+int canvas_point_from_line(float x0, float y0, float z0, float x1, float y1, float z1,
+                           float thickness, float intensity, canvas_point_t* point) {
+    float length = fmaxf(fabsf(x1 - x0), fabsf(y1 - y0));
+    if (!(length > 0.0f && length < 1.0f)) return 0;
+    float step_z = (z1 - z0) / length;
+    int half = (int)(thickness / 2);
+    *point = (canvas_point_t){ x0, y0, z0, intensity, fabsf(step_z) * (float)(2 * half + 2) };
+    return 1;
+}
+
+void draw_points_f_depth(canvas_t* canvas, const canvas_point_t* points, int count,
+                         float thickness, const canvas_rect_t* clip) {
+    canvas_rect_t r = { 0, 0, canvas->width, canvas->height };
+    if (clip) {
+        if (clip->x0 > r.x0) r.x0 = clip->x0;
+        if (clip->y0 > r.y0) r.y0 = clip->y0;
+        if (clip->x1 < r.x1) r.x1 = clip->x1;
+        if (clip->y1 < r.y1) r.y1 = clip->y1;
+    }
+    if (r.x0 >= r.x1 || r.y0 >= r.y1 || count <= 0) return;
+
+    int half = (int)(thickness / 2);
+    depth_pass_t depth = { canvas->depth, 0.0f, 0, 0 };
+    depth_pass_t* pass = canvas->depth ? &depth : NULL;
+    for (int i = 0; i < count; i++) {
+        const canvas_point_t* p = &points[i];
+        float z = pass ? p->z : 0.0f;
+        depth.bias = p->bias;
+        for (int dx = -half; dx <= half; dx++) {
+            for (int dy = -half; dy <= half; dy++) {
+                splat_clipped(canvas, p->x + dx, p->y + dy, p->intensity, &r, z, pass);
+            }
+        }
+    }
+    if (pass) depth_buffer_count(canvas->depth, depth.tests, depth.passes);
+}
+
+// Anti-aliased lines
+//
+// Both engines walk the major axis one pixel column at a time (pixel centers at
+// integer coordinates). Every per-pixel contribution is a function of the
+// original endpoints and the column index only, so clipping changes which
+// pixels are written, never what they receive.
+
+// Column range [lo, hi] along the major axis limited so the minor coordinate
+// v0 + (u - u0) * g stays within [band_lo, band_hi]
+static void limit_columns(float u0, float v0, float g, float band_lo, float band_hi,
+                          int* lo, int* hi) {
+    if (g == 0.0f) {
+        if (v0 < band_lo || v0 > band_hi) *hi = *lo - 1;
+        return;
+    }
+    float a = u0 + (band_lo - v0) / g;
+    float b = u0 + (band_hi - v0) / g;
+    if (a > b) { float t = a; a = b; b = t; }
+    // One extra column either side keeps the bound conservative under rounding
+    a -= 1.0f;
+    b += 1.0f;
+    if (!(b >= (float)*lo && a <= (float)*hi)) {  // Band missed (or NaN): no columns
+        *hi = *lo - 1;
+        return;
+    }
+    // Clamp in float first: a far-off line puts a or b beyond int range
+    if (a > (float)*lo) *lo = (int)floorf(fminf(a, (float)*hi));
+    if (b < (float)*hi) *hi = (int)ceilf(fmaxf(b, (float)*lo));
+}
+
+// Columns never share pixels, so a line cannot occlude itself and the depth
+// test needs no bias
+static void line_aa(canvas_t* canvas, float x0, float y0, float z0,
+                    float x1, float y1, float z1, float thickness, float intensity,
+                    const canvas_rect_t* clip, depth_pass_t* depth) {
+    canvas_rect_t r = { 0, 0, canvas->width, canvas->height };
+    if (clip) {
+        if (clip->x0 > r.x0) r.x0 = clip->x0;
+        if (clip->y0 > r.y0) r.y0 = clip->y0;
+        if (clip->x1 < r.x1) r.x1 = clip->x1;
+        if (clip->y1 < r.y1) r.y1 = clip->y1;
+    }
+    if (r.x0 >= r.x1 || r.y0 >= r.y1) return;
+    if (!(isfinite(x0) && isfinite(y0) && isfinite(x1) && isfinite(y1))) return;
+
+    // Map to (u = major, v = minor) axes with u0 <= u1
+    int x_major = fabsf(x1 - x0) >= fabsf(y1 - y0);
+    float u0 = x_major ? x0 : y0, v0 = x_major ? y0 : x0;
+    float u1 = x_major ? x1 : y1, v1 = x_major ? y1 : x1;
+    if (u0 > u1) {
+        float t = u0; u0 = u1; u1 = t;
+        t = v0; v0 = v1; v1 = t;
+        t = z0; z0 = z1; z1 = t;
+    }
+    if (u1 - u0 == 0.0f) return;  // Zero-length line
+
+    // Clip rectangle and pointer steps in (u, v) terms
+    int ru0 = x_major ? r.x0 : r.y0, ru1 = x_major ? r.x1 : r.y1;
+    int rv0 = x_major ? r.y0 : r.x0, rv1 = x_major ? r.y1 : r.x1;
+    ptrdiff_t u_step = x_major ? 1 : canvas->stride;
+    ptrdiff_t v_step = x_major ? canvas->stride : 1;
+
+    float g = (v1 - v0) / (u1 - u0);
+    float gz = (z1 - z0) / (u1 - u0);
+    int thick = thickness > 1.0f;
+    // Half-extent of the band measured along the minor axis
+    float h = thick ? 0.5f * thickness * sqrtf(1.0f + g * g) : 0.5f;
+
+    // Clip the column range once: to the segment, the rectangle and the band
+    int c_lo = (int)floorf(u0 + 0.5f);
+    int c_hi = (int)floorf(u1 + 0.5f);
+    if (c_lo < ru0) c_lo = ru0;
+    if (c_hi > ru1 - 1) c_hi = ru1 - 1;
+    limit_columns(u0, v0, g, (float)rv0 - h - 1.0f, (float)rv1 + h, &c_lo, &c_hi);
+    if (c_lo > c_hi) return;
+
+    float* data = canvas->data;
+    uint16_t* data16 = canvas->format == CANVAS_FORMAT_UNORM16 ? canvas->data16 : NULL;
+
+    #define COLUMN_SETUP(c) \
+        float v = v0 + ((float)(c) - u0) * g; \
+        float cover = fminf((float)(c) + 0.5f, u1) - fmaxf((float)(c) - 0.5f, u0); \
+        if (cover > 1.0f) cover = 1.0f; \
+        float weight = intensity * cover; \
+        ptrdiff_t column = (ptrdiff_t)(c) * u_step; \
+        float z = depth ? z0 + ((float)(c) - u0) * gz : 0.0f;
+
+    // Accumulate into (column c, minor row), depth-tested when requested
+    #define PLOT(row, value) \
+        if (!depth || depth_pass(depth, x_major ? c : (row), x_major ? (row) : c, z)) { \
+            ptrdiff_t at = column + (ptrdiff_t)(row) * v_step; \
+            if (data16) add16(data16 + at, canvas_fixed16(value)); \
+            else data[at] += (value); \
+        }
+
+    if (!thick) {
+        // Xiaolin Wu: two pixels per column split by the fractional minor coordinate.
+        // Columns where both pixels are inside the rectangle skip the row checks.
+        int safe_lo = c_lo, safe_hi = c_hi;
+        limit_columns(u0, v0, g, (float)rv0 + 1.0f, (float)rv1 - 2.0f, &safe_lo, &safe_hi);
+        #define WU_ROWS_INSIDE(c) \
+            ((int)floorf(v0 + ((float)(c) - u0) * g) >= rv0 && \
+             (int)floorf(v0 + ((float)(c) - u0) * g) + 1 < rv1)
+        while (safe_lo <= safe_hi && !WU_ROWS_INSIDE(safe_lo)) safe_lo++;
+        while (safe_hi >= safe_lo && !WU_ROWS_INSIDE(safe_hi)) safe_hi--;
+        #undef WU_ROWS_INSIDE
+        if (safe_lo > safe_hi) { safe_lo = c_hi + 1; safe_hi = c_hi; }
+
+        for (int c = c_lo; c <= c_hi; c++) {
+            COLUMN_SETUP(c);
+            float fv = floorf(v);
+            int row = (int)fv;
+            float frac = v - fv;
+            if (c >= safe_lo && c <= safe_hi) {
+                PLOT(row, weight * (1.0f - frac));
+                PLOT(row + 1, weight * frac);
+            } else {
+                if (row >= rv0 && row < rv1) { PLOT(row, weight * (1.0f - frac)); }
+                if (row + 1 >= rv0 && row + 1 < rv1) { PLOT(row + 1, weight * frac); }
+            }
+        }
+        return;
+    }
+
+    // Thick band: each column covers [v - h, v + h] on the minor axis at its
+    // centre; every pixel in the span receives its 1-D overlap with it once
+    for (int c = c_lo; c <= c_hi; c++) {
+        COLUMN_SETUP(c);
+        float lo = v - h, hi = v + h;
+        int first = (int)floorf(lo + 0.5f);
+        int last = (int)floorf(hi + 0.5f);
+        if (first < rv0) first = rv0;
+        if (last > rv1 - 1) last = rv1 - 1;
+
+        for (int row = first; row <= last; row++) {
+            float overlap = fminf((float)row + 0.5f, hi) - fmaxf((float)row - 0.5f, lo);
+            if (overlap > 0.0f) { PLOT(row, weight * overlap); }
+        }
+    }
+    #undef PLOT
+    #undef COLUMN_SETUP
+}
+
+void draw_line_aa_clipped(canvas_t* canvas, float x0, float y0, float x1, float y1,
+                          float thickness, float intensity, const canvas_rect_t* clip) {
+    line_aa(canvas, x0, y0, 0.0f, x1, y1, 0.0f, thickness, intensity, clip, NULL);
+}
+
+void draw_line_aa_depth(canvas_t* canvas, float x0, float y0, float z0,
+                        float x1, float y1, float z1, float thickness, float intensity,
+                        const canvas_rect_t* clip) {
+    if (!canvas->depth) {
+        line_aa(canvas, x0, y0, z0, x1, y1, z1, thickness, intensity, clip, NULL);
+        return;
+    }
+    depth_pass_t depth = { canvas->depth, 0.0f, 0, 0 };
+    line_aa(canvas, x0, y0, z0, x1, y1, z1, thickness, intensity, clip, &depth);
+    depth_buffer_count(canvas->depth, depth.tests, depth.passes);
+}
+
+void draw_line_aa(canvas_t* canvas, float x0, float y0, float x1, float y1,
+                  float thickness, float intensity) {
+    draw_line_aa_clipped(canvas, x0, y0, x1, y1, thickness, intensity, NULL);
+}
+
+int canvas_attach_depth(canvas_t* canvas, depth_format_t format) {
+    depth_buffer_t* depth = depth_buffer_create(canvas->width, canvas->height, format);
+    if (!depth) return -1;
+    depth_buffer_destroy(canvas->depth);
+    canvas->depth = depth;
+    return 0;
+}
+
+void canvas_detach_depth(canvas_t* canvas) {
+    depth_buffer_destroy(canvas->depth);
+    canvas->depth = NULL;
+}
+
+// Fill every pixel with the same value and reset the depth buffer
+void canvas_clear(canvas_t* canvas, float value) {
+    if (!canvas) return;
+    depth_buffer_clear(canvas->depth);
+
+    // Owned buffers are contiguous including row padding: one pass covers all
+    int rows = canvas->height;
+    size_t count = (size_t)canvas->width;
+    if (canvas->owns_data || canvas->stride == canvas->width) {
+        count = (size_t)canvas->stride * canvas->height;
+        rows = 1;
+    }
+
+    // Fixed-point canvases are always owned, so they take the single pass
+    if (canvas->format == CANVAS_FORMAT_UNORM16) {
+        uint16_t fill = canvas_fixed16(value);
+        if (fill == 0) {
+            memset(canvas->data16, 0, count * sizeof(uint16_t));
+        } else {
+            for (size_t i = 0; i < count; i++) canvas->data16[i] = fill;
+        }
+        return;
+    }
+
+    for (int y = 0; y < rows; y++) {
+        float* row = canvas_row(canvas, y);
+        if (value == 0.0f) {
+            memset(row, 0, count * sizeof(float));
+        } else {
+            for (size_t x = 0; x < count; x++) row[x] = value;
+        }
+    }
+}
+
+// Start of row y as raw bytes, for format-agnostic copies
+static inline unsigned char* canvas_row_bytes(const canvas_t* canvas, int y) {
+    size_t pixel_size = canvas_pixel_size(canvas->format);
+    void* base = canvas->format == CANVAS_FORMAT_UNORM16 ? (void*)canvas->data16 : (void*)canvas->data;
+    return (unsigned char*)base + (size_t)y * canvas->stride * pixel_size;
+}
+
+// Copy src into dst; both canvases must have the same dimensions and format
+int canvas_copy(canvas_t* dst, const canvas_t* src) {
+    if (!dst || !src) return -1;
+    if (dst->width != src->width || dst->height != src->height) return -1;
+    if (dst->format != src->format) return -1;
+
+    size_t pixel_size = canvas_pixel_size(src->format);
+    if (dst->stride == src->stride) {
+        memcpy(canvas_row_bytes(dst, 0), canvas_row_bytes(src, 0),
+               (size_t)src->stride * src->height * pixel_size);
+        return 0;
+    }
+    for (int y = 0; y < src->height; y++) {
+        memcpy(canvas_row_bytes(dst, y), canvas_row_bytes(src, y), (size_t)src->width * pixel_size);
+    }
+    return 0;
+}
+
+// Copy a rectangle from src to dst, clipped against both canvases
+void canvas_blit(canvas_t* dst, const canvas_t* src,
+                 int src_x, int src_y, int width, int height,
+                 int dst_x, int dst_y) {
+    if (!dst || !src || dst->format != src->format) return;
+
+    // Clip against the source
+    if (src_x < 0) { width += src_x; dst_x -= src_x; src_x = 0; }
+    if (src_y < 0) { height += src_y; dst_y -= src_y; src_y = 0; }
+    if (src_x + width > src->width) width = src->width - src_x;
+    if (src_y + height > src->height) height = src->height - src_y;
+
+    // Clip against the destination
+    if (dst_x < 0) { width += dst_x; src_x -= dst_x; dst_x = 0; }
+    if (dst_y < 0) { height += dst_y; src_y -= dst_y; dst_y = 0; }
+    if (dst_x + width > dst->width) width = dst->width - dst_x;
+    if (dst_y + height > dst->height) height = dst->height - dst_y;
+
+    if (width <= 0 || height <= 0) return;
+
+    // src and dst may be the same canvas: memmove handles overlap within a row,
+    // and copying bottom-up when moving down keeps source rows intact until read
+    size_t pixel_size = canvas_pixel_size(src->format);
+    int downward = dst == src && dst_y > src_y;
+    for (int i = 0; i < height; i++) {
+        int y = downward ? height - 1 - i : i;
+        memmove(canvas_row_bytes(dst, dst_y + y) + (size_t)dst_x * pixel_size,
+                canvas_row_bytes(src, src_y + y) + (size_t)src_x * pixel_size,
+                (size_t)width * pixel_size);
+    }
+}
+
+float canvas_get_pixel(const canvas_t* canvas, int x, int y) {
+    if (canvas->format == CANVAS_FORMAT_UNORM16) {
+        return canvas_row16(canvas, y)[x] * (1.0f / CANVAS_UNORM16_MAX);
+    }
+    return canvas_row(canvas, y)[x];
+}
+
+// Scalar reference: clamp to [0, 1], scale and round half up
+static void quantize_scalar(const float* src, unsigned char* dst, int count) {
+    for (int x = 0; x < count; x++) {
+        float v = src[x];
+        if (!(v > 0.0f)) v = 0.0f;  // Also maps NaN to black
+        if (v > 1.0f) v = 1.0f;
+        dst[x] = (unsigned char)(v * 255.0f + 0.5f);
+    }
+}
+
+#ifdef CANVAS_HAVE_X86
+// SSE2: 16 pixels per iteration, same operations as the scalar path
+__attribute__((target("sse2")))
+static int quantize_sse2(const float* src, unsigned char* dst, int count) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(255.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+
+    int x = 0;
+    for (; x + 16 <= count; x += 16) {
+        __m128i q[4];
+        for (int k = 0; k < 4; k++) {
+            // max(v, 0) returns 0 for NaN because the second operand wins
+            __m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + x + 4*k), zero), one);
+            q[k] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), half));
+        }
+        __m128i lo = _mm_packs_epi32(q[0], q[1]);
+        __m128i hi = _mm_packs_epi32(q[2], q[3]);
+        _mm_storeu_si128((__m128i*)(dst + x), _mm_packus_epi16(lo, hi));
+    }
+    return x;
+}
+
+// AVX2: 32 pixels per iteration. No FMA, so results match the scalar path.
+__attribute__((target("avx2")))
+static int quantize_avx2(const float* src, unsigned char* dst, int count) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 scale = _mm256_set1_ps(255.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    // Packs work per 128-bit lane; this permutation restores pixel order
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    int x = 0;
+    for (; x + 32 <= count; x += 32) {
+        __m256i q[4];
+        for (int k = 0; k < 4; k++) {
+            __m256 v = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + x + 8*k), zero), one);
+            q[k] = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(v, scale), half));
+        }
+        __m256i lo = _mm256_packs_epi32(q[0], q[1]);
+        __m256i hi = _mm256_packs_epi32(q[2], q[3]);
+        __m256i bytes = _mm256_packus_epi16(lo, hi);
+        _mm256_storeu_si256((__m256i*)(dst + x), _mm256_permutevar8x32_epi32(bytes, order));
+    }
+    return x;
+}
+#endif
+
+void canvas_quantize_u8(const float* src, unsigned char* dst, int count) {
+    int done = 0;
+#ifdef CANVAS_HAVE_X86
+    unsigned int features = cpu_features();
+    if (features & CPU_FEATURE_AVX2) {
+        done = quantize_avx2(src, dst, count);
+    } else if (features & CPU_FEATURE_SSE2) {
+        done = quantize_sse2(src, dst, count);
+    }
+#endif
+    quantize_scalar(src + done, dst + done, count - done);
+}
+
+// Fixed-point to 8-bit: v * 255 / 65535 = v / 257, rounded. 257 is odd, so
+// there are no ties and (v + 128) / 257 rounds exactly.
+static void quantize16_scalar(const uint16_t* src, unsigned char* dst, int count) {
+    for (int x = 0; x < count; x++) dst[x] = (unsigned char)((src[x] + 128u) / 257u);
+}
+
+#ifdef CANVAS_HAVE_X86
+// SIMD form of the division: t = v + 128 saturated (values past 65407 all map
+// to 255 either way), then t / 257 = (t * 65281) >> 24, exact for every 16-bit t
+__attribute__((target("sse2")))
+static int quantize16_sse2(const uint16_t* src, unsigned char* dst, int count) {
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i reciprocal = _mm_set1_epi16((short)65281);
+
+    int x = 0;
+    for (; x + 16 <= count; x += 16) {
+        __m128i a = _mm_adds_epu16(_mm_loadu_si128((const __m128i*)(src + x)), bias);
+        __m128i b = _mm_adds_epu16(_mm_loadu_si128((const __m128i*)(src + x + 8)), bias);
+        a = _mm_srli_epi16(_mm_mulhi_epu16(a, reciprocal), 8);
+        b = _mm_srli_epi16(_mm_mulhi_epu16(b, reciprocal), 8);
+        _mm_storeu_si128((__m128i*)(dst + x), _mm_packus_epi16(a, b));
+    }
+    return x;
+}
+
+__attribute__((target("avx2")))
+static int quantize16_avx2(const uint16_t* src, unsigned char* dst, int count) {
+    const __m256i bias = _mm256_set1_epi16(128);
+    const __m256i reciprocal = _mm256_set1_epi16((short)65281);
+
+    int x = 0;
+    for (; x + 32 <= count; x += 32) {
+        __m256i a = _mm256_adds_epu16(_mm256_loadu_si256((const __m256i*)(src + x)), bias);
+        __m256i b = _mm256_adds_epu16(_mm256_loadu_si256((const __m256i*)(src + x + 16)), bias);
+        a = _mm256_srli_epi16(_mm256_mulhi_epu16(a, reciprocal), 8);
+        b = _mm256_srli_epi16(_mm256_mulhi_epu16(b, reciprocal), 8);
+        // Packs work per 128-bit lane; swapping the middle quarters restores order
+        __m256i bytes = _mm256_packus_epi16(a, b);
+        _mm256_storeu_si256((__m256i*)(dst + x), _mm256_permute4x64_epi64(bytes, 0xD8));
+    }
+    return x;
+}
+#endif
+
+void canvas_quantize16_u8(const uint16_t* src, unsigned char* dst, int count) {
+    int done = 0;
+#ifdef CANVAS_HAVE_X86
+    unsigned int features = cpu_features();
+    if (features & CPU_FEATURE_AVX2) {
+        done = quantize16_avx2(src, dst, count);
+    } else if (features & CPU_FEATURE_SSE2) {
+        done = quantize16_sse2(src, dst, count);
+    }
+#endif
+    quantize16_scalar(src + done, dst + done, count - done);
+}
+
+void canvas_quantize_row_u8(const canvas_t* canvas, int y, unsigned char* dst) {
+    if (canvas->format == CANVAS_FORMAT_UNORM16) {
+        canvas_quantize16_u8(canvas_row16(canvas, y), dst, canvas->width);
+    } else {
+        canvas_quantize_u8(canvas_row(canvas, y), dst, canvas->width);
+    }
+}
+
+// Shared writer for binary PGM (P5, one channel) and PPM (P6, gray replicated)
+static int canvas_write_netpbm(const canvas_t* canvas, const char* path, int channels) {
+    FILE* fp = fopen(path, "wb");
+    if (!fp) return -1;
+
+    fprintf(fp, "P%d\n%d %d\n255\n", channels == 3 ? 6 : 5, canvas->width, canvas->height);
+
+    unsigned char* gray = malloc((size_t)canvas->width * (channels + 1));
+    if (!gray) {
+        fclose(fp);
+        return -1;
+    }
+    unsigned char* line = gray + canvas->width;
+
+    int status = 0;
+    for (int y = 0; y < canvas->height && status == 0; y++) {
+        canvas_quantize_row_u8(canvas, y, gray);
+        const unsigned char* out = gray;
+        if (channels == 3) {
+            for (int x = 0; x < canvas->width; x++) {
+                line[3*x] = line[3*x + 1] = line[3*x + 2] = gray[x];
+            }
+            out = line;
+        }
+        if (fwrite(out, channels, canvas->width, fp) != (size_t)canvas->width) status = -1;
+    }
+
+    free(gray);
+    if (fclose(fp) != 0) status = -1;
+    return status;
+}
+
+int canvas_save_ppm(const canvas_t* canvas, const char* filename, ...) {
+    if (!canvas || !filename) return -1;
+
+    char path[1024];
+    va_list args;
+    va_start(args, filename);
+    vsnprintf(path, sizeof(path), filename, args);
+    va_end(args);
+
+    return canvas_write_netpbm(canvas, path, 3);
+}
+
+int canvas_save_pgm(const canvas_t* canvas, const char* filename, ...) {
+    if (!canvas || !filename) return -1;
+
+    char path[1024];
+    va_list args;
+    va_start(args, filename);
+    vsnprintf(path, sizeof(path), filename, args);
+    va_end(args);
+
+    return canvas_write_netpbm(canvas, path, 1);
+}
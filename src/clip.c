@@ -0,0 +1,110 @@
+#include <math.h>
+#include "clip.h"
+
+void frustum_from_mvp(frustum_t* frustum, const mat4_t* mvp) {
+    const float* m = mvp->m;
+
+    // Rows of the column-major matrix
+    vec4_t r[4];
+    for (int i = 0; i < 4; i++) {
+        r[i] = (vec4_t){ m[i], m[4 + i], m[8 + i], m[12 + i] };
+    }
+
+    // Gribb/Hartmann: row3 +/- row0..2
+    for (int p = 0; p < 6; p++) {
+        const vec4_t* row = &r[p / 2];
+        float sign = (p % 2 == 0) ? 1.0f : -1.0f;
+        vec4_t plane = {
+            r[3].x + sign * row->x,
+            r[3].y + sign * row->y,
+            r[3].z + sign * row->z,
+            r[3].w + sign * row->w
+        };
+
+        float len = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (len > 1e-12f) {
+            float inv = 1.0f / len;
+            plane.x *= inv;
+            plane.y *= inv;
+            plane.z *= inv;
+            plane.w *= inv;
+        }
+        frustum->planes[p] = plane;
+    }
+}
+
+int frustum_sphere_visible(const frustum_t* frustum, vec3f_t center, float radius) {
+    for (int p = 0; p < 6; p++) {
+        const vec4_t* plane = &frustum->planes[p];
+        float dist = plane->x * center.x + plane->y * center.y + plane->z * center.z + plane->w;
+        if (dist < -radius) return 0;
+    }
+    return 1;
+}
+
+// Clip against one plane given signed distances (inside >= 0) at both ends
+static int clip_against(vec4_t* a, vec4_t* b, float da, float db) {
+    if (da >= 0.0f && db >= 0.0f) return 1;
+    if (da < 0.0f && db < 0.0f) return 0;
+
+    float t = da / (da - db);
+    vec4_t p = {
+        a->x + t * (b->x - a->x),
+        a->y + t * (b->y - a->y),
+        a->z + t * (b->z - a->z),
+        a->w + t * (b->w - a->w)
+    };
+    if (da < 0.0f) *a = p;
+    else *b = p;
+    return 1;
+}
+
+int clip_homogeneous_near_far(vec4_t* a, vec4_t* b) {
+    // Near: z + w >= 0, far: w - z >= 0
+    if (!clip_against(a, b, a->z + a->w, b->z + b->w)) return 0;
+    return clip_against(a, b, a->w - a->z, b->w - b->z);
+}
+
+int clip_segment_circle(segment_t* segment, float cx, float cy, float radius) {
+    float fx = segment->x0 - cx, fy = segment->y0 - cy;
+    float gx = segment->x1 - cx, gy = segment->y1 - cy;
+    float r2 = radius * radius;
+    int inside0 = fx * fx + fy * fy <= r2;
+    int inside1 = gx * gx + gy * gy <= r2;
+    if (inside0 && inside1) return 1;  // Common case: no arithmetic on the endpoints
+
+    float dx = segment->x1 - segment->x0;
+    float dy = segment->y1 - segment->y0;
+    float a = dx * dx + dy * dy;
+    if (a == 0.0f) return inside0;
+
+    // |f + t d|^2 = r^2  ->  a t^2 + b t + c = 0
+    float b = 2.0f * (fx * dx + fy * dy);
+    float c = fx * fx + fy * fy - r2;
+    float disc = b * b - 4.0f * a * c;
+    if (disc < 0.0f) return 0;
+
+    float root = sqrtf(disc);
+    float t0 = (-b - root) / (2.0f * a);
+    float t1 = (-b + root) / (2.0f * a);
+    if (t1 < 0.0f || t0 > 1.0f) return 0;
+
+    // Move only the endpoints that are outside
+    // (depth is affine in screen space, so it moves with the same parameter)
+    float x0 = segment->x0, y0 = segment->y0, z0 = segment->z0;
+    float dz = segment->z1 - segment->z0;
+    int trimmed = 1;
+    if (!inside0 && t0 > 0.0f) {
+        segment->x0 = x0 + t0 * dx;
+        segment->y0 = y0 + t0 * dy;
+        segment->z0 = z0 + t0 * dz;
+        trimmed = 2;
+    }
+    if (!inside1 && t1 < 1.0f) {
+        segment->x1 = x0 + t1 * dx;
+        segment->y1 = y0 + t1 * dy;
+        segment->z1 = z0 + t1 * dz;
+        trimmed = 2;
+    }
+    return trimmed;
+}
@@ -0,0 +1,32 @@
+#include "cpu.h"
+
+static unsigned int detected_features;
+static int detected = 0;
+static unsigned int feature_mask = ~0u;
+
+static unsigned int detect_features(void) {
+    unsigned int features = 0;
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) features |= CPU_FEATURE_SSE2;
+    if (__builtin_cpu_supports("sse4.1")) features |= CPU_FEATURE_SSE41;
+    if (__builtin_cpu_supports("avx2")) features |= CPU_FEATURE_AVX2;
+    if (__builtin_cpu_supports("fma")) features |= CPU_FEATURE_FMA;
+#endif
+    return features;
+}
+
+unsigned int cpu_features(void) {
+    // Racing first calls may each detect (the result is the same); the release
+    // store publishes detected_features before any reader sees the flag
+    if (!__atomic_load_n(&detected, __ATOMIC_ACQUIRE)) {
+        __atomic_store_n(&detected_features, detect_features(), __ATOMIC_RELAXED);
+        __atomic_store_n(&detected, 1, __ATOMIC_RELEASE);
+    }
+    return __atomic_load_n(&detected_features, __ATOMIC_RELAXED) &
+           __atomic_load_n(&feature_mask, __ATOMIC_RELAXED);
+}
+
+void cpu_set_feature_mask(unsigned int mask) {
+    __atomic_store_n(&feature_mask, mask, __ATOMIC_RELAXED);
+}
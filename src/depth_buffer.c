@@ -0,0 +1,97 @@
+#include <stdlib.h>
+#include <string.h>
+#include "depth_buffer.h"
+
+depth_buffer_t* depth_buffer_create(int width, int height, depth_format_t format) {
+    if (width <= 0 || height <= 0) return NULL;
+    depth_buffer_t* depth = calloc(1, sizeof(depth_buffer_t));
+    if (!depth) return NULL;
+
+    size_t element = format == DEPTH_FORMAT_UNORM16 ? sizeof(uint16_t) : sizeof(float);
+    depth->width = width;
+    depth->height = height;
+    depth->format = format;
+    depth->tiles_x = (width + DEPTH_TILE_SIZE - 1) / DEPTH_TILE_SIZE;
+    depth->tiles_y = (height + DEPTH_TILE_SIZE - 1) / DEPTH_TILE_SIZE;
+    depth->data = malloc(element * width * height);
+    depth->tile_ready = calloc((size_t)depth->tiles_x * depth->tiles_y, 1);
+    if (!depth->data || !depth->tile_ready) {
+        depth_buffer_destroy(depth);
+        return NULL;
+    }
+    return depth;
+}
+
+void depth_buffer_destroy(depth_buffer_t* depth) {
+    if (depth) {
+        free(depth->data);
+        free(depth->tile_ready);
+        free(depth);
+    }
+}
+
+void depth_buffer_clear(depth_buffer_t* depth) {
+    if (!depth) return;
+    memset(depth->tile_ready, 0, (size_t)depth->tiles_x * depth->tiles_y);
+    depth->tests = 0;
+    depth->passes = 0;
+}
+
+void depth_buffer_prepare_tile(depth_buffer_t* depth, int tile) {
+    int x0 = (tile % depth->tiles_x) * DEPTH_TILE_SIZE;
+    int y0 = (tile / depth->tiles_x) * DEPTH_TILE_SIZE;
+    int x1 = x0 + DEPTH_TILE_SIZE < depth->width ? x0 + DEPTH_TILE_SIZE : depth->width;
+    int y1 = y0 + DEPTH_TILE_SIZE < depth->height ? y0 + DEPTH_TILE_SIZE : depth->height;
+
+    for (int y = y0; y < y1; y++) {
+        size_t row = (size_t)y * depth->width;
+        if (depth->format == DEPTH_FORMAT_UNORM16) {
+            uint16_t* d = (uint16_t*)depth->data + row;
+            for (int x = x0; x < x1; x++) d[x] = UINT16_MAX;
+        } else {
+            float* d = (float*)depth->data + row;
+            for (int x = x0; x < x1; x++) d[x] = 1.0f;
+        }
+    }
+    depth->tile_ready[tile] = 1;
+}
+
+float depth_buffer_read(const depth_buffer_t* depth, int x, int y) {
+    int tile = (y / DEPTH_TILE_SIZE) * depth->tiles_x + x / DEPTH_TILE_SIZE;
+    if (!depth->tile_ready[tile]) return 1.0f;
+
+    size_t i = (size_t)y * depth->width + x;
+    if (depth->format == DEPTH_FORMAT_UNORM16) {
+        return ((const uint16_t*)depth->data)[i] / 65535.0f * 2.0f - 1.0f;
+    }
+    return ((const float*)depth->data)[i];
+}
+
+void depth_buffer_stats(const depth_buffer_t* depth, depth_stats_t* stats) {
+    memset(stats, 0, sizeof(depth_stats_t));
+    if (!depth) return;
+    stats->tests = depth->tests;
+    stats->passes = depth->passes;
+
+    // Only ready tiles can hold anything nearer than the far plane
+    for (int tile = 0; tile < depth->tiles_x * depth->tiles_y; tile++) {
+        if (!depth->tile_ready[tile]) continue;
+        int x0 = (tile % depth->tiles_x) * DEPTH_TILE_SIZE;
+        int y0 = (tile / depth->tiles_x) * DEPTH_TILE_SIZE;
+        int x1 = x0 + DEPTH_TILE_SIZE < depth->width ? x0 + DEPTH_TILE_SIZE : depth->width;
+        int y1 = y0 + DEPTH_TILE_SIZE < depth->height ? y0 + DEPTH_TILE_SIZE : depth->height;
+        for (int y = y0; y < y1; y++) {
+            size_t row = (size_t)y * depth->width;
+            for (int x = x0; x < x1; x++) {
+                if (depth->format == DEPTH_FORMAT_UNORM16) {
+                    stats->covered += ((const uint16_t*)depth->data)[row + x] != UINT16_MAX;
+                } else {
+                    stats->covered += ((const float*)depth->data)[row + x] < 1.0f;
+                }
+            }
+        }
+    }
+
+    if (stats->tests) stats->pass_rate = (float)((double)stats->passes / stats->tests);
+    if (stats->covered) stats->overdraw = (float)((double)stats->passes / stats->covered);
+}
@@ -0,0 +1,84 @@
+#include <string.h>
+#include "depth_sort.h"
+
+// 11-bit digits: three passes cover a 32-bit key
+#define RADIX_BITS 11
+#define RADIX_SIZE (1 << RADIX_BITS)
+#define RADIX_MASK (RADIX_SIZE - 1)
+#define RADIX_PASSES 3
+
+int* depth_sort_radix(arena_t* arena, const float* depths, int count) {
+    uint32_t* keys = arena_alloc(arena, sizeof(uint32_t) * 2 * (size_t)(count ? count : 1));
+    int* order = arena_alloc(arena, sizeof(int) * 2 * (size_t)(count ? count : 1));
+    uint32_t* histograms = arena_alloc(arena, sizeof(uint32_t) * RADIX_SIZE * RADIX_PASSES);
+    if (!keys || !order || !histograms) return NULL;
+
+    uint32_t* keys_alt = keys + count;
+    int* order_alt = order + count;
+
+    // Invert keys so an ascending sort yields far-to-near order, and build all
+    // digit histograms in the same pass
+    memset(histograms, 0, sizeof(uint32_t) * RADIX_SIZE * RADIX_PASSES);
+    for (int i = 0; i < count; i++) {
+        uint32_t key = ~depth_sort_key(depths[i]);
+        keys[i] = key;
+        order[i] = i;
+        for (int pass = 0; pass < RADIX_PASSES; pass++) {
+            histograms[pass * RADIX_SIZE + ((key >> (pass * RADIX_BITS)) & RADIX_MASK)]++;
+        }
+    }
+
+    for (int pass = 0; pass < RADIX_PASSES; pass++) {
+        uint32_t* hist = histograms + pass * RADIX_SIZE;
+        int shift = pass * RADIX_BITS;
+
+        // Every key shares this digit: the pass would be the identity, skip it
+        if (count == 0 || hist[(keys[0] >> shift) & RADIX_MASK] == (uint32_t)count) continue;
+
+        // Exclusive prefix sum turns counts into output offsets
+        uint32_t offset = 0;
+        for (int d = 0; d < RADIX_SIZE; d++) {
+            uint32_t n = hist[d];
+            hist[d] = offset;
+            offset += n;
+        }
+
+        for (int i = 0; i < count; i++) {
+            uint32_t dst = hist[(keys[i] >> shift) & RADIX_MASK]++;
+            keys_alt[dst] = keys[i];
+            order_alt[dst] = order[i];
+        }
+
+        uint32_t* tmp_keys = keys; keys = keys_alt; keys_alt = tmp_keys;
+        int* tmp_order = order; order = order_alt; order_alt = tmp_order;
+    }
+
+    return order;
+}
+
+// Stable insertion sort for short lists, same ordering as the radix path
+static int* depth_sort_insertion(arena_t* arena, const float* depths, int count) {
+    uint32_t* keys = arena_alloc(arena, sizeof(uint32_t) * (size_t)(count ? count : 1));
+    int* order = arena_alloc(arena, sizeof(int) * (size_t)(count ? count : 1));
+    if (!keys || !order) return NULL;
+
+    for (int i = 0; i < count; i++) {
+        uint32_t key = ~depth_sort_key(depths[i]);
+        int j = i;
+        while (j > 0 && keys[j - 1] > key) {
+            keys[j] = keys[j - 1];
+            order[j] = order[j - 1];
+            j--;
+        }
+        keys[j] = key;
+        order[j] = i;
+    }
+    return order;
+}
+
+int* depth_sort_back_to_front(arena_t* arena, const float* depths, int count) {
+    if (count < DEPTH_SORT_RADIX_THRESHOLD) {
+        return depth_sort_insertion(arena, depths, count);
+    }
+    return depth_sort_radix(arena, depths, count);
+}
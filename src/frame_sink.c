@@ -0,0 +1,237 @@
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "frame_sink.h"
+
+#define RING_HEADER_SIZE 64  // Keeps slot 0 cache-line aligned
+
+struct frame_sink {
+    int width;
+    int height;
+    size_t frame_bytes;
+    unsigned long frames;
+    int error;
+
+    // Stream output
+    frame_sink_format_t format;
+    FILE* fp;
+    int owns_fp;
+    unsigned char* buffers;    // FRAME_SINK_QUEUE_DEPTH quantized frames
+    int head;                  // Oldest queued buffer
+    int count;                 // Buffers waiting for the writer
+    int shutting_down;
+    pthread_t writer;
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+
+    // Ring output
+    unsigned char* map;
+    size_t map_bytes;
+};
+
+static void quantize_frame(const canvas_t* canvas, unsigned char* dst) {
+    for (int y = 0; y < canvas->height; y++) {
+        canvas_quantize_row_u8(canvas, y, dst + (size_t)y * canvas->width);
+    }
+}
+
+// Writer thread: drains the queue in order, one fwrite per frame
+static void* writer_main(void* arg) {
+    frame_sink_t* sink = arg;
+
+    pthread_mutex_lock(&sink->lock);
+    for (;;) {
+        while (sink->count == 0 && !sink->shutting_down) {
+            pthread_cond_wait(&sink->not_empty, &sink->lock);
+        }
+        if (sink->count == 0) break;  // Shutting down with nothing left
+        unsigned char* frame = sink->buffers + (size_t)sink->head * sink->frame_bytes;
+        pthread_mutex_unlock(&sink->lock);
+
+        int ok = 1;
+        if (sink->format == FRAME_SINK_Y4M && fputs("FRAME\n", sink->fp) == EOF) ok = 0;
+        if (ok && fwrite(frame, 1, sink->frame_bytes, sink->fp) != sink->frame_bytes) ok = 0;
+
+        pthread_mutex_lock(&sink->lock);
+        if (!ok) sink->error = 1;
+        sink->head = (sink->head + 1) % FRAME_SINK_QUEUE_DEPTH;
+        sink->count--;
+        pthread_cond_signal(&sink->not_full);
+    }
+    pthread_mutex_unlock(&sink->lock);
+    return NULL;
+}
+
+static frame_sink_t* sink_alloc(int width, int height) {
+    if (width <= 0 || height <= 0) return NULL;
+    frame_sink_t* sink = calloc(1, sizeof(frame_sink_t));
+    if (!sink) return NULL;
+    sink->width = width;
+    sink->height = height;
+    sink->frame_bytes = (size_t)width * height;
+    return sink;
+}
+
+frame_sink_t* frame_sink_open_stream(FILE* fp, frame_sink_format_t format,
+                                     int width, int height, int fps) {
+    if (!fp) return NULL;
+    frame_sink_t* sink = sink_alloc(width, height);
+    if (!sink) return NULL;
+    sink->format = format;
+    sink->fp = fp;
+
+    sink->buffers = malloc(sink->frame_bytes * FRAME_SINK_QUEUE_DEPTH);
+    if (!sink->buffers) {
+        free(sink);
+        return NULL;
+    }
+
+    if (format == FRAME_SINK_Y4M) {
+        if (fps <= 0) fps = 30;
+        fprintf(fp, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 Cmono\n", width, height, fps);
+    }
+
+    pthread_mutex_init(&sink->lock, NULL);
+    pthread_cond_init(&sink->not_empty, NULL);
+    pthread_cond_init(&sink->not_full, NULL);
+    if (pthread_create(&sink->writer, NULL, writer_main, sink) != 0) {
+        pthread_cond_destroy(&sink->not_full);
+        pthread_cond_destroy(&sink->not_empty);
+        pthread_mutex_destroy(&sink->lock);
+        free(sink->buffers);
+        free(sink);
+        return NULL;
+    }
+    return sink;
+}
+
+frame_sink_t* frame_sink_open(const char* path, frame_sink_format_t format,
+                              int width, int height, int fps) {
+    if (!path) return NULL;
+    int to_stdout = strcmp(path, "-") == 0;
+    FILE* fp = to_stdout ? stdout : fopen(path, "wb");
+    if (!fp) return NULL;
+
+    frame_sink_t* sink = frame_sink_open_stream(fp, format, width, height, fps);
+    if (!sink) {
+        if (!to_stdout) fclose(fp);
+        return NULL;
+    }
+    sink->owns_fp = !to_stdout;
+    return sink;
+}
+
+frame_sink_t* frame_sink_open_ring(const char* path, int width, int height, int slots) {
+#ifdef _WIN32
+    (void)path; (void)width; (void)height; (void)slots;
+    return NULL;  // Not supported without mmap
+#else
+    if (!path || slots <= 0) return NULL;
+    frame_sink_t* sink = sink_alloc(width, height);
+    if (!sink) return NULL;
+
+    sink->map_bytes = RING_HEADER_SIZE + sink->frame_bytes * (size_t)slots;
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, (off_t)sink->map_bytes) != 0) {
+        if (fd >= 0) close(fd);
+        free(sink);
+        return NULL;
+    }
+    void* map = mmap(NULL, sink->map_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the file alive
+    if (map == MAP_FAILED) {
+        free(sink);
+        return NULL;
+    }
+    sink->map = map;
+
+    frame_ring_header_t* header = map;
+    memcpy(header->magic, "T3DRING1", 8);
+    header->width = (uint32_t)width;
+    header->height = (uint32_t)height;
+    header->slots = (uint32_t)slots;
+    header->header_size = RING_HEADER_SIZE;
+    header->frames_written = 0;
+    return sink;
+#endif
+}
+
+int frame_sink_submit(frame_sink_t* sink, const canvas_t* canvas) {
+    if (!sink || !canvas || canvas->width != sink->width || canvas->height != sink->height) {
+        return -1;
+    }
+
+#ifndef _WIN32
+    // Ring: quantize straight into the mapped slot, then publish it
+    if (sink->map) {
+        frame_ring_header_t* header = (frame_ring_header_t*)sink->map;
+        size_t slot = sink->frames % header->slots;
+        quantize_frame(canvas, sink->map + RING_HEADER_SIZE + slot * sink->frame_bytes);
+        sink->frames++;
+        __atomic_store_n(&header->frames_written, (uint64_t)sink->frames, __ATOMIC_RELEASE);
+        return 0;
+    }
+#endif
+
+    // Stream: wait for a free buffer; the writer never touches unqueued buffers
+    pthread_mutex_lock(&sink->lock);
+    while (sink->count == FRAME_SINK_QUEUE_DEPTH) {
+        pthread_cond_wait(&sink->not_full, &sink->lock);
+    }
+    int error = sink->error;
+    int slot = (sink->head + sink->count) % FRAME_SINK_QUEUE_DEPTH;
+    pthread_mutex_unlock(&sink->lock);
+    if (error) return -1;
+
+    quantize_frame(canvas, sink->buffers + (size_t)slot * sink->frame_bytes);
+
+    pthread_mutex_lock(&sink->lock);
+    sink->count++;
+    sink->frames++;
+    pthread_cond_signal(&sink->not_empty);
+    pthread_mutex_unlock(&sink->lock);
+    return 0;
+}
+
+unsigned long frame_sink_frames(const frame_sink_t* sink) {
+    return sink ? sink->frames : 0;
+}
+
+int frame_sink_close(frame_sink_t* sink) {
+    if (!sink) return -1;
+    int status = 0;
+
+#ifndef _WIN32
+    if (sink->map) {
+        if (munmap(sink->map, sink->map_bytes) != 0) status = -1;
+        free(sink);
+        return status;
+    }
+#endif
+
+    pthread_mutex_lock(&sink->lock);
+    sink->shutting_down = 1;
+    pthread_cond_signal(&sink->not_empty);
+    pthread_mutex_unlock(&sink->lock);
+    pthread_join(sink->writer, NULL);
+
+    if (sink->error) status = -1;
+    if (sink->owns_fp) {
+        if (fclose(sink->fp) != 0) status = -1;
+    } else if (fflush(sink->fp) != 0) {
+        status = -1;
+    }
+
+    pthread_cond_destroy(&sink->not_full);
+    pthread_cond_destroy(&sink->not_empty);
+    pthread_mutex_destroy(&sink->lock);
+    free(sink->buffers);
+    free(sink);
+    return status;
+}
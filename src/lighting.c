@@ -1,28 +1,184 @@
+#include <stdlib.h>
+#include <string.h>
 #include "lighting.h"
 #include "math3d.h"
+#include "cpu.h"
+#include "profile.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define LIGHTING_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+// Edges are deinterleaved into stack blocks of this size
+#define LIGHTING_BLOCK 256
 
 // Calculate edge intensity using Lambert's cosine law
-float calculate_lambert_intensity(vec3_t edge_dir, vec3_t light_dir) {
-    vec3_t norm_edge = vec3_normalize_fast(edge_dir);
-    vec3_t norm_light = vec3_normalize_fast(light_dir);
-    float dot_product = vec3_dot(norm_edge, norm_light);
+float calculate_lambert_intensity(vec3f_t edge_dir, vec3f_t light_dir) {
+    vec3f_t norm_edge = vec3f_normalize(edge_dir);
+    vec3f_t norm_light = vec3f_normalize(light_dir);
+    float dot_product = vec3f_dot(norm_edge, norm_light);
     return fmaxf(0.0f, dot_product);
 }
 
+void light_set_init(light_set_t* set) {
+    memset(set, 0, sizeof(light_set_t));
+    set->all_positive = 1;
+}
+
+void light_set_destroy(light_set_t* set) {
+    free(set->x);
+    light_set_init(set);
+}
+
+int light_set_prepare(light_set_t* set, const light_t* lights, int num_lights, float threshold) {
+    if (num_lights > set->capacity) {
+        // One block for the four arrays
+        float* block = malloc(sizeof(float) * 4 * num_lights);
+        if (!block) return -1;
+        free(set->x);
+        set->x = block;
+        set->y = block + num_lights;
+        set->z = block + 2 * num_lights;
+        set->intensity = block + 3 * num_lights;
+        set->capacity = num_lights;
+    }
+
+    // Order is kept, so sums match the per-pair reference exactly
+    set->count = 0;
+    set->all_positive = 1;
+    for (int j = 0; j < num_lights; j++) {
+        if (!(fabsf(lights[j].intensity) > threshold)) continue;
+        vec3f_t dir = vec3f_normalize(lights[j].direction);
+        set->x[set->count] = dir.x;
+        set->y[set->count] = dir.y;
+        set->z[set->count] = dir.z;
+        set->intensity[set->count] = lights[j].intensity;
+        if (lights[j].intensity < 0.0f) set->all_positive = 0;
+        set->count++;
+    }
+    set->culled = num_lights - set->count;
+    return 0;
+}
+
+// Scalar kernel: the same operations, in the same order, as the SIMD kernel
+static void evaluate_scalar(const light_set_t* set,
+                            const float* dx, const float* dy, const float* dz, int count,
+                            float* out) {
+    for (int i = 0; i < count; i++) {
+        vec3f_t e = vec3f_normalize(vec3f_make(dx[i], dy[i], dz[i]));
+        float total = 0.0f;
+        for (int j = 0; j < set->count; j++) {
+            float d = e.x * set->x[j] + e.y * set->y[j] + e.z * set->z[j];
+            total += fmaxf(0.0f, d) * set->intensity[j];
+        }
+        out[i] = fminf(total, 1.0f);
+    }
+}
+
+#ifdef LIGHTING_HAVE_X86
+// AVX2 kernel: 8 edges per block against every light. No FMA, so results
+// equal the scalar kernel bit for bit.
+__attribute__((target("avx2")))
+static int evaluate_avx2(const light_set_t* set,
+                         const float* dx, const float* dy, const float* dz, int count,
+                         float* out) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 tiny = _mm256_set1_ps(1e-16f);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 ex = _mm256_loadu_ps(dx + i);
+        __m256 ey = _mm256_loadu_ps(dy + i);
+        __m256 ez = _mm256_loadu_ps(dz + i);
+
+        // Normalize, leaving degenerate directions untouched like vec3f_normalize
+        __m256 len_sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ex, ex), _mm256_mul_ps(ey, ey)),
+                                      _mm256_mul_ps(ez, ez));
+        __m256 inv = _mm256_div_ps(one, _mm256_sqrt_ps(len_sq));
+        inv = _mm256_blendv_ps(inv, one, _mm256_cmp_ps(len_sq, tiny, _CMP_LT_OQ));
+        ex = _mm256_mul_ps(ex, inv);
+        ey = _mm256_mul_ps(ey, inv);
+        ez = _mm256_mul_ps(ez, inv);
+
+        __m256 total = zero;
+        for (int j = 0; j < set->count; j++) {
+            __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ex, _mm256_set1_ps(set->x[j])),
+                                                   _mm256_mul_ps(ey, _mm256_set1_ps(set->y[j]))),
+                                     _mm256_mul_ps(ez, _mm256_set1_ps(set->z[j])));
+            total = _mm256_add_ps(total, _mm256_mul_ps(_mm256_max_ps(d, zero),
+                                                       _mm256_set1_ps(set->intensity[j])));
+
+            // With no negative lights the clamped result cannot change once
+            // every lane has saturated
+            if (set->all_positive && (j & 3) == 3 &&
+                _mm256_movemask_ps(_mm256_cmp_ps(total, one, _CMP_GE_OQ)) == 0xff) break;
+        }
+        _mm256_storeu_ps(out + i, _mm256_min_ps(total, one));
+    }
+    return i;
+}
+#endif
+
+void lighting_evaluate_soa(const light_set_t* set,
+                           const float* dx, const float* dy, const float* dz, int count,
+                           float* out) {
+    int done = 0;
+#ifdef LIGHTING_HAVE_X86
+    if (cpu_features() & CPU_FEATURE_AVX2) {
+        done = evaluate_avx2(set, dx, dy, dz, count, out);
+    }
+#endif
+    evaluate_scalar(set, dx + done, dy + done, dz + done, count - done, out + done);
+}
+
+void lighting_evaluate_indexed(const light_set_t* set, const indexed_mesh_t* mesh, float* out) {
+    profile_t* profile = profile_bound();
+    profile_mark_t mark = profile_mark(profile);
+    float bx[LIGHTING_BLOCK], by[LIGHTING_BLOCK], bz[LIGHTING_BLOCK];
+    for (int start = 0; start < mesh->num_edges; start += LIGHTING_BLOCK) {
+        int n = mesh->num_edges - start < LIGHTING_BLOCK ? mesh->num_edges - start : LIGHTING_BLOCK;
+        for (int i = 0; i < n; i++) {
+            const int* edge = mesh->indices + 2 * (start + i);
+            vec3f_t d = vec3f_sub(mesh->vertices[edge[1]], mesh->vertices[edge[0]]);
+            bx[i] = d.x;
+            by[i] = d.y;
+            bz[i] = d.z;
+        }
+        lighting_evaluate_soa(set, bx, by, bz, n, out + start);
+    }
+    if (profile) {
+        profile->frame.edges_lit += mesh->num_edges;
+        profile_record(profile, PROFILE_LIGHTING, mark);
+    }
+}
+
 // Apply lighting to wireframe edges
 void apply_lighting(mesh_t* mesh, light_t lights[], int num_lights) {
-    for(int i = 0; i < mesh->num_edges; i++) {
-        vec3_t edge_vector = vec3_sub(mesh->edges[i].v1, mesh->edges[i].v0);
-        float total_intensity = 0.0f;
-        
-        // Accumulate light contributions
-        for(int j = 0; j < num_lights; j++) {
-            total_intensity += calculate_lambert_intensity(edge_vector, 
-                                                         lights[j].direction) 
-                             * lights[j].intensity;
+    profile_t* profile = profile_bound();
+    profile_mark_t mark = profile_mark(profile);
+    light_set_t set;
+    light_set_init(&set);
+    if (light_set_prepare(&set, lights, num_lights, 0.0f) != 0) return;
+
+    float bx[LIGHTING_BLOCK], by[LIGHTING_BLOCK], bz[LIGHTING_BLOCK], lit[LIGHTING_BLOCK];
+    for (int start = 0; start < mesh->num_edges; start += LIGHTING_BLOCK) {
+        int n = mesh->num_edges - start < LIGHTING_BLOCK ? mesh->num_edges - start : LIGHTING_BLOCK;
+        for (int i = 0; i < n; i++) {
+            const edge_t* edge = &mesh->edges[start + i];
+            bx[i] = edge->v1.x - edge->v0.x;
+            by[i] = edge->v1.y - edge->v0.y;
+            bz[i] = edge->v1.z - edge->v0.z;
         }
-        
+        lighting_evaluate_soa(&set, bx, by, bz, n, lit);
+
         // Store intensity for rendering
-        mesh->edges[i].intensity = fminf(total_intensity, 1.0f);
+        for (int i = 0; i < n; i++) mesh->edges[start + i].intensity = lit[i];
+    }
+    light_set_destroy(&set);
+    if (profile) {
+        profile->frame.edges_lit += mesh->num_edges;
+        profile_record(profile, PROFILE_LIGHTING, mark);
     }
 }
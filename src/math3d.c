@@ -1,4 +1,16 @@
 #include "math3d.h"
+#include "cpu.h"
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MATH3D_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+// SSE2 is part of the x86-64 baseline, so single multiplies use it without dispatch
+#if defined(MATH3D_HAVE_X86) && defined(__SSE2__)
+#define MATH3D_HAVE_SSE 1
+#endif
 
 // Helper functions
 static void vec3_update_spherical(vec3_t* v) {
@@ -49,6 +61,33 @@ vec3_t vec3_slerp(const vec3_t* a, const vec3_t* b, float t) {
     return result;
 }
 
+// Compact vector conversions
+vec3f_t vec3f_from_vec3(const vec3_t* v) {
+    return (vec3f_t){ v->x, v->y, v->z };
+}
+
+vec3_t vec3_from_vec3f(vec3f_t v) {
+    vec3_t result = {.x = v.x, .y = v.y, .z = v.z};
+    vec3_update_spherical(&result);
+    return result;
+}
+
+vec3f_t vec3f_from_spherical(float r, float theta, float phi) {
+    float sin_phi = sinf(phi);
+    return (vec3f_t){
+        r * sin_phi * cosf(theta),
+        r * sin_phi * sinf(theta),
+        r * cosf(phi)
+    };
+}
+
+void vec3f_to_spherical(vec3f_t v, float* r, float* theta, float* phi) {
+    float len = vec3f_length(v);
+    if (r) *r = len;
+    if (theta) *theta = atan2f(v.y, v.x);
+    if (phi) *phi = acosf(v.z / (len + 1e-8f)); // Avoid division by zero
+}
+
 // Matrix implementations
 void mat4_identity(mat4_t* m) {
     float identity[] = {
@@ -80,38 +119,39 @@ void mat4_scale(mat4_t* m, float sx, float sy, float sz) {
     memcpy(m->m, scale, sizeof(scale));
 }
 
-void mat4_rotate_xyz(mat4_t* m, float rx, float ry, float rz) {
+// Upper 3x3 of X(rx) * Y(ry) * Z(rz), written directly in column-major order
+static void rotation_xyz(float r[9], float rx, float ry, float rz) {
     float cx = cosf(rx), sx = sinf(rx);
     float cy = cosf(ry), sy = sinf(ry);
     float cz = cosf(rz), sz = sinf(rz);
 
-    mat4_t x_rot = {{
-        1,0,0,0,
-        0,cx,-sx,0,
-        0,sx,cx,0,
-        0,0,0,1
-    }};
-
-    mat4_t y_rot = {{
-        cy,0,sy,0,
-        0,1,0,0,
-        -sy,0,cy,0,
-        0,0,0,1
-    }};
+    r[0] = cy*cz;             r[3] = cy*sz;             r[6] = -sy;
+    r[1] = sx*sy*cz - cx*sz;  r[4] = sx*sy*sz + cx*cz;  r[7] = sx*cy;
+    r[2] = cx*sy*cz + sx*sz;  r[5] = cx*sy*sz - sx*cz;  r[8] = cx*cy;
+}
 
-    mat4_t z_rot = {{
-        cz,-sz,0,0,
-        sz,cz,0,0,
-        0,0,1,0,
-        0,0,0,1
-    }};
+void mat4_rotate_xyz(mat4_t* m, float rx, float ry, float rz) {
+    mat4_trs(m, vec3f_make(0.0f, 0.0f, 0.0f), vec3f_make(rx, ry, rz), vec3f_make(1.0f, 1.0f, 1.0f));
+}
 
-    mat4_t temp;
-    mat4_multiply(&temp, &x_rot, &y_rot);
-    mat4_multiply(m, &temp, &z_rot);
+void mat4_trs(mat4_t* m, vec3f_t translation, vec3f_t rotation, vec3f_t scale) {
+    float r[9];
+    rotation_xyz(r, rotation.x, rotation.y, rotation.z);
+    const float s[3] = { scale.x, scale.y, scale.z };
+    for (int c = 0; c < 3; c++) {
+        m->m[c*4 + 0] = r[c*3 + 0] * s[c];
+        m->m[c*4 + 1] = r[c*3 + 1] * s[c];
+        m->m[c*4 + 2] = r[c*3 + 2] * s[c];
+        m->m[c*4 + 3] = 0.0f;
+    }
+    m->m[12] = translation.x;
+    m->m[13] = translation.y;
+    m->m[14] = translation.z;
+    m->m[15] = 1.0f;
 }
 
 void mat4_frustum_asymmetric(mat4_t* m, float l, float r, float b, float t, float n, float f) {
+    memset(m->m, 0, sizeof(m->m));
     m->m[0] = (2*n)/(r-l);
     m->m[5] = (2*n)/(t-b);
     m->m[8] = (r+l)/(r-l);
@@ -122,15 +162,159 @@ void mat4_frustum_asymmetric(mat4_t* m, float l, float r, float b, float t, floa
     m->m[15] = 0;
 }
 
-void mat4_multiply(mat4_t* result, const mat4_t* a, const mat4_t* b) {
-    float temp[16];
+#ifndef MATH3D_HAVE_SSE
+// Scalar reference
+static void mat4_multiply_scalar(float out[16], const float* a, const float* b) {
     for(int i = 0; i < 4; ++i) {
         for(int j = 0; j < 4; ++j) {
-            temp[j*4+i] = 0.0f;
+            float sum = 0.0f;
             for(int k = 0; k < 4; ++k) {
-                temp[j*4+i] += a->m[k*4+i] * b->m[j*4+k];
+                sum += a[k*4+i] * b[j*4+k];
             }
+            out[j*4+i] = sum;
         }
     }
+}
+#endif
+
+// Column j of a*b is a linear combination of a's columns weighted by b's column j.
+// Every output column is computed before any is stored, so result may alias a or b.
+void mat4_multiply(mat4_t* result, const mat4_t* a, const mat4_t* b) {
+#ifdef MATH3D_HAVE_SSE
+    __m128 a0 = _mm_loadu_ps(a->m), a1 = _mm_loadu_ps(a->m + 4);
+    __m128 a2 = _mm_loadu_ps(a->m + 8), a3 = _mm_loadu_ps(a->m + 12);
+    __m128 col[4];
+    for (int j = 0; j < 4; j++) {
+        const float* bj = b->m + j*4;
+        col[j] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(bj[0])),
+                                                  _mm_mul_ps(a1, _mm_set1_ps(bj[1]))),
+                                       _mm_mul_ps(a2, _mm_set1_ps(bj[2]))),
+                            _mm_mul_ps(a3, _mm_set1_ps(bj[3])));
+    }
+    for (int j = 0; j < 4; j++) _mm_storeu_ps(result->m + j*4, col[j]);
+#else
+    float temp[16];
+    mat4_multiply_scalar(temp, a->m, b->m);
     memcpy(result->m, temp, sizeof(temp));
+#endif
+}
+
+#ifdef MATH3D_HAVE_X86
+// AVX2: two output columns per 256-bit register, a's columns duplicated in both lanes
+__attribute__((target("avx2,fma")))
+static void mat4_multiply_batch_avx2(mat4_t* results, const mat4_t* a, const mat4_t* b, int count) {
+    __m256 a0 = _mm256_broadcast_ps((const __m128*)(a->m));
+    __m256 a1 = _mm256_broadcast_ps((const __m128*)(a->m + 4));
+    __m256 a2 = _mm256_broadcast_ps((const __m128*)(a->m + 8));
+    __m256 a3 = _mm256_broadcast_ps((const __m128*)(a->m + 12));
+
+    for (int i = 0; i < count; i++) {
+        __m256 b01 = _mm256_loadu_ps(b[i].m);
+        __m256 b23 = _mm256_loadu_ps(b[i].m + 8);
+        __m256 c01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, 0x00));
+        __m256 c23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, 0x00));
+        c01 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b01, 0x55), c01);
+        c23 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b23, 0x55), c23);
+        c01 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b01, 0xaa), c01);
+        c23 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b23, 0xaa), c23);
+        c01 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b01, 0xff), c01);
+        c23 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b23, 0xff), c23);
+        _mm256_storeu_ps(results[i].m, c01);
+        _mm256_storeu_ps(results[i].m + 8, c23);
+    }
+}
+#endif
+
+void mat4_multiply_batch(mat4_t* results, const mat4_t* a, const mat4_t* b, int count) {
+    mat4_t shared = *a;  // results may overlap a
+#ifdef MATH3D_HAVE_X86
+    unsigned int features = cpu_features();
+    if ((features & CPU_FEATURE_AVX2) && (features & CPU_FEATURE_FMA)) {
+        mat4_multiply_batch_avx2(results, &shared, b, count);
+        return;
+    }
+#endif
+    for (int i = 0; i < count; i++) mat4_multiply(&results[i], &shared, &b[i]);
+}
+
+// In-place composition: m = m * x
+void mat4_compose(mat4_t* m, const mat4_t* x) {
+    mat4_multiply(m, m, x);
+}
+
+// Only the translation column changes: col3 += tx*col0 + ty*col1 + tz*col2
+void mat4_compose_translate(mat4_t* m, float tx, float ty, float tz) {
+    float* a = m->m;
+    for (int r = 0; r < 4; r++) {
+        a[12 + r] += a[r]*tx + a[4 + r]*ty + a[8 + r]*tz;
+    }
+}
+
+// Scaling multiplies the first three columns
+void mat4_compose_scale(mat4_t* m, float sx, float sy, float sz) {
+    for (int r = 0; r < 4; r++) {
+        m->m[r] *= sx;
+        m->m[4 + r] *= sy;
+        m->m[8 + r] *= sz;
+    }
+}
+
+void mat4_compose_rotate_xyz(mat4_t* m, float rx, float ry, float rz) {
+    mat4_t rotation;
+    mat4_rotate_xyz(&rotation, rx, ry, rz);
+    mat4_multiply(m, m, &rotation);
+}
+
+// Inverse of [A t; 0 1] is [A^-1, -A^-1 t; 0 1], with A^-1 from the adjugate
+int mat4_inverse_affine(mat4_t* result, const mat4_t* m) {
+    const float* a = m->m;
+    float c00 = a[5]*a[10] - a[9]*a[6];
+    float c01 = a[9]*a[2]  - a[1]*a[10];
+    float c02 = a[1]*a[6]  - a[5]*a[2];
+    float det = a[0]*c00 + a[4]*c01 + a[8]*c02;
+    if (fabsf(det) < 1e-12f) return -1;
+    float inv_det = 1.0f / det;
+
+    float inv[9] = {
+        c00 * inv_det,
+        c01 * inv_det,
+        c02 * inv_det,
+        (a[8]*a[6]  - a[4]*a[10]) * inv_det,
+        (a[0]*a[10] - a[8]*a[2])  * inv_det,
+        (a[4]*a[2]  - a[0]*a[6])  * inv_det,
+        (a[4]*a[9]  - a[8]*a[5])  * inv_det,
+        (a[8]*a[1]  - a[0]*a[9])  * inv_det,
+        (a[0]*a[5]  - a[4]*a[1])  * inv_det
+    };
+    float tx = a[12], ty = a[13], tz = a[14];
+
+    float* o = result->m;
+    for (int c = 0; c < 3; c++) {
+        o[c*4 + 0] = inv[c*3 + 0];
+        o[c*4 + 1] = inv[c*3 + 1];
+        o[c*4 + 2] = inv[c*3 + 2];
+        o[c*4 + 3] = 0.0f;
+    }
+    o[12] = -(inv[0]*tx + inv[3]*ty + inv[6]*tz);
+    o[13] = -(inv[1]*tx + inv[4]*ty + inv[7]*tz);
+    o[14] = -(inv[2]*tx + inv[5]*ty + inv[8]*tz);
+    o[15] = 1.0f;
+    return 0;
+}
+
+vec4_t mat4_mul(const mat4_t* m, vec4_t v) {
+    const float* a = m->m;
+    return (vec4_t){
+        a[0]*v.x + a[4]*v.y + a[8]*v.z  + a[12]*v.w,
+        a[1]*v.x + a[5]*v.y + a[9]*v.z  + a[13]*v.w,
+        a[2]*v.x + a[6]*v.y + a[10]*v.z + a[14]*v.w,
+        a[3]*v.x + a[7]*v.y + a[11]*v.z + a[15]*v.w
+    };
+}
+
+// Combined model-view-projection: proj * view * world
+void mat4_mvp(mat4_t* result, const mat4_t* world, const mat4_t* view, const mat4_t* proj) {
+    mat4_t view_world;
+    mat4_multiply(&view_world, view, world);
+    mat4_multiply(result, proj, &view_world);
 }
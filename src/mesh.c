@@ -0,0 +1,141 @@
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mesh.h"
+
+// Indexed mesh creation: header, vertices and indices share one allocation
+indexed_mesh_t* indexed_mesh_create(int num_vertices, int num_edges) {
+    if (num_vertices < 0 || num_edges < 0) return NULL;
+
+    size_t vertex_bytes = sizeof(vec3f_t) * (size_t)num_vertices;
+    size_t index_bytes = sizeof(int) * 2 * (size_t)num_edges;
+    indexed_mesh_t* mesh = malloc(sizeof(indexed_mesh_t) + vertex_bytes + index_bytes);
+    if (!mesh) return NULL;
+
+    mesh->vertices = (vec3f_t*)(mesh + 1);
+    mesh->num_vertices = num_vertices;
+    mesh->indices = (int*)((char*)mesh->vertices + vertex_bytes);
+    mesh->num_edges = num_edges;
+    mesh->bounds_center = vec3f_make(0.0f, 0.0f, 0.0f);
+    mesh->bounds_radius = -1.0f;  // Unknown: never culled
+    mesh->version = 0;
+    return mesh;
+}
+
+void indexed_mesh_destroy(indexed_mesh_t* mesh) {
+    free(mesh);
+}
+
+void indexed_mesh_touch(indexed_mesh_t* mesh) {
+    mesh->version++;
+}
+
+// Bounding sphere around the AABB center (not minimal, but cheap and tight enough)
+void indexed_mesh_compute_bounds(indexed_mesh_t* mesh) {
+    indexed_mesh_touch(mesh);
+    if (mesh->num_vertices == 0) {
+        mesh->bounds_center = vec3f_make(0.0f, 0.0f, 0.0f);
+        mesh->bounds_radius = 0.0f;
+        return;
+    }
+
+    vec3f_t lo = mesh->vertices[0], hi = mesh->vertices[0];
+    for (int i = 1; i < mesh->num_vertices; i++) {
+        vec3f_t v = mesh->vertices[i];
+        lo = vec3f_make(fminf(lo.x, v.x), fminf(lo.y, v.y), fminf(lo.z, v.z));
+        hi = vec3f_make(fmaxf(hi.x, v.x), fmaxf(hi.y, v.y), fmaxf(hi.z, v.z));
+    }
+
+    vec3f_t center = vec3f_scale(vec3f_add(lo, hi), 0.5f);
+    float radius_sq = 0.0f;
+    for (int i = 0; i < mesh->num_vertices; i++) {
+        vec3f_t d = vec3f_sub(mesh->vertices[i], center);
+        radius_sq = fmaxf(radius_sq, vec3f_dot(d, d));
+    }
+
+    mesh->bounds_center = center;
+    mesh->bounds_radius = sqrtf(radius_sq);
+}
+
+// Vertex welding: hash the Cartesian bit patterns so only identical points merge
+static unsigned int hash_position(const vec3f_t* v) {
+    unsigned int bits[3];
+    memcpy(&bits[0], &v->x, sizeof(float));
+    memcpy(&bits[1], &v->y, sizeof(float));
+    memcpy(&bits[2], &v->z, sizeof(float));
+
+    unsigned int h = 2166136261u;
+    for (int i = 0; i < 3; i++) {
+        h = (h ^ bits[i]) * 16777619u;
+    }
+    return h;
+}
+
+static int find_or_add_vertex(indexed_mesh_t* mesh, int* table, size_t mask,
+                              const vec3f_t* v) {
+    size_t slot = hash_position(v) & mask;
+    while (table[slot] >= 0) {
+        const vec3f_t* other = &mesh->vertices[table[slot]];
+        if (other->x == v->x && other->y == v->y && other->z == v->z) {
+            return table[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    int index = mesh->num_vertices++;
+    mesh->vertices[index] = *v;
+    table[slot] = index;
+    return index;
+}
+
+// Release the unused tail of the vertex array: slide the indices down behind
+// the last vertex and shrink the block (indexed_mesh_create's layout)
+static indexed_mesh_t* shrink_vertices(indexed_mesh_t* mesh) {
+    size_t vertex_bytes = sizeof(vec3f_t) * (size_t)mesh->num_vertices;
+    size_t index_bytes = sizeof(int) * 2 * (size_t)mesh->num_edges;
+    memmove((char*)mesh->vertices + vertex_bytes, mesh->indices, index_bytes);
+    indexed_mesh_t* shrunk = realloc(mesh, sizeof(indexed_mesh_t) + vertex_bytes + index_bytes);
+    if (shrunk) mesh = shrunk;  // A failed shrink keeps the (now compacted) original block
+    mesh->vertices = (vec3f_t*)(mesh + 1);
+    mesh->indices = (int*)((char*)mesh->vertices + vertex_bytes);
+    return mesh;
+}
+
+indexed_mesh_t* indexed_mesh_from_mesh(const mesh_t* mesh) {
+    if (!mesh || mesh->num_edges < 0) return NULL;
+
+    // Worst case every endpoint is unique; the vertex array is sized for that
+    // and shrunk once welding is done. Vertex counts must fit in an int.
+    if (mesh->num_edges > INT_MAX / 2) return NULL;
+    int max_vertices = mesh->num_edges * 2;
+
+    // Open-addressing table at <= 50% load
+    size_t table_needed = 2 * (size_t)max_vertices;
+    size_t table_size = 16;
+    while (table_size < table_needed && table_size <= SIZE_MAX / 2 / sizeof(int)) table_size <<= 1;
+    if (table_size < table_needed) return NULL;
+
+    indexed_mesh_t* result = indexed_mesh_create(max_vertices, mesh->num_edges);
+    if (!result) return NULL;
+    result->num_vertices = 0;
+    int* table = malloc(sizeof(int) * table_size);
+    if (!table) {
+        indexed_mesh_destroy(result);
+        return NULL;
+    }
+    memset(table, -1, sizeof(int) * table_size);
+
+    // Spherical fields of the soup are dropped; only positions are welded
+    for (int i = 0; i < mesh->num_edges; i++) {
+        vec3f_t v0 = vec3f_from_vec3(&mesh->edges[i].v0);
+        vec3f_t v1 = vec3f_from_vec3(&mesh->edges[i].v1);
+        result->indices[2*i] = find_or_add_vertex(result, table, table_size - 1, &v0);
+        result->indices[2*i + 1] = find_or_add_vertex(result, table, table_size - 1, &v1);
+    }
+
+    free(table);
+    result = shrink_vertices(result);
+    indexed_mesh_compute_bounds(result);
+    return result;
+}
@@ -0,0 +1,441 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <limits.h>
+#include <math.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "mesh_file.h"
+
+// The blocks are indexed_mesh_t arrays verbatim
+_Static_assert(sizeof(vec3f_t) == 3 * sizeof(float), "vertex block needs packed vec3f_t");
+_Static_assert(sizeof(int) == sizeof(int32_t), "index block needs 32-bit int");
+_Static_assert(sizeof(mesh_file_header_t) == 64, "mesh file header must stay 64 bytes");
+
+static const char mesh_file_magic[8] = "T3DMESH";
+
+static uint32_t fnv1a(uint32_t hash, const void* data, size_t bytes) {
+    const unsigned char* p = data;
+    for (size_t i = 0; i < bytes; i++) hash = (hash ^ p[i]) * 16777619u;
+    return hash;
+}
+
+static uint64_t align_up(uint64_t offset) {
+    return (offset + MESH_FILE_ALIGNMENT - 1) / MESH_FILE_ALIGNMENT * MESH_FILE_ALIGNMENT;
+}
+
+static void set_status(mesh_file_status_t* status, mesh_file_status_t value) {
+    if (status) *status = value;
+}
+
+const char* mesh_file_status_string(mesh_file_status_t status) {
+    switch (status) {
+    case MESH_FILE_OK: return "ok";
+    case MESH_FILE_ERROR_IO: return "I/O error";
+    case MESH_FILE_ERROR_MEMORY: return "out of memory";
+    case MESH_FILE_ERROR_FORMAT: return "not a mesh file";
+    case MESH_FILE_ERROR_VERSION: return "unsupported version or byte order";
+    case MESH_FILE_ERROR_LAYOUT: return "corrupt block layout";
+    case MESH_FILE_ERROR_INDICES: return "edge index out of range";
+    case MESH_FILE_ERROR_CHECKSUM: return "checksum mismatch";
+    case MESH_FILE_ERROR_PARSE: return "malformed OBJ";
+    }
+    return "unknown error";
+}
+
+// Whole file into memory, NUL-terminated (for OBJ parsing and systems without mmap)
+static char* read_file(const char* path, size_t* size) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return NULL;
+    char* data = NULL;
+    long length = -1;
+    if (fseek(fp, 0, SEEK_END) == 0) length = ftell(fp);
+    if (length >= 0 && fseek(fp, 0, SEEK_SET) == 0) {
+        data = malloc((size_t)length + 1);
+        if (data && fread(data, 1, (size_t)length, fp) != (size_t)length) {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(fp);
+    if (!data) return NULL;
+    data[length] = '\0';
+    *size = (size_t)length;
+    return data;
+}
+
+// Header and block layout checks (cheap: touches the first page only)
+static mesh_file_status_t validate_layout(const mesh_file_header_t* h, size_t size) {
+    if (size < sizeof(mesh_file_header_t) || memcmp(h->magic, mesh_file_magic, 8) != 0) {
+        return MESH_FILE_ERROR_FORMAT;
+    }
+    // A foreign byte order also lands here: the version reads byte-swapped
+    if (h->version != MESH_FILE_VERSION) return MESH_FILE_ERROR_VERSION;
+
+    if (h->header_size < sizeof(mesh_file_header_t) || h->header_size > size) {
+        return MESH_FILE_ERROR_LAYOUT;
+    }
+    if (h->num_vertices > INT_MAX || h->num_edges > INT_MAX) return MESH_FILE_ERROR_LAYOUT;
+
+    uint64_t vertex_bytes = (uint64_t)h->num_vertices * sizeof(vec3f_t);
+    uint64_t index_bytes = (uint64_t)h->num_edges * 2 * sizeof(int32_t);
+    if (h->vertex_offset % MESH_FILE_ALIGNMENT || h->index_offset % MESH_FILE_ALIGNMENT) {
+        return MESH_FILE_ERROR_LAYOUT;
+    }
+    if (h->vertex_offset < h->header_size || h->vertex_offset > size ||
+        vertex_bytes > size - h->vertex_offset) {
+        return MESH_FILE_ERROR_LAYOUT;
+    }
+    if (h->index_offset < h->header_size || h->index_offset > size ||
+        index_bytes > size - h->index_offset) {
+        return MESH_FILE_ERROR_LAYOUT;
+    }
+    uint64_t vertex_end = h->vertex_offset + vertex_bytes;
+    uint64_t index_end = h->index_offset + index_bytes;
+    if (vertex_bytes && index_bytes && vertex_end > h->index_offset && index_end > h->vertex_offset) {
+        return MESH_FILE_ERROR_LAYOUT;  // Overlapping blocks
+    }
+
+    if (!(isfinite(h->bounds_center[0]) && isfinite(h->bounds_center[1]) &&
+          isfinite(h->bounds_center[2]) && !isnan(h->bounds_radius))) {
+        return MESH_FILE_ERROR_FORMAT;
+    }
+    return MESH_FILE_OK;
+}
+
+mesh_file_t* mesh_file_open(const char* path, unsigned int verify, mesh_file_status_t* status) {
+    set_status(status, MESH_FILE_ERROR_IO);
+    if (!path) return NULL;
+    mesh_file_t* file = calloc(1, sizeof(mesh_file_t));
+    if (!file) {
+        set_status(status, MESH_FILE_ERROR_MEMORY);
+        return NULL;
+    }
+
+#ifdef _WIN32
+    file->data = read_file(path, &file->size);  // No mmap: one read instead
+    if (!file->data) {
+        free(file);
+        return NULL;
+    }
+#else
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        if (fd >= 0) close(fd);
+        free(file);
+        return NULL;
+    }
+    if (st.st_size <= 0) {  // Nothing to map
+        close(fd);
+        free(file);
+        set_status(status, MESH_FILE_ERROR_FORMAT);
+        return NULL;
+    }
+    file->size = (size_t)st.st_size;
+    // Private and writable: callers may edit the mesh without touching the file
+    void* map = mmap(NULL, file->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps the file alive
+    if (map == MAP_FAILED) {
+        free(file);
+        return NULL;
+    }
+    file->data = map;
+    file->mapped = 1;
+#endif
+
+    const mesh_file_header_t* h = file->data;
+    mesh_file_status_t result = validate_layout(h, file->size);
+    if (result != MESH_FILE_OK) {
+        set_status(status, result);
+        mesh_file_close(file);
+        return NULL;
+    }
+
+    char* base = file->data;
+    file->header = h;
+    file->mesh.vertices = (vec3f_t*)(base + h->vertex_offset);
+    file->mesh.num_vertices = (int)h->num_vertices;
+    file->mesh.indices = (int*)(base + h->index_offset);
+    file->mesh.num_edges = (int)h->num_edges;
+    file->mesh.bounds_center = vec3f_make(h->bounds_center[0], h->bounds_center[1], h->bounds_center[2]);
+    file->mesh.bounds_radius = h->bounds_radius;
+    file->mesh.version = 0;
+
+    if (!(verify & MESH_FILE_TRUST_INDICES)) {
+        const int* indices = file->mesh.indices;
+        unsigned int limit = h->num_vertices;
+        for (size_t i = 0; i < 2 * (size_t)h->num_edges; i++) {
+            if ((unsigned int)indices[i] >= limit) {  // Negative indices wrap past the limit
+                set_status(status, MESH_FILE_ERROR_INDICES);
+                mesh_file_close(file);
+                return NULL;
+            }
+        }
+    }
+    if (verify & MESH_FILE_VERIFY_CHECKSUM) {
+        uint32_t hash = fnv1a(2166136261u, file->mesh.vertices, sizeof(vec3f_t) * h->num_vertices);
+        hash = fnv1a(hash, file->mesh.indices, 2 * sizeof(int32_t) * h->num_edges);
+        if (hash != h->checksum) {
+            set_status(status, MESH_FILE_ERROR_CHECKSUM);
+            mesh_file_close(file);
+            return NULL;
+        }
+    }
+
+    set_status(status, MESH_FILE_OK);
+    return file;
+}
+
+void mesh_file_close(mesh_file_t* file) {
+    if (!file) return;
+#ifndef _WIN32
+    if (file->mapped) {
+        munmap(file->data, file->size);
+        free(file);
+        return;
+    }
+#endif
+    free(file->data);
+    free(file);
+}
+
+mesh_file_status_t mesh_file_write(const char* path, const indexed_mesh_t* mesh) {
+    if (!path || !mesh || mesh->num_vertices < 0 || mesh->num_edges < 0) return MESH_FILE_ERROR_FORMAT;
+    for (size_t i = 0; i < 2 * (size_t)mesh->num_edges; i++) {
+        if (mesh->indices[i] < 0 || mesh->indices[i] >= mesh->num_vertices) return MESH_FILE_ERROR_INDICES;
+    }
+
+    size_t vertex_bytes = sizeof(vec3f_t) * (size_t)mesh->num_vertices;
+    size_t index_bytes = 2 * sizeof(int32_t) * (size_t)mesh->num_edges;
+
+    mesh_file_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, mesh_file_magic, 8);
+    header.version = MESH_FILE_VERSION;
+    header.header_size = sizeof(mesh_file_header_t);
+    header.num_vertices = (uint32_t)mesh->num_vertices;
+    header.num_edges = (uint32_t)mesh->num_edges;
+    header.vertex_offset = align_up(sizeof(mesh_file_header_t));
+    header.index_offset = align_up(header.vertex_offset + vertex_bytes);
+
+    // Bounds from the mesh, or computed on a shallow copy (the mesh is const)
+    indexed_mesh_t bounded = *mesh;
+    if (bounded.bounds_radius < 0.0f) indexed_mesh_compute_bounds(&bounded);
+    header.bounds_center[0] = bounded.bounds_center.x;
+    header.bounds_center[1] = bounded.bounds_center.y;
+    header.bounds_center[2] = bounded.bounds_center.z;
+    header.bounds_radius = bounded.bounds_radius;
+
+    header.checksum = fnv1a(fnv1a(2166136261u, mesh->vertices, vertex_bytes), mesh->indices, index_bytes);
+
+    FILE* fp = fopen(path, "wb");
+    if (!fp) return MESH_FILE_ERROR_IO;
+    static const char zeros[MESH_FILE_ALIGNMENT];
+    size_t vertex_pad = header.vertex_offset - sizeof(header);
+    size_t index_pad = header.index_offset - header.vertex_offset - vertex_bytes;
+    int ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+             fwrite(zeros, 1, vertex_pad, fp) == vertex_pad &&
+             fwrite(mesh->vertices, 1, vertex_bytes, fp) == vertex_bytes &&
+             fwrite(zeros, 1, index_pad, fp) == index_pad &&
+             fwrite(mesh->indices, 1, index_bytes, fp) == index_bytes;
+    if (fclose(fp) != 0) ok = 0;
+    return ok ? MESH_FILE_OK : MESH_FILE_ERROR_IO;
+}
+
+mesh_file_status_t mesh_file_write_soup(const char* path, const mesh_t* mesh) {
+    if (!mesh) return MESH_FILE_ERROR_FORMAT;
+    indexed_mesh_t* indexed = indexed_mesh_from_mesh(mesh);
+    if (!indexed) return MESH_FILE_ERROR_MEMORY;
+    mesh_file_status_t status = mesh_file_write(path, indexed);
+    indexed_mesh_destroy(indexed);
+    return status;
+}
+
+// OBJ import
+
+typedef struct {
+    vec3f_t* vertices;
+    int num_vertices;
+    int vertex_capacity;
+    int* indices;
+    int num_edges;
+    int edge_capacity;
+    uint64_t* edge_set;  // Open addressing over (min, max) keys + 1; 0 = empty
+    size_t set_capacity; // Power of two, kept at most half full
+} obj_builder_t;
+
+static int grow(void** array, int* capacity, size_t element) {
+    int next = *capacity ? *capacity * 2 : 1024;
+    void* grown = realloc(*array, element * (size_t)next);
+    if (!grown) return -1;
+    *array = grown;
+    *capacity = next;
+    return 0;
+}
+
+static size_t edge_slot(uint64_t key, size_t mask) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (size_t)key & mask;
+}
+
+// Insert the key; returns 1 if it was new, 0 if present, -1 on allocation failure
+static int edge_set_insert(obj_builder_t* b, uint64_t key) {
+    if (2 * (size_t)(b->num_edges + 1) > b->set_capacity) {
+        size_t capacity = b->set_capacity ? b->set_capacity * 2 : 4096;
+        uint64_t* set = calloc(capacity, sizeof(uint64_t));
+        if (!set) return -1;
+        for (size_t i = 0; i < b->set_capacity; i++) {
+            if (!b->edge_set[i]) continue;
+            size_t slot = edge_slot(b->edge_set[i], capacity - 1);
+            while (set[slot]) slot = (slot + 1) & (capacity - 1);
+            set[slot] = b->edge_set[i];
+        }
+        free(b->edge_set);
+        b->edge_set = set;
+        b->set_capacity = capacity;
+    }
+    size_t mask = b->set_capacity - 1;
+    size_t slot = edge_slot(key, mask);
+    while (b->edge_set[slot]) {
+        if (b->edge_set[slot] == key) return 0;
+        slot = (slot + 1) & mask;
+    }
+    b->edge_set[slot] = key;
+    return 1;
+}
+
+static mesh_file_status_t add_edge(obj_builder_t* b, int a, int c) {
+    if (a == c) return MESH_FILE_OK;  // Degenerate
+    int lo = a < c ? a : c, hi = a < c ? c : a;
+    int added = edge_set_insert(b, ((uint64_t)lo << 32 | (uint32_t)hi) + 1);
+    if (added < 0) return MESH_FILE_ERROR_MEMORY;
+    if (!added) return MESH_FILE_OK;
+    if (b->num_edges == b->edge_capacity &&
+        grow((void**)&b->indices, &b->edge_capacity, 2 * sizeof(int)) != 0) {
+        return MESH_FILE_ERROR_MEMORY;
+    }
+    b->indices[2 * b->num_edges] = a;
+    b->indices[2 * b->num_edges + 1] = c;
+    b->num_edges++;
+    return MESH_FILE_OK;
+}
+
+static int is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Parse one vertex reference ("7", "-2", "7/1/3", "7//3") into a 0-based index
+static int parse_reference(const char** cursor, int num_vertices, int* index) {
+    char* end;
+    long value = strtol(*cursor, &end, 10);
+    if (end == *cursor) return -1;
+    while (*end && !is_space(*end) && *end != '\n') end++;  // Skip /texture/normal
+    *cursor = end;
+    if (value > 0) value -= 1;
+    else if (value < 0) value += num_vertices;
+    else return -1;  // OBJ indices start at 1
+    if (value < 0 || value >= num_vertices) return -1;
+    *index = (int)value;
+    return 0;
+}
+
+static mesh_file_status_t parse_obj(obj_builder_t* b, const char* text) {
+    const char* p = text;
+    while (*p) {
+        while (is_space(*p)) p++;
+        int face = p[0] == 'f' && is_space(p[1]);
+        int polyline = p[0] == 'l' && is_space(p[1]);
+
+        if (p[0] == 'v' && is_space(p[1])) {
+            float xyz[3];
+            const char* q = p + 2;
+            for (int k = 0; k < 3; k++) {
+                char* end;
+                xyz[k] = strtof(q, &end);
+                if (end == q) return MESH_FILE_ERROR_PARSE;
+                q = end;
+            }
+            if (b->num_vertices == INT_MAX) return MESH_FILE_ERROR_PARSE;
+            if (b->num_vertices == b->vertex_capacity &&
+                grow((void**)&b->vertices, &b->vertex_capacity, sizeof(vec3f_t)) != 0) {
+                return MESH_FILE_ERROR_MEMORY;
+            }
+            b->vertices[b->num_vertices++] = vec3f_make(xyz[0], xyz[1], xyz[2]);
+            p = q;
+        } else if (face || polyline) {
+            const char* q = p + 2;
+            int first = -1, previous = -1, count = 0;
+            for (;;) {
+                while (is_space(*q)) q++;
+                if (*q == '\n' || *q == '\0' || *q == '#') break;
+                int index;
+                if (parse_reference(&q, b->num_vertices, &index) != 0) return MESH_FILE_ERROR_PARSE;
+                if (count == 0) first = index;
+                else {
+                    mesh_file_status_t s = add_edge(b, previous, index);
+                    if (s != MESH_FILE_OK) return s;
+                }
+                previous = index;
+                count++;
+            }
+            if (count < 2) return MESH_FILE_ERROR_PARSE;
+            if (face && count > 2) {
+                mesh_file_status_t s = add_edge(b, previous, first);  // Close the polygon
+                if (s != MESH_FILE_OK) return s;
+            }
+            p = q;
+        }
+
+        // Anything else (comments, normals, groups, materials) is skipped
+        while (*p && *p != '\n') p++;
+        if (*p == '\n') p++;
+    }
+    return MESH_FILE_OK;
+}
+
+indexed_mesh_t* mesh_file_import_obj(const char* path, mesh_file_status_t* status) {
+    size_t size;
+    char* text = path ? read_file(path, &size) : NULL;
+    if (!text) {
+        set_status(status, MESH_FILE_ERROR_IO);
+        return NULL;
+    }
+
+    obj_builder_t b;
+    memset(&b, 0, sizeof(b));
+    mesh_file_status_t result = parse_obj(&b, text);
+    free(text);
+
+    indexed_mesh_t* mesh = NULL;
+    if (result == MESH_FILE_OK) {
+        mesh = indexed_mesh_create(b.num_vertices, b.num_edges);
+        if (mesh) {
+            if (b.num_vertices) memcpy(mesh->vertices, b.vertices, sizeof(vec3f_t) * b.num_vertices);
+            if (b.num_edges) memcpy(mesh->indices, b.indices, 2 * sizeof(int) * b.num_edges);
+            indexed_mesh_compute_bounds(mesh);
+        } else {
+            result = MESH_FILE_ERROR_MEMORY;
+        }
+    }
+    free(b.vertices);
+    free(b.indices);
+    free(b.edge_set);
+    set_status(status, result);
+    return mesh;
+}
+
+mesh_file_status_t mesh_file_convert_obj(const char* obj_path, const char* mesh_path) {
+    mesh_file_status_t status;
+    indexed_mesh_t* mesh = mesh_file_import_obj(obj_path, &status);
+    if (!mesh) return status;
+    status = mesh_file_write(mesh_path, mesh);
+    indexed_mesh_destroy(mesh);
+    return status;
+}
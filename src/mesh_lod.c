@@ -0,0 +1,208 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "mesh_lod.h"
+
+// A pass that keeps more than this fraction of the edges ends the chain
+#define MESH_LOD_MIN_REDUCTION 0.8f
+// No point simplifying below a handful of edges
+#define MESH_LOD_MIN_EDGES 8
+
+typedef struct {
+    float length_sq;
+    int edge;
+} edge_key_t;
+
+// Shortest first; ties in index order so builds are deterministic
+static int compare_keys(const void* a, const void* b) {
+    const edge_key_t* ka = a;
+    const edge_key_t* kb = b;
+    if (ka->length_sq != kb->length_sq) return ka->length_sq < kb->length_sq ? -1 : 1;
+    return (ka->edge > kb->edge) - (ka->edge < kb->edge);
+}
+
+static size_t edge_slot(uint64_t key, size_t mask) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (size_t)key & mask;
+}
+
+// Collapse a matching of src's edges. weight holds the number of source
+// vertices behind each src vertex and is updated in place; remap receives
+// each src vertex's index in the result. Returns NULL on allocation failure.
+static indexed_mesh_t* collapse_pass(const indexed_mesh_t* src, int* weight, int* remap) {
+    const int nv = src->num_vertices, ne = src->num_edges;
+    edge_key_t* keys = malloc(sizeof(edge_key_t) * (ne ? ne : 1));
+    int* parent = malloc(sizeof(int) * (nv ? nv : 1));
+    vec3f_t* position = malloc(sizeof(vec3f_t) * (nv ? nv : 1));
+    int* edges = malloc(sizeof(int) * 2 * (ne ? ne : 1));
+    size_t set_capacity = 16;
+    while (set_capacity < 2 * (size_t)ne) set_capacity *= 2;
+    uint64_t* set = calloc(set_capacity, sizeof(uint64_t));
+    indexed_mesh_t* result = NULL;
+    if (!keys || !parent || !position || !edges || !set) goto done;
+
+    for (int i = 0; i < ne; i++) {
+        vec3f_t d = vec3f_sub(src->vertices[src->indices[2*i + 1]], src->vertices[src->indices[2*i]]);
+        keys[i] = (edge_key_t){ vec3f_dot(d, d), i };
+    }
+    qsort(keys, ne, sizeof(edge_key_t), compare_keys);
+
+    // Each vertex takes part in at most one collapse per pass
+    for (int v = 0; v < nv; v++) {
+        parent[v] = -1;
+        position[v] = src->vertices[v];
+    }
+    for (int k = 0; k < ne; k++) {
+        int a = src->indices[2 * keys[k].edge];
+        int b = src->indices[2 * keys[k].edge + 1];
+        if (a == b || parent[a] != -1 || parent[b] != -1) continue;
+        float wa = (float)weight[a], wb = (float)weight[b];
+        position[a] = vec3f_scale(vec3f_add(vec3f_scale(position[a], wa),
+                                            vec3f_scale(position[b], wb)), 1.0f / (wa + wb));
+        weight[a] += weight[b];
+        parent[a] = a;
+        parent[b] = a;
+    }
+
+    int num_vertices = 0;
+    for (int v = 0; v < nv; v++) {
+        if (parent[v] == -1 || parent[v] == v) {
+            remap[v] = num_vertices;
+            position[num_vertices] = position[v];  // Compacts in place (num_vertices <= v)
+            weight[num_vertices] = weight[v];
+            num_vertices++;
+        }
+    }
+    for (int v = 0; v < nv; v++) {
+        if (parent[v] != -1 && parent[v] != v) remap[v] = remap[parent[v]];
+    }
+
+    // Remapped edges in first-seen order, without collapsed or repeated ones
+    int num_edges = 0;
+    for (int i = 0; i < ne; i++) {
+        int a = remap[src->indices[2*i]], b = remap[src->indices[2*i + 1]];
+        if (a == b) continue;
+        int lo = a < b ? a : b, hi = a < b ? b : a;
+        uint64_t key = ((uint64_t)lo << 32 | (uint32_t)hi) + 1;
+        size_t slot = edge_slot(key, set_capacity - 1);
+        while (set[slot] && set[slot] != key) slot = (slot + 1) & (set_capacity - 1);
+        if (set[slot]) continue;
+        set[slot] = key;
+        edges[2 * num_edges] = a;
+        edges[2 * num_edges + 1] = b;
+        num_edges++;
+    }
+
+    result = indexed_mesh_create(num_vertices, num_edges);
+    if (!result) goto done;
+    memcpy(result->vertices, position, sizeof(vec3f_t) * num_vertices);
+    memcpy(result->indices, edges, sizeof(int) * 2 * num_edges);
+
+done:
+    free(keys);
+    free(parent);
+    free(position);
+    free(edges);
+    free(set);
+    return result;
+}
+
+mesh_lod_t* mesh_lod_build(const indexed_mesh_t* mesh, int max_levels) {
+    if (max_levels < 1) max_levels = 1;
+    if (max_levels > MESH_LOD_MAX_LEVELS) max_levels = MESH_LOD_MAX_LEVELS;
+
+    mesh_lod_t* lod = calloc(1, sizeof(mesh_lod_t));
+    int* rep = malloc(sizeof(int) * (mesh->num_vertices ? mesh->num_vertices : 1));
+    int* weight = malloc(sizeof(int) * (mesh->num_vertices ? mesh->num_vertices : 1));
+    int* remap = malloc(sizeof(int) * (mesh->num_vertices ? mesh->num_vertices : 1));
+    if (!lod || !rep || !weight || !remap) {
+        free(lod);
+        lod = NULL;
+        goto done;
+    }
+
+    // Centroids stay inside the source's convex hull, so its sphere bounds every level
+    indexed_mesh_t bounds = *mesh;
+    if (bounds.bounds_radius < 0.0f) indexed_mesh_compute_bounds(&bounds);
+    lod->bounds_center = bounds.bounds_center;
+    lod->bounds_radius = bounds.bounds_radius;
+    lod->levels[0] = (mesh_lod_level_t){ mesh, 0.0f };
+    lod->num_levels = 1;
+
+    for (int i = 0; i < mesh->num_vertices; i++) {
+        rep[i] = i;
+        weight[i] = 1;
+    }
+    const indexed_mesh_t* current = mesh;
+    while (lod->num_levels < max_levels && current->num_edges > MESH_LOD_MIN_EDGES) {
+        indexed_mesh_t* next = collapse_pass(current, weight, remap);
+        if (!next) {
+            mesh_lod_destroy(lod);
+            lod = NULL;
+            goto done;
+        }
+        if (next->num_edges > MESH_LOD_MIN_REDUCTION * current->num_edges) {
+            indexed_mesh_destroy(next);
+            break;
+        }
+
+        // Error: the farthest any source vertex now sits from its representative
+        // (never below the previous level's, so selection can stop at the first miss)
+        float error = lod->levels[lod->num_levels - 1].error;
+        float error_sq = error * error;
+        for (int i = 0; i < mesh->num_vertices; i++) {
+            rep[i] = remap[rep[i]];
+            vec3f_t d = vec3f_sub(next->vertices[rep[i]], mesh->vertices[i]);
+            error_sq = fmaxf(error_sq, vec3f_dot(d, d));
+        }
+        next->bounds_center = lod->bounds_center;
+        next->bounds_radius = lod->bounds_radius;
+        lod->levels[lod->num_levels++] = (mesh_lod_level_t){ next, sqrtf(error_sq) };
+        current = next;
+    }
+
+done:
+    free(rep);
+    free(weight);
+    free(remap);
+    return lod;
+}
+
+void mesh_lod_destroy(mesh_lod_t* lod) {
+    if (!lod) return;
+    for (int i = 1; i < lod->num_levels; i++) {
+        indexed_mesh_destroy((indexed_mesh_t*)lod->levels[i].mesh);
+    }
+    free(lod);
+}
+
+float mesh_lod_pixels_per_unit(const mesh_lod_t* lod, const mat4_t* world, const mat4_t* view,
+                               const mat4_t* proj, int viewport_height) {
+    mat4_t model_view;
+    mat4_multiply(&model_view, view, world);
+
+    // Longest transformed basis axis: object units to eye units
+    const float* m = model_view.m;
+    float scale = sqrtf(fmaxf(m[0]*m[0] + m[1]*m[1] + m[2]*m[2],
+                              fmaxf(m[4]*m[4] + m[5]*m[5] + m[6]*m[6],
+                                    m[8]*m[8] + m[9]*m[9] + m[10]*m[10])));
+
+    vec3f_t c = lod->bounds_center;
+    vec4_t center = mat4_mul(&model_view, (vec4_t){ c.x, c.y, c.z, 1.0f });
+    float distance = -center.z - lod->bounds_radius * scale;  // Nearest point, looking down -z
+    if (!(distance > 1e-6f)) return 0.0f;
+    return scale * fabsf(proj->m[5]) * 0.5f * (float)viewport_height / distance;
+}
+
+int mesh_lod_select(const mesh_lod_t* lod, float pixels_per_unit, float max_pixel_error) {
+    if (!(pixels_per_unit > 0.0f)) return 0;
+    int level = 0;
+    for (int i = 1; i < lod->num_levels; i++) {
+        if (lod->levels[i].error * pixels_per_unit > max_pixel_error) break;
+        level = i;
+    }
+    return level;
+}
@@ -0,0 +1,205 @@
+#include <stdlib.h>
+#include <string.h>
+#include "profile.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PROFILE_HAVE_TSC 1
+#endif
+
+static const char* const stage_names[PROFILE_STAGE_COUNT] = {
+    "project", "clip", "sort", "raster", "lighting"
+};
+
+static _Thread_local profile_t* bound_profile;
+
+const char* profile_stage_name(profile_stage_t stage) {
+    return stage >= 0 && stage < PROFILE_STAGE_COUNT ? stage_names[stage] : "frame";
+}
+
+void profile_bind(profile_t* profile) {
+    bound_profile = profile;
+}
+
+profile_t* profile_bound(void) {
+    return bound_profile;
+}
+
+void profile_init(profile_t* profile, size_t max_events) {
+    memset(profile, 0, sizeof(profile_t));
+    profile->max_events = max_events;
+    profile->origin = time_monotonic_ns();
+}
+
+void profile_destroy(profile_t* profile) {
+    free(profile->events);
+    free(profile->history);
+    memset(profile, 0, sizeof(profile_t));
+}
+
+void profile_reset(profile_t* profile) {
+    profile_event_t* events = profile->events;
+    size_t event_capacity = profile->event_capacity;
+    profile_stats_t* history = profile->history;
+    int history_capacity = profile->history_capacity;
+    size_t max_events = profile->max_events;
+
+    profile_init(profile, max_events);
+    profile->events = events;
+    profile->event_capacity = event_capacity;
+    profile->history = history;
+    profile->history_capacity = history_capacity;
+}
+
+profile_mark_t profile_now(void) {
+    profile_mark_t mark = { time_monotonic_ns(), 0 };
+#ifdef PROFILE_HAVE_TSC
+    mark.cycles = __builtin_ia32_rdtsc();
+#endif
+    return mark;
+}
+
+// Append to the trace log, growing it up to max_events
+static void log_event(profile_t* profile, int stage, time_ns_t start, time_ns_t duration) {
+    if (profile->num_events == profile->event_capacity) {
+        size_t capacity = profile->event_capacity ? profile->event_capacity * 2 : 1024;
+        if (capacity > profile->max_events) capacity = profile->max_events;
+        profile_event_t* events = capacity > profile->event_capacity
+                                      ? realloc(profile->events, capacity * sizeof(profile_event_t))
+                                      : NULL;
+        if (!events) {
+            profile->dropped_events++;
+            return;
+        }
+        profile->events = events;
+        profile->event_capacity = capacity;
+    }
+    profile->events[profile->num_events++] = (profile_event_t){
+        .start = start - profile->origin,
+        .duration = duration,
+        .stage = stage,
+        .frame = profile->in_frame ? profile->frames : -1
+    };
+}
+
+void profile_record(profile_t* profile, profile_stage_t stage, profile_mark_t start) {
+    profile_mark_t end = profile_now();
+    profile->frame.ns[stage] += end.ns - start.ns;
+    profile->frame.cycles[stage] += end.cycles - start.cycles;
+    profile->frame.calls[stage]++;
+    if (profile->max_events) log_event(profile, stage, start.ns, end.ns - start.ns);
+}
+
+void profile_begin_frame(profile_t* profile) {
+    if (profile->in_frame) profile_end_frame(profile);
+    memset(&profile->frame, 0, sizeof(profile_stats_t));
+    profile->in_frame = 1;
+    profile->frame_start = time_monotonic_ns();
+}
+
+void profile_end_frame(profile_t* profile) {
+    if (!profile->in_frame) return;
+    time_ns_t end = time_monotonic_ns();
+    if (profile->max_events) log_event(profile, -1, profile->frame_start, end - profile->frame_start);
+
+    // Keep the frame's counters for the trace
+    if (profile->max_events && profile->history_count == profile->frames) {
+        if (profile->history_count == profile->history_capacity) {
+            int capacity = profile->history_capacity ? profile->history_capacity * 2 : 64;
+            profile_stats_t* history = realloc(profile->history, capacity * sizeof(profile_stats_t));
+            if (history) {
+                profile->history = history;
+                profile->history_capacity = capacity;
+            }
+        }
+        if (profile->history_count < profile->history_capacity) {
+            profile->history[profile->history_count++] = profile->frame;
+        }
+    }
+
+    const profile_stats_t* f = &profile->frame;
+    profile_stats_t* t = &profile->total;
+    for (int s = 0; s < PROFILE_STAGE_COUNT; s++) {
+        t->ns[s] += f->ns[s];
+        t->cycles[s] += f->cycles[s];
+        t->calls[s] += f->calls[s];
+    }
+    t->meshes_culled += f->meshes_culled;
+    t->vertices_projected += f->vertices_projected;
+    t->edges_culled += f->edges_culled;
+    t->edges_clipped += f->edges_clipped;
+    t->edges_drawn += f->edges_drawn;
+    t->pixels_touched += f->pixels_touched;
+    t->edges_lit += f->edges_lit;
+    t->scratch_allocs += f->scratch_allocs;
+    if (f->scratch_bytes > t->scratch_bytes) t->scratch_bytes = f->scratch_bytes;
+
+    profile->last = *f;
+    memset(&profile->frame, 0, sizeof(profile_stats_t));
+    profile->frames++;
+    profile->in_frame = 0;
+}
+
+// Chrome trace timestamps are microseconds
+static double trace_us(time_ns_t ns) {
+    return (double)ns / 1000.0;
+}
+
+static void write_counters(FILE* fp, const profile_stats_t* s) {
+    fprintf(fp, "\"vertices_projected\":%llu,\"meshes_culled\":%llu,\"edges_culled\":%llu,"
+                "\"edges_clipped\":%llu,\"edges_drawn\":%llu,\"pixels_touched\":%llu,"
+                "\"edges_lit\":%llu,\"scratch_allocs\":%llu,\"scratch_bytes\":%llu",
+            (unsigned long long)s->vertices_projected, (unsigned long long)s->meshes_culled,
+            (unsigned long long)s->edges_culled, (unsigned long long)s->edges_clipped,
+            (unsigned long long)s->edges_drawn, (unsigned long long)s->pixels_touched,
+            (unsigned long long)s->edges_lit, (unsigned long long)s->scratch_allocs,
+            (unsigned long long)s->scratch_bytes);
+    for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+        fprintf(fp, ",\"%s_ns\":%lld", stage_names[stage], (long long)s->ns[stage]);
+    }
+}
+
+int profile_write_trace(const profile_t* profile, FILE* fp) {
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", fp);
+    fputs("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,"
+          "\"args\":{\"name\":\"tiny3d\"}}", fp);
+
+    for (size_t i = 0; i < profile->num_events; i++) {
+        const profile_event_t* e = &profile->events[i];
+        fprintf(fp, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+                    "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%d",
+                profile_stage_name((profile_stage_t)e->stage), e->stage < 0 ? "frame" : "stage",
+                trace_us(e->start), trace_us(e->duration), e->frame);
+        if (e->stage < 0 && e->frame >= 0 && e->frame < profile->history_count) {
+            const profile_stats_t* s = &profile->history[e->frame];
+            fputc(',', fp);
+            write_counters(fp, s);
+            fputs("}}", fp);
+
+            // Counter tracks, sampled at the end of each frame
+            double ts = trace_us(e->start + e->duration);
+            fprintf(fp, ",\n{\"name\":\"edges\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,"
+                        "\"args\":{\"drawn\":%llu,\"clipped\":%llu,\"culled\":%llu}}",
+                    ts, (unsigned long long)s->edges_drawn, (unsigned long long)s->edges_clipped,
+                    (unsigned long long)s->edges_culled);
+            fprintf(fp, ",\n{\"name\":\"vertices\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,"
+                        "\"args\":{\"projected\":%llu}}",
+                    ts, (unsigned long long)s->vertices_projected);
+            fprintf(fp, ",\n{\"name\":\"pixels\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,"
+                        "\"args\":{\"touched\":%llu}}",
+                    ts, (unsigned long long)s->pixels_touched);
+        } else {
+            fputs("}}", fp);
+        }
+    }
+    fprintf(fp, "\n],\"otherData\":{\"frames\":%d,\"dropped_events\":%lu}}\n",
+            profile->frames, profile->dropped_events);
+    return ferror(fp) ? -1 : 0;
+}
+
+int profile_save_trace(const profile_t* profile, const char* path) {
+    FILE* fp = fopen(path, "w");
+    if (!fp) return -1;
+    int status = profile_write_trace(profile, fp);
+    if (fclose(fp) != 0) status = -1;
+    return status;
+}
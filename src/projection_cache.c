@@ -0,0 +1,61 @@
+#include <stdlib.h>
+#include <string.h>
+#include "projection_cache.h"
+
+void projection_cache_init(projection_cache_t* cache) {
+    memset(cache, 0, sizeof(projection_cache_t));
+}
+
+void projection_cache_destroy(projection_cache_t* cache) {
+    free(cache->segments);
+    free(cache->depths);
+    memset(cache, 0, sizeof(projection_cache_t));
+}
+
+void projection_cache_invalidate(projection_cache_t* cache) {
+    cache->valid = 0;
+}
+
+int projection_cache_lookup(projection_cache_t* cache, const indexed_mesh_t* mesh,
+                            const mat4_t* mvp, int width, int height) {
+    // Bitwise MVP comparison: any change at all re-projects, and no hash can collide
+    int hit = cache->valid && cache->mesh == mesh && cache->mesh_version == mesh->version &&
+              cache->width == width && cache->height == height &&
+              memcmp(&cache->mvp, mvp, sizeof(mat4_t)) == 0;
+    if (hit) {
+        cache->hits++;
+    } else {
+        cache->misses++;
+    }
+    return hit;
+}
+
+int projection_cache_reserve(projection_cache_t* cache, int count) {
+    cache->valid = 0;
+    if (count <= cache->capacity) return 0;
+
+    segment_t* segments = malloc(sizeof(segment_t) * count);
+    float* depths = malloc(sizeof(float) * count);
+    if (!segments || !depths) {
+        free(segments);
+        free(depths);
+        return -1;
+    }
+    free(cache->segments);
+    free(cache->depths);
+    cache->segments = segments;
+    cache->depths = depths;
+    cache->capacity = count;
+    return 0;
+}
+
+void projection_cache_store(projection_cache_t* cache, const indexed_mesh_t* mesh,
+                            const mat4_t* mvp, int width, int height, int count) {
+    cache->valid = 1;
+    cache->mesh = mesh;
+    cache->mesh_version = mesh->version;
+    cache->mvp = *mvp;
+    cache->width = width;
+    cache->height = height;
+    cache->count = count;
+}
@@ -0,0 +1,187 @@
+#include <math.h>
+#include <string.h>
+#include "raster.h"
+
+// Tiles must own their depth pixels outright for the tiled path to stay exact
+_Static_assert(RASTER_TILE_SIZE == DEPTH_TILE_SIZE, "raster and depth tiles must match");
+
+// Sub-pixel splat segments waiting to be drawn as points
+#define RASTER_POINT_BATCH 256
+
+typedef struct {
+    canvas_t* canvas;
+    const canvas_rect_t* clip;
+    float thickness;
+    raster_line_mode_t mode;
+    int count;
+    canvas_point_t points[RASTER_POINT_BATCH];
+} segment_writer_t;
+
+// Fields set one by one so the point buffer is not zeroed on every call
+static void writer_init(segment_writer_t* w, canvas_t* canvas, const canvas_rect_t* clip,
+                        float thickness, raster_line_mode_t mode) {
+    w->canvas = canvas;
+    w->clip = clip;
+    w->thickness = thickness;
+    w->mode = mode;
+    w->count = 0;
+}
+
+static void flush_points(segment_writer_t* w) {
+    draw_points_f_depth(w->canvas, w->points, w->count, w->thickness, w->clip);
+    w->count = 0;
+}
+
+// Segments are drawn in order. Runs of sub-pixel splat segments (distant
+// detail) are queued and drawn as one point batch before the next full line,
+// which leaves the output bit-identical. The depth variants draw untested
+// when the canvas has no depth buffer.
+static void draw_segment(segment_writer_t* w, const segment_t* s, float intensity) {
+    if (w->mode == RASTER_LINE_AA) {
+        draw_line_aa_depth(w->canvas, s->x0, s->y0, s->z0, s->x1, s->y1, s->z1,
+                           w->thickness, intensity, w->clip);
+        return;
+    }
+    if (canvas_point_from_line(s->x0, s->y0, s->z0, s->x1, s->y1, s->z1,
+                               w->thickness, intensity, &w->points[w->count])) {
+        if (++w->count == RASTER_POINT_BATCH) flush_points(w);
+        return;
+    }
+    if (w->count) flush_points(w);
+    draw_line_f_depth(w->canvas, s->x0, s->y0, s->z0, s->x1, s->y1, s->z1,
+                      w->thickness, intensity, w->clip);
+}
+
+void raster_segments_weighted(canvas_t* canvas, const segment_t* segments,
+                              const float* intensities, int count,
+                              float thickness, raster_line_mode_t mode) {
+    segment_writer_t writer;
+    writer_init(&writer, canvas, NULL, thickness, mode);
+    for (int i = 0; i < count; i++) {
+        draw_segment(&writer, &segments[i], intensities ? intensities[i] : 1.0f);
+    }
+    if (writer.count) flush_points(&writer);
+}
+
+void raster_segments(canvas_t* canvas, const segment_t* segments, int count,
+                     float thickness, raster_line_mode_t mode) {
+    raster_segments_weighted(canvas, segments, NULL, count, thickness, mode);
+}
+
+// Shared state for the tile tasks
+typedef struct {
+    canvas_t* canvas;
+    const segment_t* segments;
+    const float* intensities;  // NULL = 1.0 for every segment
+    float thickness;
+    raster_line_mode_t mode;
+    int tiles_x;
+    const int* bin_start;  // tiles + 1 offsets into bin_items
+    const int* bin_items;  // Segment indices, in list order within each tile
+} tile_job_t;
+
+static void raster_tile(void* ctx, int tile, int worker_index) {
+    (void)worker_index;
+    const tile_job_t* job = ctx;
+
+    int tx = tile % job->tiles_x;
+    int ty = tile / job->tiles_x;
+    canvas_rect_t rect = {
+        tx * RASTER_TILE_SIZE, ty * RASTER_TILE_SIZE,
+        (tx + 1) * RASTER_TILE_SIZE, (ty + 1) * RASTER_TILE_SIZE
+    };
+
+    segment_writer_t writer;
+    writer_init(&writer, job->canvas, &rect, job->thickness, job->mode);
+    for (int k = job->bin_start[tile]; k < job->bin_start[tile + 1]; k++) {
+        int i = job->bin_items[k];
+        draw_segment(&writer, &job->segments[i], job->intensities ? job->intensities[i] : 1.0f);
+    }
+    if (writer.count) flush_points(&writer);
+}
+
+// Tile range touched by a segment's splat footprint; returns 0 if off-canvas
+static int segment_tiles(const canvas_t* canvas, const segment_t* s, float margin,
+                         int* tx0, int* ty0, int* tx1, int* ty1) {
+    float min_x = fminf(s->x0, s->x1) - margin;
+    float max_x = fmaxf(s->x0, s->x1) + margin;
+    float min_y = fminf(s->y0, s->y1) - margin;
+    float max_y = fmaxf(s->y0, s->y1) + margin;
+
+    // Also rejects NaN endpoints
+    if (!(max_x >= 0.0f && max_y >= 0.0f &&
+          min_x < (float)canvas->width && min_y < (float)canvas->height)) {
+        return 0;
+    }
+
+    int max_tx = (canvas->width - 1) / RASTER_TILE_SIZE;
+    int max_ty = (canvas->height - 1) / RASTER_TILE_SIZE;
+    *tx0 = min_x <= 0.0f ? 0 : (int)min_x / RASTER_TILE_SIZE;
+    *ty0 = min_y <= 0.0f ? 0 : (int)min_y / RASTER_TILE_SIZE;
+    *tx1 = max_x >= (float)canvas->width ? max_tx : (int)max_x / RASTER_TILE_SIZE;
+    *ty1 = max_y >= (float)canvas->height ? max_ty : (int)max_y / RASTER_TILE_SIZE;
+    return 1;
+}
+
+void raster_segments_tiled_weighted(canvas_t* canvas, const segment_t* segments,
+                                    const float* intensities, int count,
+                                    float thickness, raster_line_mode_t mode,
+                                    threadpool_t* pool, arena_t* arena) {
+    int tiles_x = (canvas->width + RASTER_TILE_SIZE - 1) / RASTER_TILE_SIZE;
+    int tiles_y = (canvas->height + RASTER_TILE_SIZE - 1) / RASTER_TILE_SIZE;
+    int num_tiles = tiles_x * tiles_y;
+    // Splat squares reach thickness/2 + 1; the AA band reaches thickness/2 * sqrt(2) + 1
+    float margin = (float)((int)(thickness / 2) + 2);
+    if (mode == RASTER_LINE_AA) margin = fmaxf(margin, thickness * 0.75f + 2.0f);
+
+    int* bin_start = arena_alloc(arena, sizeof(int) * (num_tiles + 1));
+    int* bin_fill = arena_alloc(arena, sizeof(int) * num_tiles);
+    if (!bin_start || !bin_fill) return;
+
+    // Pass 1: count segments per tile
+    memset(bin_fill, 0, sizeof(int) * num_tiles);
+    for (int i = 0; i < count; i++) {
+        int tx0, ty0, tx1, ty1;
+        if (!segment_tiles(canvas, &segments[i], margin, &tx0, &ty0, &tx1, &ty1)) continue;
+        for (int ty = ty0; ty <= ty1; ty++) {
+            for (int tx = tx0; tx <= tx1; tx++) bin_fill[ty * tiles_x + tx]++;
+        }
+    }
+
+    int total = 0;
+    for (int t = 0; t < num_tiles; t++) {
+        bin_start[t] = total;
+        total += bin_fill[t];
+        bin_fill[t] = bin_start[t];
+    }
+    bin_start[num_tiles] = total;
+
+    // Pass 2: fill bins in list order so every tile replays the global order
+    int* bin_items = arena_alloc(arena, sizeof(int) * (total ? total : 1));
+    if (!bin_items) return;
+    for (int i = 0; i < count; i++) {
+        int tx0, ty0, tx1, ty1;
+        if (!segment_tiles(canvas, &segments[i], margin, &tx0, &ty0, &tx1, &ty1)) continue;
+        for (int ty = ty0; ty <= ty1; ty++) {
+            for (int tx = tx0; tx <= tx1; tx++) bin_items[bin_fill[ty * tiles_x + tx]++] = i;
+        }
+    }
+
+    tile_job_t job = {
+        .canvas = canvas,
+        .segments = segments,
+        .intensities = intensities,
+        .thickness = thickness,
+        .mode = mode,
+        .tiles_x = tiles_x,
+        .bin_start = bin_start,
+        .bin_items = bin_items
+    };
+    threadpool_run(pool, raster_tile, &job, num_tiles);
+}
+
+void raster_segments_tiled(canvas_t* canvas, const segment_t* segments, int count,
+                           float thickness, raster_line_mode_t mode,
+                           threadpool_t* pool, arena_t* arena) {
+    raster_segments_tiled_weighted(canvas, segments, NULL, count, thickness, mode, pool, arena);
+}
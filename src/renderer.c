@@ -3,15 +3,18 @@
 #include "renderer.h"
 #include "math3d.h"
 #include "canvas.h"
+#include "transform.h"
+#include "depth_sort.h"
+#include "clip.h"
 
 // 1. Vertex Projection Pipeline
-vec3_t project_vertex(vec3_t vertex, mat4_t world, mat4_t view, mat4_t proj, 
+vec3f_t project_vertex(vec3f_t vertex, mat4_t world, mat4_t view, mat4_t proj,
                      int width, int height) {
     // Transform through pipeline stages
     vec4_t v_local = {vertex.x, vertex.y, vertex.z, 1.0f};
-    vec4_t v_world = mat4_mul(world, v_local);
-    vec4_t v_view = mat4_mul(view, v_world);
-    vec4_t v_proj = mat4_mul(proj, v_view);
+    vec4_t v_world = mat4_mul(&world, v_local);
+    vec4_t v_view = mat4_mul(&view, v_world);
+    vec4_t v_proj = mat4_mul(&proj, v_view);
 
     // Perspective divide with safety check
     if (fabs(v_proj.w) > 1e-6f) {
@@ -21,10 +24,10 @@ vec3_t project_vertex(vec3_t vertex, mat4_t world, mat4_t view, mat4_t proj,
     }
 
     // Convert to screen coordinates (flip Y-axis)
-    return (vec3_t){
-        (v_proj.x + 1.0f) * 0.5f * width,
-        (1.0f - v_proj.y) * 0.5f * height,
-        v_proj.z  // Preserve depth for sorting
+    return (vec3f_t){
+        .x = (v_proj.x + 1.0f) * 0.5f * width,
+        .y = (1.0f - v_proj.y) * 0.5f * height,
+        .z = v_proj.z  // Preserve depth for sorting
     };
 }
 
@@ -39,7 +42,7 @@ bool clip_to_circular_viewport(canvas_t* canvas, float x, float y) {
     return (dx*dx + dy*dy) <= (radius*radius);
 }
 
-// 3. Wireframe Rendering with Depth Sorting
+// 3. Wireframe Rendering with Clipping and Depth Sorting
 // Depth comparison function for qsort
 static int compare_edges(const void* a, const void* b) {
     const edge_depth_t* ea = a;
@@ -47,38 +50,415 @@ static int compare_edges(const void* a, const void* b) {
     return (ea->depth < eb->depth) - (ea->depth > eb->depth); // Back-to-front
 }
 
-void render_wireframe(canvas_t* canvas, const mesh_t* mesh,
-                     mat4_t world, mat4_t view, mat4_t proj) {
-    edge_depth_t* edges = malloc(mesh->num_edges * sizeof(edge_depth_t));
-    
-    // Project all edges and calculate depths
-    for (int i = 0; i < mesh->num_edges; i++) {
-        vec3_t v0 = project_vertex(mesh->edges[i].v0, world, view, proj,
-                                  canvas->width, canvas->height);
-        vec3_t v1 = project_vertex(mesh->edges[i].v1, world, view, proj,
-                                  canvas->width, canvas->height);
-        
-        edges[i] = (edge_depth_t){
-            .v0 = v0, 
-            .v1 = v1,
-            .depth = (v0.z + v1.z) / 2.0f  // Average depth
-        };
-    }
-
-    // Sort edges by depth (far to near)
-    qsort(edges, mesh->num_edges, sizeof(edge_depth_t), compare_edges);
-
-    // Draw visible edges
+// Vertex lies outside the near or far plane (clip w and NDC depth from the transform)
+static int outside_near(float w, float depth) {
+    return !(w > 1e-6f) || depth < -1.0f;
+}
+
+static int outside_far(float w, float depth) {
+    return w > 1e-6f && depth > 1.0f;
+}
+
+// Slow path for edges crossing the near/far planes: clip in homogeneous space,
+// then divide and map to the screen exactly as the transform kernels do
+static int clip_edge_homogeneous(const mat4_t* mvp, vec3f_t v0, vec3f_t v1,
+                                 int width, int height, segment_t* out, float* depth) {
+    vec4_t a = mat4_mul(mvp, (vec4_t){ v0.x, v0.y, v0.z, 1.0f });
+    vec4_t b = mat4_mul(mvp, (vec4_t){ v1.x, v1.y, v1.z, 1.0f });
+    if (!clip_homogeneous_near_far(&a, &b)) return 0;
+    if (!(a.w > 1e-6f) || !(b.w > 1e-6f)) return 0;
+
+    *out = (segment_t){
+        (a.x / a.w + 1.0f) * 0.5f * width, (1.0f - a.y / a.w) * 0.5f * height,
+        (b.x / b.w + 1.0f) * 0.5f * width, (1.0f - b.y / b.w) * 0.5f * height,
+        a.z / a.w, b.z / b.w
+    };
+    *depth = (out->z0 + out->z1) / 2.0f;
+    return 1;
+}
+
+// Clip every edge of a projected mesh: near/far in homogeneous space, then the
+// circular viewport. Returns the number of segments written; edges trimmed on
+// the way are added to *clipped.
+static int clip_edges(const canvas_t* canvas, const indexed_mesh_t* mesh, const mat4_t* mvp,
+                      const float* px, const float* py, const float* pz, const float* pw,
+                      segment_t* segments, float* depths, int* clipped) {
+    const int* indices = mesh->indices;
+    const float center_x = canvas->width / 2.0f;
+    const float center_y = canvas->height / 2.0f;
+    const float radius = fminf(canvas->width, canvas->height) / 2.0f;
+    int num_segments = 0, num_clipped = 0;
     for (int i = 0; i < mesh->num_edges; i++) {
-        vec3_t p0 = edges[i].v0;
-        vec3_t p1 = edges[i].v1;
-        
-        // Basic line clipping (checks both endpoints)
-        if (clip_to_circular_viewport(canvas, p0.x, p0.y) &&
-            clip_to_circular_viewport(canvas, p1.x, p1.y)) {
-            draw_line_f(canvas, p0.x, p0.y, p1.x, p1.y, 1.0f);
+        int i0 = indices[2*i];
+        int i1 = indices[2*i + 1];
+        segment_t seg;
+        float depth;
+
+        int near0 = outside_near(pw[i0], pz[i0]), near1 = outside_near(pw[i1], pz[i1]);
+        int far0 = outside_far(pw[i0], pz[i0]), far1 = outside_far(pw[i1], pz[i1]);
+        if ((near0 && near1) || (far0 && far1)) continue;
+
+        int trimmed = 0;
+        if (!near0 && !near1 && !far0 && !far1) {
+            seg = (segment_t){ px[i0], py[i0], px[i1], py[i1], pz[i0], pz[i1] };
+            depth = (pz[i0] + pz[i1]) / 2.0f;  // Average depth
+        } else if (!clip_edge_homogeneous(mvp, mesh->vertices[i0], mesh->vertices[i1],
+                                          canvas->width, canvas->height, &seg, &depth)) {
+            continue;
+        } else {
+            trimmed = 1;
         }
+
+        int inside = clip_segment_circle(&seg, center_x, center_y, radius);
+        if (!inside) continue;
+        num_clipped += trimmed || inside == 2;
+        segments[num_segments] = seg;
+        depths[num_segments] = depth;
+        num_segments++;
     }
-    
-    free(edges);
+    *clipped += num_clipped;
+    return num_segments;
+}
+
+// Add the arena's growth since `allocs` to the frame's counters
+static void profile_scratch(profile_t* profile, const arena_t* arena, unsigned long allocs) {
+    profile->frame.scratch_allocs += arena->heap_allocs - allocs;
+    size_t used = arena->used + arena->overflow_used;
+    if (used > profile->frame.scratch_bytes) profile->frame.scratch_bytes = used;
+}
+
+// Cull, project and clip a mesh's edges into segments/depths (room for
+// mesh->num_edges each). Returns the number of segments, or -1 if scratch
+// allocation failed.
+static int project_edges(canvas_t* canvas, arena_t* arena, profile_t* profile,
+                         const indexed_mesh_t* mesh, const mat4_t* mvp,
+                         segment_t* segments, float* depths) {
+    profile_mark_t mark = profile_mark(profile);
+
+    // Whole-mesh cull: skip projection entirely when the bounding sphere is off-screen
+    if (mesh->bounds_radius >= 0.0f) {
+        frustum_t frustum;
+        frustum_from_mvp(&frustum, mvp);
+        if (!frustum_sphere_visible(&frustum, mesh->bounds_center, mesh->bounds_radius)) {
+            if (profile) {
+                profile->frame.meshes_culled++;
+                profile_record(profile, PROFILE_PROJECT, mark);
+            }
+            return 0;
+        }
+    }
+
+    float* projected = arena_alloc(arena, mesh->num_vertices * 4 * sizeof(float));
+    if (!projected) return -1;
+    float* px = projected;
+    float* py = px + mesh->num_vertices;
+    float* pz = py + mesh->num_vertices;
+    float* pw = pz + mesh->num_vertices;
+
+    // Project each shared vertex exactly once through the combined MVP
+    transform_vertices_clip(mvp, mesh->vertices, mesh->num_vertices,
+                            canvas->width, canvas->height, px, py, pz, pw);
+    profile_stage_end(profile, PROFILE_PROJECT, mark);
+
+    mark = profile_mark(profile);
+    int clipped = 0;
+    int num_segments = clip_edges(canvas, mesh, mvp, px, py, pz, pw, segments, depths, &clipped);
+    if (profile) {
+        profile->frame.vertices_projected += mesh->num_vertices;
+        profile->frame.edges_culled += mesh->num_edges - num_segments;
+        profile->frame.edges_clipped += clipped;
+        profile_record(profile, PROFILE_CLIP, mark);
+    }
+    return num_segments;
+}
+
+// Estimated pixels a segment list covers: major-axis length times thickness
+static uint64_t estimate_pixels(const segment_t* segments, int count, float thickness) {
+    double pixels = 0.0;
+    for (int i = 0; i < count; i++) {
+        float dx = fabsf(segments[i].x1 - segments[i].x0);
+        float dy = fabsf(segments[i].y1 - segments[i].y0);
+        pixels += (double)(fmaxf(dx, dy) + 1.0f) * fmaxf(thickness, 1.0f);
+    }
+    return (uint64_t)pixels;
+}
+
+// Order the clipped segments back-to-front and rasterize them
+// (intensities may be NULL for full brightness)
+static void draw_segments(renderer_t* renderer, const segment_t* segments,
+                          const float* depths, const float* intensities, int num_segments) {
+    canvas_t* canvas = renderer->canvas;
+    arena_t* arena = &renderer->frame_arena;
+    profile_t* profile = renderer->profile;
+
+    // A depth buffer resolves occlusion per pixel, so the sort is skipped and
+    // segments go out as clipped
+    const segment_t* draw_list = segments;
+    const float* draw_intensities = intensities;
+    if (!canvas->depth) {
+        profile_mark_t mark = profile_mark(profile);
+        segment_t* sorted = arena_alloc(arena, (num_segments ? num_segments : 1) * sizeof(segment_t));
+        if (!sorted) return;
+        int* order;
+        if (renderer->sort_mode == RENDER_SORT_QSORT) {
+            edge_depth_t* edges = arena_alloc(arena, (num_segments ? num_segments : 1) * sizeof(edge_depth_t));
+            if (!edges) return;
+            for (int i = 0; i < num_segments; i++) {
+                edges[i] = (edge_depth_t){ .segment = i, .depth = depths[i] };
+            }
+
+            // Sort edges by depth (far to near)
+            qsort(edges, num_segments, sizeof(edge_depth_t), compare_edges);
+            order = arena_alloc(arena, (num_segments ? num_segments : 1) * sizeof(int));
+            if (!order) return;
+            for (int i = 0; i < num_segments; i++) order[i] = edges[i].segment;
+        } else {
+            // Radix sort the depth keys
+            order = depth_sort_back_to_front(arena, depths, num_segments);
+            if (!order) return;
+        }
+
+        // Walk the permutation
+        for (int i = 0; i < num_segments; i++) sorted[i] = segments[order[i]];
+        if (intensities) {
+            float* sorted_intensities = arena_alloc(arena, num_segments * sizeof(float));
+            if (!sorted_intensities) return;
+            for (int i = 0; i < num_segments; i++) sorted_intensities[i] = intensities[order[i]];
+            draw_intensities = sorted_intensities;
+        }
+        draw_list = sorted;
+        profile_stage_end(profile, PROFILE_SORT, mark);
+    }
+
+    // Rasterize
+    profile_mark_t mark = profile_mark(profile);
+    if (renderer->raster_mode == RENDER_RASTER_TILED) {
+        raster_segments_tiled_weighted(canvas, draw_list, draw_intensities, num_segments,
+                                       renderer->line_thickness, renderer->line_mode,
+                                       renderer->pool, arena);
+    } else {
+        raster_segments_weighted(canvas, draw_list, draw_intensities, num_segments,
+                                 renderer->line_thickness, renderer->line_mode);
+    }
+    if (profile) {
+        profile_record(profile, PROFILE_RASTER, mark);
+        profile->frame.edges_drawn += num_segments;
+        profile->frame.pixels_touched += estimate_pixels(draw_list, num_segments,
+                                                         renderer->line_thickness);
+    }
+}
+
+void renderer_draw_wireframe(renderer_t* renderer, const indexed_mesh_t* mesh,
+                             const mat4_t* world, const mat4_t* view, const mat4_t* proj) {
+    arena_t* arena = &renderer->frame_arena;
+    unsigned long allocs = arena->heap_allocs;
+
+    mat4_t mvp;
+    mat4_mvp(&mvp, world, view, proj);
+
+    segment_t* segments = arena_alloc(arena, mesh->num_edges * sizeof(segment_t));
+    float* depths = arena_alloc(arena, mesh->num_edges * sizeof(float));
+    if (segments && depths) {
+        int num_segments = project_edges(renderer->canvas, arena, renderer->profile, mesh, &mvp,
+                                         segments, depths);
+        if (num_segments > 0) draw_segments(renderer, segments, depths, NULL, num_segments);
+    }
+    if (renderer->profile) profile_scratch(renderer->profile, arena, allocs);
+}
+
+void renderer_draw_wireframe_cached(renderer_t* renderer, const indexed_mesh_t* mesh,
+                                    projection_cache_t* cache, const mat4_t* world,
+                                    const mat4_t* view, const mat4_t* proj) {
+    canvas_t* canvas = renderer->canvas;
+    unsigned long allocs = renderer->frame_arena.heap_allocs;
+
+    mat4_t mvp;
+    mat4_mvp(&mvp, world, view, proj);
+
+    if (!projection_cache_lookup(cache, mesh, &mvp, canvas->width, canvas->height)) {
+        if (projection_cache_reserve(cache, mesh->num_edges) != 0) return;
+        int num_segments = project_edges(canvas, &renderer->frame_arena, renderer->profile, mesh,
+                                         &mvp, cache->segments, cache->depths);
+        if (num_segments < 0) return;
+        projection_cache_store(cache, mesh, &mvp, canvas->width, canvas->height, num_segments);
+    }
+    if (cache->count > 0) {
+        draw_segments(renderer, cache->segments, cache->depths, NULL, cache->count);
+    }
+    if (renderer->profile) profile_scratch(renderer->profile, &renderer->frame_arena, allocs);
+}
+
+// Radius scale of an affine world matrix: the longest transformed basis axis
+static float max_axis_scale(const mat4_t* world) {
+    const float* m = world->m;
+    float sx = m[0]*m[0] + m[1]*m[1] + m[2]*m[2];
+    float sy = m[4]*m[4] + m[5]*m[5] + m[6]*m[6];
+    float sz = m[8]*m[8] + m[9]*m[9] + m[10]*m[10];
+    return sqrtf(fmaxf(sx, fmaxf(sy, sz)));
+}
+
+int renderer_draw_instances(renderer_t* renderer, const indexed_mesh_t* mesh,
+                             const mat4_t* worlds, const float* intensities, int count,
+                             const mat4_t* view, const mat4_t* proj) {
+    canvas_t* canvas = renderer->canvas;
+    arena_t* arena = &renderer->frame_arena;
+    profile_t* profile = renderer->profile;
+    const int num_vertices = mesh->num_vertices;
+    if (count <= 0 || mesh->num_edges == 0) return 0;
+    unsigned long allocs = arena->heap_allocs;
+    profile_mark_t mark = profile_mark(profile);
+
+    // Instances share one view-projection; its frustum planes are in world space
+    mat4_t vp;
+    mat4_multiply(&vp, proj, view);
+    frustum_t frustum;
+    frustum_from_mvp(&frustum, &vp);
+
+    // Cull whole instances by their world-space bounding spheres
+    mat4_t* visible = arena_alloc(arena, count * sizeof(mat4_t));
+    float* visible_intensity = arena_alloc(arena, count * sizeof(float));
+    if (!visible || !visible_intensity) return 0;
+    int num_visible = 0;
+    for (int i = 0; i < count; i++) {
+        if (mesh->bounds_radius >= 0.0f) {
+            const float* m = worlds[i].m;
+            vec3f_t c = mesh->bounds_center;
+            vec3f_t center = vec3f_make(m[0]*c.x + m[4]*c.y + m[8]*c.z + m[12],
+                                        m[1]*c.x + m[5]*c.y + m[9]*c.z + m[13],
+                                        m[2]*c.x + m[6]*c.y + m[10]*c.z + m[14]);
+            float radius = mesh->bounds_radius * max_axis_scale(&worlds[i]);
+            if (!frustum_sphere_visible(&frustum, center, radius)) continue;
+        }
+        visible[num_visible] = worlds[i];
+        visible_intensity[num_visible] = intensities ? intensities[i] : 1.0f;
+        num_visible++;
+    }
+    if (profile) profile->frame.meshes_culled += count - num_visible;
+    if (num_visible == 0) {
+        profile_stage_end(profile, PROFILE_PROJECT, mark);
+        return 0;
+    }
+
+    // Every instance's MVP in one batched multiply (overwrites the world copies)
+    mat4_multiply_batch(visible, &vp, visible, num_visible);
+
+    // Deinterleave the shared vertices once; each instance then runs the SoA kernel
+    float* soa = arena_alloc(arena, (size_t)num_vertices * 7 * sizeof(float));
+    size_t max_segments = (size_t)num_visible * mesh->num_edges;
+    segment_t* segments = arena_alloc(arena, max_segments * sizeof(segment_t));
+    float* depths = arena_alloc(arena, max_segments * sizeof(float));
+    float* segment_intensity = intensities ? arena_alloc(arena, max_segments * sizeof(float)) : NULL;
+    if (!soa || !segments || !depths || (intensities && !segment_intensity)) return 0;
+    float* vx = soa;
+    float* vy = vx + num_vertices;
+    float* vz = vy + num_vertices;
+    float* px = vz + num_vertices;
+    float* py = px + num_vertices;
+    float* pz = py + num_vertices;
+    float* pw = pz + num_vertices;
+    for (int i = 0; i < num_vertices; i++) {
+        vx[i] = mesh->vertices[i].x;
+        vy[i] = mesh->vertices[i].y;
+        vz[i] = mesh->vertices[i].z;
+    }
+
+    // Merge every instance's clipped edges into one list
+    int num_segments = 0, clipped = 0;
+    for (int k = 0; k < num_visible; k++) {
+        transform_vertices_soa_clip(&visible[k], vx, vy, vz, num_vertices,
+                                    canvas->width, canvas->height, px, py, pz, pw);
+        profile_stage_end(profile, PROFILE_PROJECT, mark);
+        mark = profile_mark(profile);
+        int added = clip_edges(canvas, mesh, &visible[k], px, py, pz, pw,
+                               segments + num_segments, depths + num_segments, &clipped);
+        if (segment_intensity) {
+            for (int i = 0; i < added; i++) segment_intensity[num_segments + i] = visible_intensity[k];
+        }
+        num_segments += added;
+        profile_stage_end(profile, PROFILE_CLIP, mark);
+        mark = profile_mark(profile);
+    }
+    if (profile) {
+        profile->frame.vertices_projected += (uint64_t)num_visible * num_vertices;
+        profile->frame.edges_culled += max_segments - num_segments;
+        profile->frame.edges_clipped += clipped;
+    }
+
+    // One sort (or depth-tested pass) across all instances
+    if (num_segments > 0) draw_segments(renderer, segments, depths, segment_intensity, num_segments);
+    if (profile) profile_scratch(profile, arena, allocs);
+    return num_visible;
+}
+
+int renderer_draw_lod(renderer_t* renderer, const mesh_lod_t* lod, const mat4_t* world,
+                      const mat4_t* view, const mat4_t* proj) {
+    float scale = mesh_lod_pixels_per_unit(lod, world, view, proj, renderer->canvas->height);
+    int level = mesh_lod_select(lod, scale, renderer->lod_pixel_error);
+    renderer_draw_wireframe(renderer, lod->levels[level].mesh, world, view, proj);
+    return level;
+}
+
+void renderer_draw_scene(renderer_t* renderer, scene_t* scene,
+                         const mat4_t* view, const mat4_t* proj) {
+    for (int i = 0; i < scene->count; i++) {
+        scene_node_t* node = &scene->nodes[i];
+        if (!node->mesh) continue;
+        renderer_draw_wireframe_cached(renderer, node->mesh, &node->cache, &node->world, view, proj);
+    }
+}
+
+// One-shot wrapper: a throwaway context, so scratch is heap-allocated per call
+void render_wireframe(canvas_t* canvas, const indexed_mesh_t* mesh,
+                     mat4_t world, mat4_t view, mat4_t proj) {
+    renderer_t renderer = {
+        .canvas = canvas,
+        .sort_mode = RENDER_SORT_RADIX,
+        .raster_mode = RENDER_RASTER_DIRECT,
+        .line_mode = RASTER_LINE_SPLAT,
+        .line_thickness = 1.0f,
+        .profile = profile_bound(),
+        .lod_pixel_error = 0.5f
+    };
+    arena_init(&renderer.frame_arena, 0);
+    renderer_draw_wireframe(&renderer, mesh, &world, &view, &proj);
+    arena_destroy(&renderer.frame_arena);
+}
+
+// 4. Renderer Context
+renderer_t* renderer_create(canvas_t* canvas) {
+    renderer_t* renderer = malloc(sizeof(renderer_t));
+    if (!renderer) return NULL;
+
+    renderer->canvas = canvas;
+    renderer->sort_mode = RENDER_SORT_RADIX;
+    renderer->raster_mode = RENDER_RASTER_DIRECT;
+    renderer->line_mode = RASTER_LINE_SPLAT;
+    renderer->line_thickness = 1.0f;
+    renderer->pool = NULL;
+    renderer->profile = NULL;
+    renderer->lod_pixel_error = 0.5f;
+    arena_init(&renderer->frame_arena, 0);
+    return renderer;
+}
+
+void renderer_destroy(renderer_t* renderer) {
+    if (renderer) {
+        threadpool_destroy(renderer->pool);
+        arena_destroy(&renderer->frame_arena);
+        free(renderer);
+    }
+}
+
+void renderer_begin_frame(renderer_t* renderer) {
+    arena_reset(&renderer->frame_arena);
+}
+
+int renderer_set_threads(renderer_t* renderer, int num_threads) {
+    threadpool_t* pool = threadpool_create(num_threads);
+    if (!pool) return -1;
+
+    threadpool_destroy(renderer->pool);
+    renderer->pool = pool;
+    renderer->raster_mode = RENDER_RASTER_TILED;
+    return 0;
 }
@@ -0,0 +1,161 @@
+#include <stdlib.h>
+#include <string.h>
+#include "scene.h"
+
+#define NODE_DIRTY   1  // Local transform changed since the last update
+#define NODE_BOUND   2  // Pose comes from an animation binding
+#define NODE_CHANGED 4  // World matrix recomputed in the current update pass
+
+static int grow(scene_t* scene, int capacity) {
+    scene_node_t* nodes = realloc(scene->nodes, sizeof(scene_node_t) * capacity);
+    if (!nodes) return -1;
+    scene->nodes = nodes;
+    int* parent = realloc(scene->parent, sizeof(int) * capacity);
+    if (!parent) return -1;
+    scene->parent = parent;
+    unsigned char* flags = realloc(scene->flags, capacity);
+    if (!flags) return -1;
+    scene->flags = flags;
+    scene->capacity = capacity;
+    return 0;
+}
+
+void scene_init(scene_t* scene, int initial_capacity) {
+    memset(scene, 0, sizeof(scene_t));
+    if (initial_capacity > 0) grow(scene, initial_capacity);
+}
+
+void scene_destroy(scene_t* scene) {
+    for (int i = 0; i < scene->count; i++) projection_cache_destroy(&scene->nodes[i].cache);
+    free(scene->nodes);
+    free(scene->parent);
+    free(scene->flags);
+    memset(scene, 0, sizeof(scene_t));
+}
+
+int scene_add_node(scene_t* scene, int parent) {
+    if (parent < -1 || parent >= scene->count) return -1;
+    if (scene->count == scene->capacity &&
+        grow(scene, scene->capacity ? scene->capacity * 2 : 64) != 0) {
+        return -1;
+    }
+
+    int index = scene->count++;
+    scene_node_t* node = &scene->nodes[index];
+    memset(node, 0, sizeof(scene_node_t));
+    node->scale = vec3f_make(1.0f, 1.0f, 1.0f);
+    mat4_identity(&node->world);
+    projection_cache_init(&node->cache);
+    scene->parent[index] = parent;
+    scene->flags[index] = NODE_DIRTY;
+    return index;
+}
+
+void scene_set_trs(scene_t* scene, int node, vec3f_t translation, vec3f_t rotation, vec3f_t scale) {
+    scene_node_t* n = &scene->nodes[node];
+    n->translation = translation;
+    n->rotation = rotation;
+    n->scale = scale;
+    scene->flags[node] |= NODE_DIRTY;
+}
+
+void scene_set_translation(scene_t* scene, int node, vec3f_t translation) {
+    scene->nodes[node].translation = translation;
+    scene->flags[node] |= NODE_DIRTY;
+}
+
+void scene_set_rotation(scene_t* scene, int node, vec3f_t rotation) {
+    scene->nodes[node].rotation = rotation;
+    scene->flags[node] |= NODE_DIRTY;
+}
+
+void scene_set_scale(scene_t* scene, int node, vec3f_t scale) {
+    scene->nodes[node].scale = scale;
+    scene->flags[node] |= NODE_DIRTY;
+}
+
+void scene_bind_object(scene_t* scene, int node, const animated_object_t* object) {
+    scene_node_t* n = &scene->nodes[node];
+    n->binding = object ? SCENE_BIND_OBJECT : SCENE_BIND_NONE;
+    n->object = object;
+    n->pool = NULL;
+    if (object) {
+        scene->flags[node] |= NODE_BOUND;
+    } else {
+        scene->flags[node] &= ~NODE_BOUND;
+    }
+}
+
+void scene_bind_pool(scene_t* scene, int node, const anim_pool_t* pool, anim_handle_t handle) {
+    scene_node_t* n = &scene->nodes[node];
+    n->binding = pool ? SCENE_BIND_POOL : SCENE_BIND_NONE;
+    n->object = NULL;
+    n->pool = pool;
+    n->handle = handle;
+    if (pool) {
+        scene->flags[node] |= NODE_BOUND;
+    } else {
+        scene->flags[node] &= ~NODE_BOUND;
+    }
+}
+
+void scene_set_mesh(scene_t* scene, int node, const indexed_mesh_t* mesh) {
+    scene->nodes[node].mesh = mesh;
+    projection_cache_invalidate(&scene->nodes[node].cache);
+}
+
+// Copy a value in and report whether it changed (bitwise, so NaN poses settle)
+static int assign_vec3(vec3f_t* dst, vec3f_t src) {
+    if (memcmp(dst, &src, sizeof(vec3f_t)) == 0) return 0;
+    *dst = src;
+    return 1;
+}
+
+// Pull the bound animation's pose into the node's local transform
+static void pull_binding(scene_t* scene, int node) {
+    scene_node_t* n = &scene->nodes[node];
+    int changed = 0;
+    if (n->binding == SCENE_BIND_OBJECT) {
+        changed |= assign_vec3(&n->translation, n->object->position);
+        changed |= assign_vec3(&n->rotation, n->object->rotation);
+        changed |= assign_vec3(&n->scale, n->object->scale);
+    } else if (n->binding == SCENE_BIND_POOL) {
+        int index = anim_pool_index(n->pool, n->handle);
+        if (index < 0) {
+            scene_bind_pool(scene, node, NULL, n->handle);  // Object was removed from the pool
+            return;
+        }
+        changed |= assign_vec3(&n->translation, n->pool->poses[index].position);
+        changed |= assign_vec3(&n->rotation, n->pool->poses[index].rotation);
+    }
+    if (changed) scene->flags[node] |= NODE_DIRTY;
+}
+
+int scene_update(scene_t* scene) {
+    const int* parent = scene->parent;
+    unsigned char* flags = scene->flags;
+    int recomputed = 0;
+    for (int i = 0; i < scene->count; i++) {
+        if (flags[i] & NODE_BOUND) pull_binding(scene, i);
+
+        // Parents come first, so their changed bit is already final
+        int stale = (flags[i] & NODE_DIRTY) || (parent[i] >= 0 && (flags[parent[i]] & NODE_CHANGED));
+        if (!stale) {
+            flags[i] &= ~NODE_CHANGED;
+            continue;
+        }
+
+        scene_node_t* n = &scene->nodes[i];
+        mat4_t local;
+        mat4_trs(&local, n->translation, n->rotation, n->scale);
+        if (parent[i] >= 0) {
+            mat4_multiply(&n->world, &scene->nodes[parent[i]].world, &local);
+        } else {
+            n->world = local;
+        }
+        n->world_version++;
+        flags[i] = (unsigned char)((flags[i] & ~NODE_DIRTY) | NODE_CHANGED);
+        recomputed++;
+    }
+    return recomputed;
+}
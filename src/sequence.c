@@ -0,0 +1,140 @@
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "sequence.h"
+#include "threadpool.h"
+#include "timebase.h"
+
+// One worker's private frame buffer and scratch
+typedef struct {
+    canvas_t* canvas;
+    renderer_t* renderer;
+    time_ns_t draw_ns;
+    time_ns_t wait_ns;
+} sequence_worker_t;
+
+typedef struct {
+    const sequence_desc_t* desc;
+    sequence_worker_t* workers;
+    atomic_int next_claim;     // Next frame (relative to first_frame) to render
+
+    pthread_mutex_t lock;
+    pthread_cond_t turn;
+    int next_emit;             // Next frame to hand to the destinations
+    int emitted;               // Frames the destinations accepted
+    int error;
+} sequence_job_t;
+
+void sequence_desc_init(sequence_desc_t* desc, int width, int height) {
+    *desc = (sequence_desc_t){
+        .width = width,
+        .height = height,
+        .format = CANVAS_FORMAT_FLOAT32,
+        .depth_format = DEPTH_FORMAT_FLOAT32,
+        .line_mode = RASTER_LINE_SPLAT,
+        .line_thickness = 1.0f,
+        .fps = 30.0
+    };
+}
+
+int sequence_worker_count(int num_threads) {
+    return num_threads > 0 ? num_threads : threadpool_cpu_count();
+}
+
+static int emit_frame(const sequence_desc_t* desc, const canvas_t* canvas, int frame) {
+    if (desc->sink && frame_sink_submit(desc->sink, canvas) != 0) return -1;
+    if (desc->output && desc->output(desc->output_user, canvas, frame) != 0) return -1;
+    return 0;
+}
+
+// Pool task: one per worker. Renders claimed frames into the worker's canvas
+// and emits each one once every earlier frame has been emitted. The lowest
+// unemitted frame always belongs to a worker that is not waiting, so the
+// ordering cannot deadlock.
+static void sequence_task(void* ctx, int task, int worker_index) {
+    (void)worker_index;
+    sequence_job_t* job = ctx;
+    const sequence_desc_t* desc = job->desc;
+    sequence_worker_t* worker = &job->workers[task];
+
+    for (;;) {
+        int index = atomic_fetch_add(&job->next_claim, 1);
+        if (index >= desc->num_frames) break;
+        int frame = desc->first_frame + index;
+
+        time_ns_t start = time_monotonic_ns();
+        if (!__atomic_load_n(&job->error, __ATOMIC_RELAXED)) {
+            renderer_begin_frame(worker->renderer);
+            canvas_clear(worker->canvas, desc->clear_value);
+            desc->draw(desc->user, worker->renderer, task, frame,
+                       desc->start_time + frame / desc->fps);
+        }
+        time_ns_t drawn = time_monotonic_ns();
+
+        pthread_mutex_lock(&job->lock);
+        while (job->next_emit != index) pthread_cond_wait(&job->turn, &job->lock);
+        time_ns_t ready = time_monotonic_ns();
+        if (!job->error) {
+            if (emit_frame(desc, worker->canvas, frame) == 0) job->emitted++;
+            else __atomic_store_n(&job->error, 1, __ATOMIC_RELAXED);
+        }
+        job->next_emit++;
+        pthread_cond_broadcast(&job->turn);
+        pthread_mutex_unlock(&job->lock);
+
+        worker->draw_ns += drawn - start;
+        worker->wait_ns += ready - drawn;
+    }
+}
+
+int sequence_render(const sequence_desc_t* desc, int num_threads, sequence_stats_t* stats) {
+    time_ns_t start = time_monotonic_ns();
+    int num_workers = sequence_worker_count(num_threads);
+    if (num_workers > desc->num_frames) num_workers = desc->num_frames > 0 ? desc->num_frames : 1;
+
+    sequence_job_t job = { .desc = desc };
+    atomic_init(&job.next_claim, 0);
+    job.workers = calloc((size_t)num_workers, sizeof(sequence_worker_t));
+    threadpool_t* pool = job.workers ? threadpool_create(num_workers) : NULL;
+    int result = pool ? 0 : -1;
+
+    for (int i = 0; i < num_workers && result == 0; i++) {
+        sequence_worker_t* worker = &job.workers[i];
+        worker->canvas = create_canvas_format(desc->width, desc->height, desc->format);
+        if (!worker->canvas ||
+            (desc->depth && canvas_attach_depth(worker->canvas, desc->depth_format) != 0) ||
+            !(worker->renderer = renderer_create(worker->canvas))) {
+            result = -1;
+            break;
+        }
+        worker->renderer->line_mode = desc->line_mode;
+        worker->renderer->line_thickness = desc->line_thickness;
+    }
+
+    int emitted = 0;
+    if (result == 0 && desc->num_frames > 0) {
+        pthread_mutex_init(&job.lock, NULL);
+        pthread_cond_init(&job.turn, NULL);
+        threadpool_run(pool, sequence_task, &job, num_workers);
+        pthread_cond_destroy(&job.turn);
+        pthread_mutex_destroy(&job.lock);
+        if (job.error) result = -1;
+        emitted = job.emitted;
+    }
+
+    if (stats) {
+        *stats = (sequence_stats_t){ .frames = emitted, .workers = num_workers };
+        for (int i = 0; job.workers && i < num_workers; i++) {
+            stats->draw_seconds += time_ns_to_seconds(job.workers[i].draw_ns);
+            stats->wait_seconds += time_ns_to_seconds(job.workers[i].wait_ns);
+        }
+    }
+    for (int i = 0; job.workers && i < num_workers; i++) {
+        renderer_destroy(job.workers[i].renderer);
+        free_canvas(job.workers[i].canvas);
+    }
+    free(job.workers);
+    threadpool_destroy(pool);
+    if (stats) stats->wall_seconds = time_ns_to_seconds(time_monotonic_ns() - start);
+    return result;
+}
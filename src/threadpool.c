@@ -0,0 +1,161 @@
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+#include "threadpool.h"
+
+struct threadpool {
+    int num_threads;           // Including the calling thread
+    pthread_t* workers;        // num_threads - 1 background threads
+
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    unsigned long generation;  // Bumped for every threadpool_run
+    int busy_workers;
+    int shutting_down;
+
+    // Current batch
+    threadpool_task_fn fn;
+    void* ctx;
+    int num_tasks;
+    atomic_int next_task;
+};
+
+typedef struct {
+    threadpool_t* pool;
+    int worker_index;
+} worker_arg_t;
+
+int threadpool_cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+// Claim and run tasks until the batch is exhausted
+static void run_tasks(threadpool_t* pool, int worker_index) {
+    for (;;) {
+        int task = atomic_fetch_add(&pool->next_task, 1);
+        if (task >= pool->num_tasks) break;
+        pool->fn(pool->ctx, task, worker_index);
+    }
+}
+
+static void* worker_main(void* arg) {
+    worker_arg_t* worker = arg;
+    threadpool_t* pool = worker->pool;
+    int worker_index = worker->worker_index;
+    free(worker);
+
+    unsigned long seen = 0;
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->shutting_down && pool->generation == seen) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->shutting_down) break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        run_tasks(pool, worker_index);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busy_workers == 0) pthread_cond_signal(&pool->work_done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+threadpool_t* threadpool_create(int num_threads) {
+    if (num_threads <= 0) num_threads = threadpool_cpu_count();
+
+    threadpool_t* pool = calloc(1, sizeof(threadpool_t));
+    if (!pool) return NULL;
+    pool->workers = calloc(num_threads, sizeof(pthread_t));
+    if (!pool->workers) {
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+    atomic_init(&pool->next_task, 0);
+
+    // Worker 0 is the calling thread; start the rest
+    pool->num_threads = 1;
+    for (int i = 1; i < num_threads; i++) {
+        worker_arg_t* arg = malloc(sizeof(worker_arg_t));
+        if (!arg) break;
+        arg->pool = pool;
+        arg->worker_index = i;
+        if (pthread_create(&pool->workers[i - 1], NULL, worker_main, arg) != 0) {
+            free(arg);
+            break;
+        }
+        pool->num_threads++;
+    }
+    return pool;
+}
+
+void threadpool_destroy(threadpool_t* pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutting_down = 1;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->num_threads - 1; i++) {
+        pthread_join(pool->workers[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->work_done);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+int threadpool_size(const threadpool_t* pool) {
+    return pool ? pool->num_threads : 1;
+}
+
+void threadpool_run(threadpool_t* pool, threadpool_task_fn fn, void* ctx, int num_tasks) {
+    if (num_tasks <= 0) return;
+
+    // No workers (or a single task): run inline without touching the lock
+    if (!pool || pool->num_threads == 1 || num_tasks == 1) {
+        for (int i = 0; i < num_tasks; i++) fn(ctx, i, 0);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->ctx = ctx;
+    pool->num_tasks = num_tasks;
+    atomic_store(&pool->next_task, 0);
+    pool->busy_workers = pool->num_threads - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    // The caller works too, then waits for the stragglers
+    run_tasks(pool, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busy_workers > 0) {
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
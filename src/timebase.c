@@ -0,0 +1,91 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L
+#endif
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include "timebase.h"
+
+time_ns_t time_monotonic_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    // Split to avoid overflowing counter * 1e9
+    time_ns_t seconds = counter.QuadPart / frequency.QuadPart;
+    time_ns_t rest = counter.QuadPart % frequency.QuadPart;
+    return seconds * TIME_NS_PER_SECOND + rest * TIME_NS_PER_SECOND / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (time_ns_t)ts.tv_sec * TIME_NS_PER_SECOND + ts.tv_nsec;
+#endif
+}
+
+void time_source_init_monotonic(time_source_t* source) {
+    source->manual = 0;
+    source->origin = time_monotonic_ns();
+    source->now = 0;
+}
+
+void time_source_init_manual(time_source_t* source, time_ns_t start) {
+    source->manual = 1;
+    source->origin = 0;
+    source->now = start;
+}
+
+time_ns_t time_source_now(const time_source_t* source) {
+    return source->manual ? source->now : time_monotonic_ns() - source->origin;
+}
+
+double time_source_seconds(const time_source_t* source) {
+    return time_ns_to_seconds(time_source_now(source));
+}
+
+void time_source_set(time_source_t* source, time_ns_t now) {
+    if (source->manual) source->now = now;
+}
+
+void time_source_advance(time_source_t* source, time_ns_t delta) {
+    if (source->manual) source->now += delta;
+}
+
+void tick_scheduler_init(tick_scheduler_t* scheduler, const time_source_t* source,
+                         time_ns_t step, int max_steps) {
+    scheduler->source = source;
+    scheduler->step = step > 0 ? step : 1;
+    scheduler->last = time_source_now(source);
+    scheduler->accumulator = 0;
+    scheduler->tick = 0;
+    scheduler->max_steps = max_steps > 0 ? max_steps : 1;
+}
+
+int tick_scheduler_advance(tick_scheduler_t* scheduler) {
+    time_ns_t now = time_source_now(scheduler->source);
+    time_ns_t elapsed = now - scheduler->last;
+    scheduler->last = now;
+    if (elapsed > 0) scheduler->accumulator += elapsed;
+
+    int64_t due = scheduler->accumulator / scheduler->step;
+    if (due > scheduler->max_steps) {
+        // Too far behind (e.g. after a stall): catch up partially, keep the phase
+        scheduler->accumulator %= scheduler->step;
+        due = scheduler->max_steps;
+    } else {
+        scheduler->accumulator -= due * scheduler->step;
+    }
+    scheduler->tick += due;
+    return (int)due;
+}
+
+double tick_scheduler_tick_time(const tick_scheduler_t* scheduler, int64_t tick) {
+    // Whole seconds and remainder separately keep ns precision for huge tick counts
+    time_ns_t ns = tick * scheduler->step;
+    return (double)(ns / TIME_NS_PER_SECOND) + time_ns_to_seconds(ns % TIME_NS_PER_SECOND);
+}
+
+float tick_scheduler_alpha(const tick_scheduler_t* scheduler) {
+    return (float)((double)scheduler->accumulator / (double)scheduler->step);
+}
@@ -0,0 +1,223 @@
+#include <math.h>
+#include "transform.h"
+#include "cpu.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TRANSFORM_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+// Scalar reference kernel
+static void transform_scalar(const mat4_t* mvp,
+                             const float* x, const float* y, const float* z, int count,
+                             int width, int height,
+                             float* out_x, float* out_y, float* out_depth, float* out_w) {
+    const float* m = mvp->m;
+    for (int i = 0; i < count; i++) {
+        float cx = m[0]*x[i] + m[4]*y[i] + m[8]*z[i]  + m[12];
+        float cy = m[1]*x[i] + m[5]*y[i] + m[9]*z[i]  + m[13];
+        float cz = m[2]*x[i] + m[6]*y[i] + m[10]*z[i] + m[14];
+        float cw = m[3]*x[i] + m[7]*y[i] + m[11]*z[i] + m[15];
+        if (out_w) out_w[i] = cw;
+
+        // Perspective divide with safety check
+        if (fabsf(cw) > 1e-6f) {
+            cx /= cw;
+            cy /= cw;
+            cz /= cw;
+        }
+
+        // Convert to screen coordinates (flip Y-axis)
+        out_x[i] = (cx + 1.0f) * 0.5f * width;
+        out_y[i] = (1.0f - cy) * 0.5f * height;
+        out_depth[i] = cz;
+    }
+}
+
+#ifdef TRANSFORM_HAVE_X86
+// SSE kernel: same operation order as the scalar kernel, 4 vertices at a time
+__attribute__((target("sse2")))
+static int transform_sse(const mat4_t* mvp,
+                         const float* x, const float* y, const float* z, int count,
+                         int width, int height,
+                         float* out_x, float* out_y, float* out_depth, float* out_w) {
+    const float* m = mvp->m;
+    __m128 c[16];
+    for (int k = 0; k < 16; k++) c[k] = _mm_set1_ps(m[k]);
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 eps = _mm_set1_ps(1e-6f);
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 w_scale = _mm_set1_ps((float)width);
+    const __m128 h_scale = _mm_set1_ps((float)height);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 vx = _mm_loadu_ps(x + i);
+        __m128 vy = _mm_loadu_ps(y + i);
+        __m128 vz = _mm_loadu_ps(z + i);
+
+        #define ROW(r) _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(c[r], vx), \
+                                  _mm_mul_ps(c[(r) + 4], vy)), _mm_mul_ps(c[(r) + 8], vz)), c[(r) + 12])
+        __m128 cx = ROW(0);
+        __m128 cy = ROW(1);
+        __m128 cz = ROW(2);
+        __m128 cw = ROW(3);
+        #undef ROW
+        if (out_w) _mm_storeu_ps(out_w + i, cw);
+
+        // Lanes with |w| <= eps divide by 1, i.e. keep clip coordinates
+        __m128 safe = _mm_cmpgt_ps(_mm_and_ps(cw, abs_mask), eps);
+        cw = _mm_or_ps(_mm_and_ps(safe, cw), _mm_andnot_ps(safe, one));
+        cx = _mm_div_ps(cx, cw);
+        cy = _mm_div_ps(cy, cw);
+        cz = _mm_div_ps(cz, cw);
+
+        _mm_storeu_ps(out_x + i, _mm_mul_ps(_mm_mul_ps(_mm_add_ps(cx, one), half), w_scale));
+        _mm_storeu_ps(out_y + i, _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(one, cy), half), h_scale));
+        _mm_storeu_ps(out_depth + i, cz);
+    }
+    return i;
+}
+
+// AVX2 kernel: 8 vertices at a time with fused multiply-adds
+__attribute__((target("avx2,fma")))
+static int transform_avx2(const mat4_t* mvp,
+                          const float* x, const float* y, const float* z, int count,
+                          int width, int height,
+                          float* out_x, float* out_y, float* out_depth, float* out_w) {
+    const float* m = mvp->m;
+    __m256 c[16];
+    for (int k = 0; k < 16; k++) c[k] = _mm256_set1_ps(m[k]);
+
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 eps = _mm256_set1_ps(1e-6f);
+    const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const __m256 w_scale = _mm256_set1_ps(0.5f * (float)width);
+    const __m256 h_scale = _mm256_set1_ps(0.5f * (float)height);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 vx = _mm256_loadu_ps(x + i);
+        __m256 vy = _mm256_loadu_ps(y + i);
+        __m256 vz = _mm256_loadu_ps(z + i);
+
+        #define ROW(r) _mm256_fmadd_ps(c[(r) + 8], vz, \
+                       _mm256_fmadd_ps(c[(r) + 4], vy, _mm256_fmadd_ps(c[r], vx, c[(r) + 12])))
+        __m256 cx = ROW(0);
+        __m256 cy = ROW(1);
+        __m256 cz = ROW(2);
+        __m256 cw = ROW(3);
+        #undef ROW
+        if (out_w) _mm256_storeu_ps(out_w + i, cw);
+
+        __m256 safe = _mm256_cmp_ps(_mm256_and_ps(cw, abs_mask), eps, _CMP_GT_OQ);
+        cw = _mm256_blendv_ps(one, cw, safe);
+        __m256 inv_w = _mm256_div_ps(one, cw);
+        cx = _mm256_mul_ps(cx, inv_w);
+        cy = _mm256_mul_ps(cy, inv_w);
+        cz = _mm256_mul_ps(cz, inv_w);
+
+        _mm256_storeu_ps(out_x + i, _mm256_fmadd_ps(cx, w_scale, w_scale));
+        _mm256_storeu_ps(out_y + i, _mm256_fnmadd_ps(cy, h_scale, h_scale));
+        _mm256_storeu_ps(out_depth + i, cz);
+    }
+    return i;
+}
+#endif
+
+transform_kernel_t transform_active_kernel(void) {
+    unsigned int features = cpu_features();
+    if ((features & CPU_FEATURE_AVX2) && (features & CPU_FEATURE_FMA)) {
+        return TRANSFORM_KERNEL_AVX2;
+    }
+    if (features & CPU_FEATURE_SSE2) return TRANSFORM_KERNEL_SSE;
+    return TRANSFORM_KERNEL_SCALAR;
+}
+
+const char* transform_kernel_name(transform_kernel_t kernel) {
+    switch (kernel) {
+        case TRANSFORM_KERNEL_SCALAR: return "scalar";
+        case TRANSFORM_KERNEL_SSE:    return "sse";
+        case TRANSFORM_KERNEL_AVX2:   return "avx2";
+        default:                      return "auto";
+    }
+}
+
+// Run the requested kernel (clamped to what the CPU allows); out_w may be NULL
+static void transform_dispatch(transform_kernel_t kernel, const mat4_t* mvp,
+                               const float* x, const float* y, const float* z, int count,
+                               int width, int height,
+                               float* out_x, float* out_y, float* out_depth, float* out_w) {
+    // Never run a kernel the CPU (or the feature mask) does not allow
+    transform_kernel_t best = transform_active_kernel();
+    if (kernel == TRANSFORM_KERNEL_AUTO || kernel > best) kernel = best;
+
+    int done = 0;
+#ifdef TRANSFORM_HAVE_X86
+    if (kernel == TRANSFORM_KERNEL_AVX2) {
+        done = transform_avx2(mvp, x, y, z, count, width, height,
+                              out_x, out_y, out_depth, out_w);
+    } else if (kernel == TRANSFORM_KERNEL_SSE) {
+        done = transform_sse(mvp, x, y, z, count, width, height,
+                             out_x, out_y, out_depth, out_w);
+    }
+#endif
+
+    // Scalar kernel handles the remainder (and everything without SIMD)
+    transform_scalar(mvp, x + done, y + done, z + done, count - done, width, height,
+                     out_x + done, out_y + done, out_depth + done,
+                     out_w ? out_w + done : NULL);
+}
+
+void transform_vertices_soa_kernel(transform_kernel_t kernel, const mat4_t* mvp,
+                                   const float* x, const float* y, const float* z, int count,
+                                   int width, int height,
+                                   float* out_x, float* out_y, float* out_depth) {
+    transform_dispatch(kernel, mvp, x, y, z, count, width, height,
+                       out_x, out_y, out_depth, NULL);
+}
+
+void transform_vertices_soa(const mat4_t* mvp,
+                            const float* x, const float* y, const float* z, int count,
+                            int width, int height,
+                            float* out_x, float* out_y, float* out_depth) {
+    transform_dispatch(TRANSFORM_KERNEL_AUTO, mvp, x, y, z, count,
+                       width, height, out_x, out_y, out_depth, NULL);
+}
+
+void transform_vertices_soa_clip(const mat4_t* mvp,
+                                 const float* x, const float* y, const float* z, int count,
+                                 int width, int height,
+                                 float* out_x, float* out_y, float* out_depth, float* out_w) {
+    transform_dispatch(TRANSFORM_KERNEL_AUTO, mvp, x, y, z, count,
+                       width, height, out_x, out_y, out_depth, out_w);
+}
+
+void transform_vertices_clip(const mat4_t* mvp, const vec3f_t* vertices, int count,
+                             int width, int height,
+                             float* out_x, float* out_y, float* out_depth, float* out_w) {
+    enum { BLOCK = 256 };
+    float bx[BLOCK], by[BLOCK], bz[BLOCK];
+    transform_kernel_t kernel = transform_active_kernel();
+
+    for (int start = 0; start < count; start += BLOCK) {
+        int n = count - start < BLOCK ? count - start : BLOCK;
+        for (int i = 0; i < n; i++) {
+            bx[i] = vertices[start + i].x;
+            by[i] = vertices[start + i].y;
+            bz[i] = vertices[start + i].z;
+        }
+        transform_dispatch(kernel, mvp, bx, by, bz, n, width, height,
+                           out_x + start, out_y + start, out_depth + start,
+                           out_w ? out_w + start : NULL);
+    }
+}
+
+void transform_vertices(const mat4_t* mvp, const vec3f_t* vertices, int count,
+                        int width, int height,
+                        float* out_x, float* out_y, float* out_depth) {
+    transform_vertices_clip(mvp, vertices, count, width, height,
+                            out_x, out_y, out_depth, NULL);
+}
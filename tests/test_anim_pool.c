@@ -0,0 +1,102 @@
+#include "../include/anim_pool.h"
+#include "../include/cpu.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// The pool must match animation_get_position and keep handles stable
+
+#define TOLERANCE 1e-4f
+
+static bezier_animation_t random_curve(void) {
+    bezier_animation_t anim = { 0 };
+    vec3f_t* p[4] = { &anim.p0, &anim.p1, &anim.p2, &anim.p3 };
+    for (int i = 0; i < 4; i++) {
+        *p[i] = vec3f_make(rand_range(-5, 5), rand_range(-5, 5), rand_range(-5, 5));
+    }
+    anim.duration = rand_range(0.5f, 4.0f);
+    anim.start_time = rand_range(-2.0f, 2.0f);
+    anim.loop = rand() % 2;
+    return anim;
+}
+
+static float diff(vec3f_t a, vec3f_t b) {
+    return fmaxf(fabsf(a.x - b.x), fmaxf(fabsf(a.y - b.y), fabsf(a.z - b.z)));
+}
+
+int main() {
+    enum { N = 1001 };
+    static bezier_animation_t pos[N], rot[N];
+    static anim_handle_t handles[N];
+    anim_pool_t pool;
+    anim_pool_init(&pool, 0);
+
+    srand(21);
+    for (int i = 0; i < N; i++) {
+        pos[i] = random_curve();
+        rot[i] = random_curve();
+        handles[i] = anim_pool_add(&pool, &pos[i], (i % 5 == 0) ? NULL : &rot[i]);
+    }
+
+    // Remove every third object; the remaining handles must still resolve
+    for (int i = 0; i < N; i += 3) {
+        if (anim_pool_remove(&pool, handles[i]) != 0) {
+            printf("FAIL: remove\n");
+            return 1;
+        }
+    }
+    if (anim_pool_remove(&pool, handles[0]) != -1 || anim_pool_valid(&pool, handles[0])) {
+        printf("FAIL: stale handle still valid\n");
+        return 1;
+    }
+    // A recycled slot must not revive the stale handle
+    anim_handle_t reused = anim_pool_add(&pool, &pos[0], NULL);
+    if (anim_pool_valid(&pool, handles[0]) || !anim_pool_valid(&pool, reused)) {
+        printf("FAIL: slot reuse\n");
+        return 1;
+    }
+    anim_pool_remove(&pool, reused);
+
+    const unsigned int masks[] = { 0, ~0u };
+    const float times[] = { -3.0f, 0.0f, 0.77f, 5.5f, 123.25f };
+    for (int m = 0; m < 2; m++) {
+        cpu_set_feature_mask(masks[m]);
+        for (int t = 0; t < 5; t++) {
+            anim_pool_update(&pool, times[t]);
+            for (int i = 0; i < N; i++) {
+                if (i % 3 == 0) continue;
+                int index = anim_pool_index(&pool, handles[i]);
+                if (index < 0) {
+                    printf("FAIL: live handle %d lost\n", i);
+                    return 1;
+                }
+                vec3f_t want_pos = animation_get_position(&pos[i], times[t]);
+                vec3f_t want_rot = (i % 5 == 0) ? vec3f_make(0, 0, 0)
+                                                : animation_get_position(&rot[i], times[t]);
+                const anim_pose_t* pose = &pool.poses[index];
+                if (diff(pose->position, want_pos) > TOLERANCE ||
+                    diff(pose->rotation, want_rot) > TOLERANCE) {
+                    printf("FAIL: object %d at t=%.2f differs from animation_get_position\n",
+                           i, times[t]);
+                    return 1;
+                }
+            }
+        }
+    }
+    cpu_set_feature_mask(~0u);
+
+    // Sync restarts every track
+    anim_pool_sync(&pool, 10.0f);
+    anim_pool_update(&pool, 10.0f);
+    int index = anim_pool_index(&pool, handles[1]);
+    if (diff(pool.poses[index].position, pos[1].p0) > TOLERANCE) {
+        printf("FAIL: sync\n");
+        return 1;
+    }
+
+    printf("Animation pool: %d live objects, capacity %d\n", pool.count, pool.capacity);
+    anim_pool_destroy(&pool);
+    printf("Animation pool tests passed\n");
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "../include/animation.h"
+#include <stdio.h>
+#include <math.h>
+
+static float distance(vec3f_t a, vec3f_t b) {
+    return vec3f_length(vec3f_sub(a, b));
+}
+
+int main() {
+    // A deliberately uneven curve: fast start, slow end
+    vec3f_t p0 = { 0, 0, 0 }, p1 = { 8, 4, 0 }, p2 = { 9, 5, 1 }, p3 = { 10, 5, 1 };
+    bezier_animation_t* anim = animation_create(&p0, &p1, &p2, &p3, 1.0f, 0);
+
+    // Table lookups stay within the requested error bound of the exact curve
+    const float bounds[] = { 1e-1f, 1e-2f, 1e-3f };
+    for (int b = 0; b < 3; b++) {
+        animation_set_sample_mode(anim, BEZIER_SAMPLE_TABLE, bounds[b]);
+        float worst = 0.0f;
+        for (int i = 0; i <= 1000; i++) {
+            float t = i / 1000.0f;
+            vec3f_t exact = vec3_bezier(&anim->p0, &anim->p1, &anim->p2, &anim->p3, t);
+            worst = fmaxf(worst, distance(animation_sample(anim, t), exact));
+        }
+        printf("Bound %.0e: %d segments, max error %.2e\n", bounds[b], anim->table->segments, worst);
+        if (worst > bounds[b]) {
+            printf("FAIL: table error %g exceeds bound %g\n", worst, bounds[b]);
+            return 1;
+        }
+    }
+
+    // Arc length agrees with a dense numerical integration
+    double reference = 0.0;
+    vec3f_t prev = p0;
+    for (int i = 1; i <= 100000; i++) {
+        vec3f_t cur = vec3_bezier(&p0, &p1, &p2, &p3, i / 100000.0f);
+        reference += distance(cur, prev);
+        prev = cur;
+    }
+    float length = animation_arc_length(anim);
+    if (fabs(length - reference) > 1e-3 * reference) {
+        printf("FAIL: arc length %f, expected %f\n", length, reference);
+        return 1;
+    }
+
+    // Uniform mode: equal steps in t cover equal distances along the path
+    animation_set_sample_mode(anim, BEZIER_SAMPLE_UNIFORM, 1e-4f);
+    const int steps = 50;
+    float step_length = length / steps;
+    vec3f_t last = animation_sample(anim, 0.0f);
+    for (int i = 1; i <= steps; i++) {
+        vec3f_t cur = animation_sample(anim, (float)i / steps);
+        float d = distance(cur, last);
+        if (fabsf(d - step_length) > 0.01f * step_length) {
+            printf("FAIL: uniform step %d covers %f, expected %f\n", i, d, step_length);
+            return 1;
+        }
+        last = cur;
+    }
+    if (distance(last, p3) > 1e-4f) {
+        printf("FAIL: uniform path does not end at p3\n");
+        return 1;
+    }
+
+    // Editing control points in place invalidates the cached table
+    const bezier_table_t* before = anim->table;
+    anim->p3.x = 20.0f;
+    vec3f_t end = animation_sample(anim, 1.0f);
+    if (anim->table == before && end.x != 20.0f) {
+        printf("FAIL: stale table after editing p3\n");
+        return 1;
+    }
+    if (fabsf(end.x - 20.0f) > 1e-4f) {
+        printf("FAIL: rebaked table ends at x=%f\n", end.x);
+        return 1;
+    }
+    vec3f_t q3 = { 0, 0, 0 };
+    animation_set_control_points(anim, &p0, &p1, &p2, &q3);
+    if (anim->table != NULL) {
+        printf("FAIL: setter did not invalidate the table\n");
+        return 1;
+    }
+
+    animation_destroy(anim);
+    printf("Bezier table tests passed\n");
+    return 0;
+}
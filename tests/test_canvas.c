@@ -0,0 +1,64 @@
+#include "../include/canvas.h"
+#include <stdio.h>
+
+#define SIZE 4
+
+// Pixel (x, y) holds y * SIZE + x, in the canvas's own units
+static void fill(canvas_t* canvas) {
+    for (int y = 0; y < SIZE; y++) {
+        for (int x = 0; x < SIZE; x++) {
+            int v = y * SIZE + x;
+            if (canvas->format == CANVAS_FORMAT_UNORM16) canvas_row16(canvas, y)[x] = (uint16_t)v;
+            else canvas_row(canvas, y)[x] = (float)v;
+        }
+    }
+}
+
+static int value(const canvas_t* canvas, int x, int y) {
+    if (canvas->format == CANVAS_FORMAT_UNORM16) return canvas_row16(canvas, y)[x];
+    return (int)canvas_row(canvas, y)[x];
+}
+
+// Blit the canvas onto itself and compare against a copy made from a snapshot
+static int check_self_blit(canvas_format_t format, const char* name, int src_x, int src_y,
+                           int width, int height, int dst_x, int dst_y) {
+    canvas_t* canvas = create_canvas_format(SIZE, SIZE, format);
+    fill(canvas);
+    int expected[SIZE][SIZE];
+    for (int y = 0; y < SIZE; y++) {
+        for (int x = 0; x < SIZE; x++) expected[y][x] = value(canvas, x, y);
+    }
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) expected[dst_y + y][dst_x + x] = (src_y + y) * SIZE + src_x + x;
+    }
+
+    canvas_blit(canvas, canvas, src_x, src_y, width, height, dst_x, dst_y);
+    for (int y = 0; y < SIZE; y++) {
+        for (int x = 0; x < SIZE; x++) {
+            if (value(canvas, x, y) != expected[y][x]) {
+                printf("FAIL: %s self-blit (%d, %d) -> (%d, %d): pixel (%d, %d) is %d, expected %d\n",
+                       name, src_x, src_y, dst_x, dst_y, x, y, value(canvas, x, y), expected[y][x]);
+                free_canvas(canvas);
+                return 1;
+            }
+        }
+    }
+    free_canvas(canvas);
+    return 0;
+}
+
+int main() {
+    const canvas_format_t formats[] = { CANVAS_FORMAT_FLOAT32, CANVAS_FORMAT_UNORM16 };
+    const char* names[] = { "float32", "unorm16" };
+    int failures = 0;
+    for (int f = 0; f < 2; f++) {
+        failures += check_self_blit(formats[f], names[f], 0, 0, 1, 3, 0, 1);  // Column down
+        failures += check_self_blit(formats[f], names[f], 0, 0, 4, 3, 0, 1);  // Rows down
+        failures += check_self_blit(formats[f], names[f], 0, 1, 4, 3, 0, 0);  // Rows up
+        failures += check_self_blit(formats[f], names[f], 0, 0, 3, 3, 1, 1);  // Down and right
+        failures += check_self_blit(formats[f], names[f], 1, 1, 3, 3, 0, 0);  // Up and left
+    }
+    if (failures) return 1;
+    printf("Canvas test completed.\n");
+    return 0;
+}
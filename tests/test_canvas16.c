@@ -0,0 +1,190 @@
+#include "../include/renderer.h"
+#include "../include/raster.h"
+#include "../include/cpu.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Largest 8-bit output difference between two canvases, and the mean
+// brightness difference
+static int compare_output(const canvas_t* a, const canvas_t* b, double* mean_error) {
+    unsigned char* qa = malloc(a->width);
+    unsigned char* qb = malloc(a->width);
+    int worst = 0;
+    double sum = 0.0;
+    for (int y = 0; y < a->height; y++) {
+        canvas_quantize_row_u8(a, y, qa);
+        canvas_quantize_row_u8(b, y, qb);
+        for (int x = 0; x < a->width; x++) {
+            int d = abs(qa[x] - qb[x]);
+            if (d > worst) worst = d;
+            float fa = fminf(canvas_get_pixel(a, x, y), 1.0f);
+            float fb = fminf(canvas_get_pixel(b, x, y), 1.0f);
+            sum += fabsf(fa - fb);
+        }
+    }
+    free(qa);
+    free(qb);
+    *mean_error = sum / ((double)a->width * a->height);
+    return worst;
+}
+
+int main() {
+    const unsigned int masks[] = { 0u, CPU_FEATURE_SSE2, ~0u };
+    const char* mask_names[] = { "scalar", "sse2", "auto" };
+
+    // Conversion to 8-bit matches round(v * 255 / 65535) for every value
+    uint16_t* all = malloc(sizeof(uint16_t) * 65536);
+    unsigned char* out = malloc(65536);
+    for (int v = 0; v < 65536; v++) all[v] = (uint16_t)v;
+    for (int m = 0; m < 3; m++) {
+        cpu_set_feature_mask(masks[m]);
+        canvas_quantize16_u8(all, out, 65536);
+        for (int v = 0; v < 65536; v++) {
+            if (out[v] != (unsigned char)floor(v * 255.0 / 65535.0 + 0.5)) {
+                printf("FAIL: %s quantize16 of %d gave %d\n", mask_names[m], v, out[v]);
+                return 1;
+            }
+        }
+    }
+    cpu_set_feature_mask(~0u);
+    free(all);
+    free(out);
+    printf("quantize16: exact for all 65536 values\n");
+
+    // Accumulation saturates instead of wrapping
+    canvas_t* small = create_canvas_format(8, 8, CANVAS_FORMAT_UNORM16);
+    if (!small || small->data16 == NULL || small->data != NULL || small->stride % 32 != 0) {
+        printf("FAIL: bad fixed-point canvas layout\n");
+        return 1;
+    }
+    for (int i = 0; i < 10; i++) set_pixel_f(small, 3.0f, 3.0f, 0.3f);
+    if (canvas_row16(small, 3)[3] != CANVAS_UNORM16_MAX) {
+        printf("FAIL: saturating add gave %d\n", canvas_row16(small, 3)[3]);
+        return 1;
+    }
+    canvas_clear(small, 0.5f);
+    if (canvas_row16(small, 7)[7] != 32768 || fabsf(canvas_get_pixel(small, 0, 0) - 0.5f) > 1e-4f) {
+        printf("FAIL: clear to 0.5 gave %d\n", canvas_row16(small, 7)[7]);
+        return 1;
+    }
+    canvas_t* small_float = create_canvas(8, 8);
+    if (canvas_copy(small_float, small) != -1) {
+        printf("FAIL: copy between formats accepted\n");
+        return 1;
+    }
+    free_canvas(small_float);
+    free_canvas(small);
+
+    // Random lines, some off-canvas, drawn on both formats
+    const int width = 640, height = 480;
+    enum { NUM_LINES = 3000 };
+    segment_t* segments = malloc(sizeof(segment_t) * NUM_LINES);
+    srand(16);
+    for (int i = 0; i < NUM_LINES; i++) {
+        segments[i] = (segment_t){
+            (float)rand() / RAND_MAX * (width + 200) - 100,
+            (float)rand() / RAND_MAX * (height + 200) - 100,
+            (float)rand() / RAND_MAX * (width + 200) - 100,
+            (float)rand() / RAND_MAX * (height + 200) - 100,
+            (float)rand() / RAND_MAX * 2.0f - 1.0f,
+            (float)rand() / RAND_MAX * 2.0f - 1.0f
+        };
+    }
+
+    canvas_t* reference = create_canvas_format(width, height, CANVAS_FORMAT_UNORM16);
+    canvas_t* fixed = create_canvas_format(width, height, CANVAS_FORMAT_UNORM16);
+    canvas_t* floats = create_canvas(width, height);
+    const float thicknesses[] = { 1.0f, 3.0f };
+    const raster_line_mode_t modes[] = { RASTER_LINE_SPLAT, RASTER_LINE_AA };
+    for (int m = 0; m < 2; m++) {
+        for (int t = 0; t < 2; t++) {
+            const char* mode = modes[m] == RASTER_LINE_AA ? "aa" : "splat";
+
+            // SIMD kernels are bit-identical to the scalar path
+            cpu_set_feature_mask(0);
+            canvas_clear(reference, 0.0f);
+            raster_segments(reference, segments, NUM_LINES, thicknesses[t], modes[m]);
+            for (int k = 1; k < 3; k++) {
+                cpu_set_feature_mask(masks[k]);
+                canvas_clear(fixed, 0.0f);
+                raster_segments(fixed, segments, NUM_LINES, thicknesses[t], modes[m]);
+                if (!canvases_identical(reference, fixed)) {
+                    printf("FAIL: %s thickness %.0f: %s differs from scalar\n", mode,
+                           thicknesses[t], mask_names[k]);
+                    return 1;
+                }
+            }
+            cpu_set_feature_mask(~0u);
+
+            // Within one 8-bit step of the float canvas
+            canvas_clear(floats, 0.0f);
+            raster_segments(floats, segments, NUM_LINES, thicknesses[t], modes[m]);
+            double mean_error;
+            int worst = compare_output(fixed, floats, &mean_error);
+            printf("%s thickness %.0f: SIMD bit-identical, vs float max %d/255, mean %.2e\n",
+                   mode, thicknesses[t], worst, mean_error);
+            if (worst > 1 || mean_error > 1e-5) {
+                printf("FAIL: fixed-point output outside the error budget\n");
+                return 1;
+            }
+        }
+    }
+
+    // Tiled rasterization and depth testing work on fixed-point canvases
+    mat4_t world, view, proj;
+    mat4_rotate_xyz(&world, 0.4f, 0.9f, 0.0f);
+    mat4_translate(&view, 0.0f, 0.0f, -4.0f);
+    mat4_frustum_asymmetric(&proj, -0.5f, 0.5f, -0.375f, 0.375f, 1.0f, 20.0f);
+    indexed_mesh_t* mesh = random_mesh(400, 2000);
+
+    for (int d = 0; d < 2; d++) {
+        if (d) {
+            canvas_attach_depth(reference, DEPTH_FORMAT_FLOAT32);
+            canvas_attach_depth(fixed, DEPTH_FORMAT_FLOAT32);
+            canvas_attach_depth(floats, DEPTH_FORMAT_FLOAT32);
+        }
+        renderer_t* renderer = renderer_create(reference);
+        canvas_clear(reference, 0.0f);
+        renderer_draw_wireframe(renderer, mesh, &world, &view, &proj);
+
+        renderer->canvas = floats;
+        renderer_begin_frame(renderer);
+        canvas_clear(floats, 0.0f);
+        renderer_draw_wireframe(renderer, mesh, &world, &view, &proj);
+
+        renderer->canvas = fixed;
+        renderer_set_threads(renderer, 3);
+        renderer_begin_frame(renderer);
+        canvas_clear(fixed, 0.0f);
+        renderer_draw_wireframe(renderer, mesh, &world, &view, &proj);
+        renderer_destroy(renderer);
+
+        double mean_error;
+        int worst = compare_output(fixed, floats, &mean_error);
+        int same = canvases_identical(reference, fixed);
+        printf("renderer%s: tiled %s, vs float max %d/255, mean %.2e\n", d ? " with depth" : "",
+               same ? "bit-identical" : "FAIL: differs", worst, mean_error);
+        if (!same || worst > 1 || mean_error > 1e-5) return 1;
+    }
+
+    // Output files and frames go through the direct converter
+    unsigned char* row = malloc(width);
+    canvas_quantize_row_u8(fixed, 100, row);
+    for (int x = 0; x < width; x++) {
+        if (row[x] != (canvas_row16(fixed, 100)[x] + 128) / 257) {
+            printf("FAIL: row conversion differs at %d\n", x);
+            return 1;
+        }
+    }
+    free(row);
+
+    indexed_mesh_destroy(mesh);
+    free(segments);
+    free_canvas(reference);
+    free_canvas(fixed);
+    free_canvas(floats);
+    printf("Fixed-point canvas test completed.\n");
+    return 0;
+}
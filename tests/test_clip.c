@@ -0,0 +1,129 @@
+#include "../include/clip.h"
+#include "../include/canvas.h"
+#include "../include/renderer.h"
+#include "../include/timebase.h"
+#include <stdio.h>
+#include <math.h>
+
+static int near_eq(float a, float b) {
+    return fabsf(a - b) < 1e-3f;
+}
+
+static int count_lit(const canvas_t* canvas) {
+    int lit = 0;
+    for (int y = 0; y < canvas->height; ++y) {
+        for (int x = 0; x < canvas->width; ++x) {
+            if (canvas->pixels[y][x] > 0.0f) lit++;
+        }
+    }
+    return lit;
+}
+
+int main() {
+    // Line-circle: a chord through the center is trimmed to the diameter
+    segment_t seg = { .x0 = 0.0f, .y0 = 50.0f, .x1 = 100.0f, .y1 = 50.0f };
+    if (!clip_segment_circle(&seg, 50.0f, 50.0f, 25.0f) ||
+        !near_eq(seg.x0, 25.0f) || !near_eq(seg.x1, 75.0f) ||
+        !near_eq(seg.y0, 50.0f) || !near_eq(seg.y1, 50.0f)) {
+        printf("FAIL: chord trimmed to (%.3f, %.3f)-(%.3f, %.3f)\n", seg.x0, seg.y0, seg.x1, seg.y1);
+        return 1;
+    }
+
+    // Segments entirely inside are untouched; entirely outside are rejected
+    segment_t inside = { .x0 = 40.0f, .y0 = 45.0f, .x1 = 60.0f, .y1 = 55.0f };
+    segment_t kept = inside;
+    if (!clip_segment_circle(&kept, 50.0f, 50.0f, 25.0f) ||
+        kept.x0 != inside.x0 || kept.y0 != inside.y0 || kept.x1 != inside.x1 || kept.y1 != inside.y1) {
+        printf("FAIL: inside segment was modified\n");
+        return 1;
+    }
+    segment_t outside = { .x0 = 0.0f, .y0 = 0.0f, .x1 = 10.0f, .y1 = 0.0f };
+    if (clip_segment_circle(&outside, 50.0f, 50.0f, 25.0f)) {
+        printf("FAIL: outside segment was kept\n");
+        return 1;
+    }
+
+    mat4_t identity, view, proj, mvp;
+    mat4_identity(&identity);
+    mat4_identity(&view);
+    mat4_frustum_asymmetric(&proj, -1, 1, -1, 1, 1.0f, 10.0f);
+    mat4_mvp(&mvp, &identity, &view, &proj);
+
+    // Homogeneous near clip: an edge from in front of the camera to behind it
+    vec4_t a = mat4_mul(&mvp, (vec4_t){ 0.5f, 0.0f, -5.0f, 1.0f });
+    vec4_t b = mat4_mul(&mvp, (vec4_t){ 0.5f, 0.0f, 5.0f, 1.0f });
+    if (!clip_homogeneous_near_far(&a, &b) || b.w <= 0.0f || fabsf(b.z + b.w) > 1e-4f) {
+        printf("FAIL: near clip left z=%.5f w=%.5f\n", b.z, b.w);
+        return 1;
+    }
+    vec4_t c = mat4_mul(&mvp, (vec4_t){ 0.0f, 0.0f, 1.0f, 1.0f });
+    vec4_t d = mat4_mul(&mvp, (vec4_t){ 0.0f, 0.0f, 5.0f, 1.0f });
+    if (clip_homogeneous_near_far(&c, &d)) {
+        printf("FAIL: edge behind the camera survived near clipping\n");
+        return 1;
+    }
+
+    // Bounding-sphere cull
+    frustum_t frustum;
+    frustum_from_mvp(&frustum, &mvp);
+    if (!frustum_sphere_visible(&frustum, vec3f_make(0.0f, 0.0f, -5.0f), 1.0f) ||
+        frustum_sphere_visible(&frustum, vec3f_make(100.0f, 0.0f, -5.0f), 1.0f) ||
+        frustum_sphere_visible(&frustum, vec3f_make(0.0f, 0.0f, 5.0f), 1.0f) ||
+        frustum_sphere_visible(&frustum, vec3f_make(0.0f, 0.0f, -20.0f), 1.0f)) {
+        printf("FAIL: bounding-sphere visibility\n");
+        return 1;
+    }
+
+    // Renderer: an edge crossing the camera plane is clipped, not dropped or smeared
+    canvas_t* canvas = create_canvas(200, 200);
+    indexed_mesh_t* mesh = indexed_mesh_create(2, 1);
+    mesh->vertices[0] = vec3f_make(0.5f, 0.0f, -5.0f);
+    mesh->vertices[1] = vec3f_make(0.5f, 0.0f, 5.0f);
+    mesh->indices[0] = 0;
+    mesh->indices[1] = 1;
+    indexed_mesh_compute_bounds(mesh);
+    render_wireframe(canvas, mesh, identity, view, proj);
+    int lit = count_lit(canvas);
+    printf("Lit pixels (near-clipped edge): %d\n", lit);
+    if (lit == 0) {
+        printf("FAIL: near-clipped edge drew nothing\n");
+        return 1;
+    }
+    for (int y = 0; y < canvas->height; ++y) {
+        for (int x = 0; x < canvas->width; ++x) {
+            if (canvas->pixels[y][x] > 0.0f && x < canvas->width / 2) {
+                printf("FAIL: clipped edge leaked to the left half at (%d, %d)\n", x, y);
+                return 1;
+            }
+        }
+    }
+
+    // Off-screen mesh is culled before projection
+    canvas_clear(canvas, 0.0f);
+    mesh->vertices[0] = vec3f_make(100.0f, 0.0f, -5.0f);
+    mesh->vertices[1] = vec3f_make(101.0f, 0.0f, -5.0f);
+    indexed_mesh_compute_bounds(mesh);
+    render_wireframe(canvas, mesh, identity, view, proj);
+    if (count_lit(canvas) != 0) {
+        printf("FAIL: off-screen mesh drew pixels\n");
+        return 1;
+    }
+
+    // Near-horizontal AA line far off-canvas: the column bound must not overflow int
+    canvas_t* large = create_canvas(1920, 1080);
+    time_ns_t start = time_monotonic_ns();
+    draw_line_aa(large, 0.0f, -1000.0f, 1000.0f, -999.9999f, 1.0f, 1.0f);
+    draw_line_aa(large, 0.0f, 3000.0f, 1000.0f, 3000.0001f, 1.0f, 1.0f);
+    draw_line_aa(large, 0.0f, -1000.0f, 1000.0f, -999.9999f, 3.0f, 1.0f);
+    double elapsed_ms = (double)(time_monotonic_ns() - start) / 1e6;
+    if (count_lit(large) != 0 || elapsed_ms > 100.0) {
+        printf("FAIL: off-canvas AA line drew %d pixels in %.1f ms\n", count_lit(large), elapsed_ms);
+        return 1;
+    }
+    free_canvas(large);
+
+    indexed_mesh_destroy(mesh);
+    free_canvas(canvas);
+    printf("Clip tests passed\n");
+    return 0;
+}
@@ -0,0 +1,199 @@
+#include "../include/renderer.h"
+#include "../include/raster.h"
+#include "../include/depth_buffer.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static int depths_identical(const depth_buffer_t* a, const depth_buffer_t* b) {
+    for (int y = 0; y < a->height; y++) {
+        for (int x = 0; x < a->width; x++) {
+            if (depth_buffer_read(a, x, y) != depth_buffer_read(b, x, y)) return 0;
+        }
+    }
+    return 1;
+}
+
+static const char* format_name(depth_format_t format) {
+    return format == DEPTH_FORMAT_UNORM16 ? "unorm16" : "float32";
+}
+
+static void draw(canvas_t* canvas, raster_line_mode_t mode, float thickness,
+                 float x0, float y0, float z0, float x1, float y1, float z1) {
+    segment_t s = { x0, y0, x1, y1, z0, z1 };
+    raster_segments(canvas, &s, 1, thickness, mode);
+}
+
+int main() {
+    const depth_format_t formats[] = { DEPTH_FORMAT_FLOAT32, DEPTH_FORMAT_UNORM16 };
+    const raster_line_mode_t modes[] = { RASTER_LINE_SPLAT, RASTER_LINE_AA };
+    const float thicknesses[] = { 1.0f, 3.0f };
+
+    canvas_t* canvas = create_canvas(200, 150);
+    canvas_t* reference = create_canvas(200, 150);
+
+    for (int f = 0; f < 2; f++) {
+        if (canvas_attach_depth(canvas, formats[f]) != 0) {
+            printf("FAIL: could not attach a %s depth buffer\n", format_name(formats[f]));
+            return 1;
+        }
+
+        // Hierarchical clear: nothing is touched until a fragment lands
+        canvas_clear(canvas, 0.0f);
+        for (int t = 0; t < canvas->depth->tiles_x * canvas->depth->tiles_y; t++) {
+            if (canvas->depth->tile_ready[t]) {
+                printf("FAIL: %s tile %d ready after clear\n", format_name(formats[f]), t);
+                return 1;
+            }
+        }
+        if (depth_buffer_read(canvas->depth, 10, 10) != 1.0f) {
+            printf("FAIL: cleared depth is not the far plane\n");
+            return 1;
+        }
+
+        // Depth is interpolated along the line
+        draw(canvas, RASTER_LINE_AA, 1.0f, -10.0f, 20.0f, -1.0f, 210.0f, 20.0f, 1.0f);
+        float mid = depth_buffer_read(canvas->depth, 100, 20);
+        if (fabsf(mid) > 1e-3f) {
+            printf("FAIL: %s mid-line depth %f, expected 0\n", format_name(formats[f]), mid);
+            return 1;
+        }
+        int touched = 0;
+        for (int t = 0; t < canvas->depth->tiles_x * canvas->depth->tiles_y; t++) {
+            touched += canvas->depth->tile_ready[t];
+        }
+        if (touched != canvas->depth->tiles_x) {
+            printf("FAIL: a horizontal line readied %d tiles, expected %d\n",
+                   touched, canvas->depth->tiles_x);
+            return 1;
+        }
+
+        for (int m = 0; m < 2; m++) {
+            for (int k = 0; k < 2; k++) {
+                // A sloped line with changing depth must not occlude itself
+                canvas_clear(canvas, 0.0f);
+                canvas_clear(reference, 0.0f);
+                draw(canvas, modes[m], thicknesses[k], 5.0f, 7.0f, 0.9f, 190.0f, 140.0f, -0.9f);
+                draw(reference, modes[m], thicknesses[k], 5.0f, 7.0f, 0.0f, 190.0f, 140.0f, 0.0f);
+                if (!canvases_identical(canvas, reference)) {
+                    printf("FAIL: %s %s thickness %.0f: line occludes itself\n", format_name(formats[f]),
+                           modes[m] == RASTER_LINE_AA ? "aa" : "splat", thicknesses[k]);
+                    return 1;
+                }
+
+                // Near vertical line first, then a far horizontal line across it:
+                // the crossing keeps only the near line
+                canvas_clear(canvas, 0.0f);
+                canvas_clear(reference, 0.0f);
+                draw(canvas, modes[m], thicknesses[k], 100.0f, 10.0f, -0.5f, 100.0f, 140.0f, -0.5f);
+                draw(canvas, modes[m], thicknesses[k], 10.0f, 75.0f, 0.5f, 190.0f, 75.0f, 0.5f);
+                draw(reference, modes[m], thicknesses[k], 100.0f, 10.0f, -0.5f, 100.0f, 140.0f, -0.5f);
+                int reach = (int)(thicknesses[k] / 2);  // Columns fully covered by the near line
+                for (int y = 72; y <= 78; y++) {
+                    for (int x = 100 - reach; x <= 100 + reach; x++) {
+                        if (canvas_row(canvas, y)[x] != canvas_row(reference, y)[x]) {
+                            printf("FAIL: %s %s thickness %.0f: far line drawn over (%d, %d)\n",
+                                   format_name(formats[f]), modes[m] == RASTER_LINE_AA ? "aa" : "splat",
+                                   thicknesses[k], x, y);
+                            return 1;
+                        }
+                    }
+                }
+                if (canvas_row(canvas, 75)[40] <= 0.0f) {
+                    printf("FAIL: far line missing away from the crossing\n");
+                    return 1;
+                }
+
+                depth_stats_t stats;
+                depth_buffer_stats(canvas->depth, &stats);
+                if (stats.passes >= stats.tests || stats.covered == 0 || stats.overdraw < 1.0f) {
+                    printf("FAIL: implausible stats (tests %llu, passes %llu, covered %llu)\n",
+                           (unsigned long long)stats.tests, (unsigned long long)stats.passes,
+                           (unsigned long long)stats.covered);
+                    return 1;
+                }
+            }
+        }
+        printf("%s: clear, interpolation and occlusion OK\n", format_name(formats[f]));
+    }
+    free_canvas(canvas);
+    free_canvas(reference);
+
+    // Tiled rasterization with depth matches the direct path, pixels and depths
+    const int width = 700, height = 500;
+    canvas_t* direct = create_canvas(width, height);
+    canvas_t* tiled = create_canvas(width, height);
+    enum { NUM_SEGMENTS = 1500 };
+    segment_t* segments = malloc(sizeof(segment_t) * NUM_SEGMENTS);
+    srand(7);
+    for (int i = 0; i < NUM_SEGMENTS; i++) {
+        segments[i] = (segment_t){
+            (float)rand() / RAND_MAX * (width + 200) - 100,
+            (float)rand() / RAND_MAX * (height + 200) - 100,
+            (float)rand() / RAND_MAX * (width + 200) - 100,
+            (float)rand() / RAND_MAX * (height + 200) - 100,
+            (float)rand() / RAND_MAX * 2.0f - 1.0f,
+            (float)rand() / RAND_MAX * 2.0f - 1.0f
+        };
+    }
+    arena_t arena;
+    arena_init(&arena, 0);
+    threadpool_t* pool = threadpool_create(3);
+    for (int f = 0; f < 2; f++) {
+        canvas_attach_depth(direct, formats[f]);
+        canvas_attach_depth(tiled, formats[f]);
+        for (int m = 0; m < 2; m++) {
+            canvas_clear(direct, 0.0f);
+            canvas_clear(tiled, 0.0f);
+            arena_reset(&arena);
+            raster_segments(direct, segments, NUM_SEGMENTS, 3.0f, modes[m]);
+            raster_segments_tiled(tiled, segments, NUM_SEGMENTS, 3.0f, modes[m], pool, &arena);
+
+            int same = canvases_identical(direct, tiled) && depths_identical(direct->depth, tiled->depth) &&
+                       direct->depth->passes == tiled->depth->passes;
+            printf("%s %s tiled vs direct: %s\n", format_name(formats[f]),
+                   modes[m] == RASTER_LINE_AA ? "aa" : "splat", same ? "bit-identical" : "FAIL: differs");
+            if (!same) return 1;
+        }
+    }
+    threadpool_destroy(pool);
+    arena_destroy(&arena);
+
+    // Renderer: the depth path draws the same edges without sorting
+    indexed_mesh_t* mesh = random_mesh(300, 1200);
+
+    mat4_t world, view, proj;
+    mat4_rotate_xyz(&world, 0.3f, 0.7f, 0.0f);
+    mat4_translate(&view, 0.0f, 0.0f, -4.0f);
+    mat4_frustum_asymmetric(&proj, -0.5f, 0.5f, -0.35f, 0.35f, 1.0f, 20.0f);
+
+    canvas_attach_depth(direct, DEPTH_FORMAT_FLOAT32);
+    canvas_clear(direct, 0.0f);
+    renderer_t* renderer = renderer_create(direct);
+    renderer_draw_wireframe(renderer, mesh, &world, &view, &proj);
+
+    canvas_attach_depth(tiled, DEPTH_FORMAT_FLOAT32);
+    canvas_clear(tiled, 0.0f);
+    renderer->canvas = tiled;
+    renderer_set_threads(renderer, 3);
+    renderer_begin_frame(renderer);
+    renderer_draw_wireframe(renderer, mesh, &world, &view, &proj);
+
+    depth_stats_t stats;
+    depth_buffer_stats(direct->depth, &stats);
+    int same = canvases_identical(direct, tiled) && stats.passes > 0;
+    printf("renderer depth mode: %llu fragments, %.1f%% passed, overdraw %.2f, tiled %s\n",
+           (unsigned long long)stats.tests, 100.0f * stats.pass_rate, stats.overdraw,
+           same ? "bit-identical" : "FAIL: differs");
+
+    renderer_destroy(renderer);
+    indexed_mesh_destroy(mesh);
+    free(segments);
+    free_canvas(direct);
+    free_canvas(tiled);
+    if (!same) return 1;
+
+    printf("Depth buffer test completed.\n");
+    return 0;
+}
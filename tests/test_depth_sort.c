@@ -0,0 +1,96 @@
+#include "../include/depth_sort.h"
+#include "../include/renderer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Check that order is a permutation sorted far-to-near, stable on ties
+static int check_order(const float* depths, const int* order, int count) {
+    char* seen = calloc(count, 1);
+    int ok = 1;
+    for (int i = 0; i < count && ok; i++) {
+        if (order[i] < 0 || order[i] >= count || seen[order[i]]) ok = 0;
+        else seen[order[i]] = 1;
+        if (ok && i > 0) {
+            float prev = depths[order[i - 1]];
+            float cur = depths[order[i]];
+            if (prev < cur) ok = 0;
+            if (prev == cur && order[i - 1] > order[i]) ok = 0;
+        }
+    }
+    free(seen);
+    return ok;
+}
+
+int main() {
+    const int sizes[] = { 0, 1, 7, 127, 128, 1000, 100000 };
+    arena_t arena;
+    arena_init(&arena, 0);
+
+    srand(7);
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        int count = sizes[s];
+        float* depths = malloc(sizeof(float) * (count ? count : 1));
+        for (int i = 0; i < count; i++) {
+            // Coarse values force many ties; include negatives and zeros of both signs
+            depths[i] = (float)(rand() % 64 - 32) / 16.0f;
+            if (i % 97 == 0) depths[i] = -0.0f;
+        }
+
+        arena_reset(&arena);
+        int* hybrid = depth_sort_back_to_front(&arena, depths, count);
+        int* radix = depth_sort_radix(&arena, depths, count);
+        int ok = hybrid && radix && check_order(depths, hybrid, count) &&
+                 check_order(depths, radix, count);
+        printf("%6d depths: %s\n", count, ok ? "ok" : "FAIL");
+        free(depths);
+        if (!ok) return 1;
+    }
+    arena_destroy(&arena);
+
+    // Both sort modes must render the same image (up to accumulation order)
+    canvas_t* a = create_canvas(320, 240);
+    canvas_t* b = create_canvas(320, 240);
+    indexed_mesh_t* mesh = indexed_mesh_create(200, 1000);
+    for (int i = 0; i < mesh->num_vertices; i++) {
+        mesh->vertices[i] = vec3f_make((float)rand() / RAND_MAX - 0.5f,
+                                       (float)rand() / RAND_MAX - 0.5f,
+                                       (float)rand() / RAND_MAX - 0.5f);
+    }
+    for (int i = 0; i < 2 * mesh->num_edges; i++) {
+        mesh->indices[i] = rand() % mesh->num_vertices;
+    }
+
+    mat4_t world, view, proj;
+    mat4_identity(&world);
+    mat4_translate(&view, 0.0f, 0.0f, -3.0f);
+    mat4_frustum_asymmetric(&proj, -0.5f, 0.5f, -0.375f, 0.375f, 1.0f, 10.0f);
+
+    renderer_t* renderer = renderer_create(a);
+    renderer->sort_mode = RENDER_SORT_QSORT;
+    renderer_draw_wireframe(renderer, mesh, &world, &view, &proj);
+    renderer->canvas = b;
+    renderer->sort_mode = RENDER_SORT_RADIX;
+    renderer_begin_frame(renderer);
+    renderer_draw_wireframe(renderer, mesh, &world, &view, &proj);
+
+    float worst = 0.0f;
+    for (int y = 0; y < a->height; y++) {
+        for (int x = 0; x < a->width; x++) {
+            worst = fmaxf(worst, fabsf(a->pixels[y][x] - b->pixels[y][x]));
+        }
+    }
+    printf("qsort vs radix render: max pixel difference %.2e\n", worst);
+
+    renderer_destroy(renderer);
+    indexed_mesh_destroy(mesh);
+    free_canvas(a);
+    free_canvas(b);
+    if (worst > 1e-4f) {
+        printf("FAIL: sort modes render differently\n");
+        return 1;
+    }
+
+    printf("Depth sort test completed.\n");
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include "../include/frame_sink.h"
+#include "../include/canvas.h"
+#include "../include/cpu.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define W 70  // Not a multiple of any SIMD width, so the scalar tail runs too
+#define H 9
+
+static void fill(canvas_t* canvas, int frame) {
+    for (int y = 0; y < canvas->height; y++) {
+        for (int x = 0; x < canvas->width; x++) {
+            canvas->pixels[y][x] = (float)((x * 7 + y * 13 + frame * 5) % 300) / 255.0f - 0.1f;
+        }
+    }
+}
+
+static long read_file(const char* path, unsigned char** data) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return -1;
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    *data = malloc(size ? size : 1);
+    if (fread(*data, 1, size, fp) != (size_t)size) size = -1;
+    fclose(fp);
+    return size;
+}
+
+int main() {
+    // Quantization: every SIMD kernel matches the scalar reference exactly
+    enum { N = 1003 };
+    float values[N];
+    unsigned char ref[N], out[N];
+    for (int i = 0; i < N; i++) values[i] = (float)(i - 100) / 800.0f;
+    values[7] = 1e30f;
+    values[8] = -1e30f;
+    cpu_set_feature_mask(0);
+    canvas_quantize_u8(values, ref, N);
+    const unsigned int masks[] = { CPU_FEATURE_SSE2, ~0u };
+    for (int m = 0; m < 2; m++) {
+        cpu_set_feature_mask(masks[m]);
+        canvas_quantize_u8(values, out, N);
+        if (memcmp(ref, out, N) != 0) {
+            printf("FAIL: quantization kernel differs from scalar (mask %x)\n", masks[m]);
+            return 1;
+        }
+    }
+    cpu_set_feature_mask(~0u);
+    if (ref[0] != 0 || ref[7] != 255 || ref[8] != 0 || ref[100] != 0 || ref[900] != 255) {
+        printf("FAIL: quantization clamping\n");
+        return 1;
+    }
+
+    canvas_t* canvas = create_canvas(W, H);
+    unsigned char expected[3][W * H];
+    for (int f = 0; f < 3; f++) {
+        fill(canvas, f);
+        for (int y = 0; y < H; y++) canvas_quantize_u8(canvas->pixels[y], expected[f] + y * W, W);
+    }
+
+    // Y4M stream: header, then FRAME marker + plane per frame, in order
+    frame_sink_t* sink = frame_sink_open("build/test_frame_sink.y4m", FRAME_SINK_Y4M, W, H, 25);
+    if (!sink) {
+        printf("FAIL: could not open y4m sink\n");
+        return 1;
+    }
+    for (int f = 0; f < 3; f++) {
+        fill(canvas, f);
+        if (frame_sink_submit(sink, canvas) != 0) {
+            printf("FAIL: submit\n");
+            return 1;
+        }
+    }
+    canvas_t* wrong = create_canvas(W + 1, H);
+    if (frame_sink_submit(sink, wrong) != -1) {
+        printf("FAIL: size mismatch accepted\n");
+        return 1;
+    }
+    free_canvas(wrong);
+    if (frame_sink_frames(sink) != 3 || frame_sink_close(sink) != 0) {
+        printf("FAIL: y4m sink close\n");
+        return 1;
+    }
+
+    unsigned char* data;
+    long size = read_file("build/test_frame_sink.y4m", &data);
+    const char* header = "YUV4MPEG2 W70 H9 F25:1 Ip A1:1 Cmono\n";
+    long header_len = (long)strlen(header);
+    if (size != header_len + 3 * (6 + W * H) || memcmp(data, header, header_len) != 0) {
+        printf("FAIL: y4m file size %ld\n", size);
+        return 1;
+    }
+    for (int f = 0; f < 3; f++) {
+        const unsigned char* frame = data + header_len + f * (6 + W * H);
+        if (memcmp(frame, "FRAME\n", 6) != 0 || memcmp(frame + 6, expected[f], W * H) != 0) {
+            printf("FAIL: y4m frame %d content\n", f);
+            return 1;
+        }
+    }
+    free(data);
+
+    // Memory-mapped ring: 2 slots, 3 frames, so frame 2 overwrites slot 0
+    sink = frame_sink_open_ring("build/test_frame_sink.ring", W, H, 2);
+    if (!sink) {
+        printf("FAIL: could not open ring sink\n");
+        return 1;
+    }
+    for (int f = 0; f < 3; f++) {
+        fill(canvas, f);
+        frame_sink_submit(sink, canvas);
+    }
+    if (frame_sink_close(sink) != 0) {
+        printf("FAIL: ring sink close\n");
+        return 1;
+    }
+    size = read_file("build/test_frame_sink.ring", &data);
+    frame_ring_header_t ring;
+    memcpy(&ring, data, sizeof(ring));
+    if (size != (long)ring.header_size + 2 * W * H || memcmp(ring.magic, "T3DRING1", 8) != 0 ||
+        ring.frames_written != 3 || ring.slots != 2) {
+        printf("FAIL: ring header\n");
+        return 1;
+    }
+    if (memcmp(data + ring.header_size, expected[2], W * H) != 0 ||
+        memcmp(data + ring.header_size + W * H, expected[1], W * H) != 0) {
+        printf("FAIL: ring slot content\n");
+        return 1;
+    }
+    free(data);
+
+    remove("build/test_frame_sink.y4m");
+    remove("build/test_frame_sink.ring");
+    free_canvas(canvas);
+    printf("Frame sink tests passed\n");
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "../include/renderer.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static float max_difference(const canvas_t* a, const canvas_t* b) {
+    float worst = 0.0f;
+    for (int y = 0; y < a->height; y++) {
+        for (int x = 0; x < a->width; x++) {
+            worst = fmaxf(worst, fabsf(canvas_row(a, y)[x] - canvas_row(b, y)[x]));
+        }
+    }
+    return worst;
+}
+
+int main() {
+    indexed_mesh_t* cube = make_cube();
+    canvas_t* instanced = create_canvas(400, 300);
+    canvas_t* reference = create_canvas(400, 300);
+    renderer_t* renderer = renderer_create(instanced);
+
+    mat4_t view, proj;
+    mat4_translate(&view, 0.0f, 0.0f, -8.0f);
+    mat4_frustum_asymmetric(&proj, -0.5f, 0.5f, -0.375f, 0.375f, 1.0f, 50.0f);
+
+    // A 5x4 grid on screen plus 6 instances far outside the frustum
+    enum { ON_SCREEN = 20, COUNT = 26 };
+    mat4_t worlds[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+        vec3f_t t = i < ON_SCREEN ? vec3f_make((i % 5) - 2.0f, (i / 5) - 1.5f, 0.0f)
+                                  : vec3f_make(100.0f * (i - ON_SCREEN + 1), 0.0f, 0.0f);
+        mat4_trs(&worlds[i], t, vec3f_make(0.3f * i, 0.7f, 0.1f * i), vec3f_make(0.6f, 0.6f, 0.6f));
+    }
+
+    // Same picture as one call per instance (up to MVP rounding and sort order)
+    canvas_clear(instanced, 0.0f);
+    int drawn = renderer_draw_instances(renderer, cube, worlds, NULL, COUNT, &view, &proj);
+    if (drawn != ON_SCREEN) {
+        printf("FAIL: %d instances drawn, expected %d (the rest should be culled)\n", drawn, ON_SCREEN);
+        return 1;
+    }
+
+    renderer->canvas = reference;
+    canvas_clear(reference, 0.0f);
+    for (int i = 0; i < COUNT; i++) {
+        renderer_begin_frame(renderer);
+        renderer_draw_wireframe(renderer, cube, &worlds[i], &view, &proj);
+    }
+    float diff = max_difference(instanced, reference);
+    printf("instanced vs per-call: max pixel difference %.2e\n", diff);
+    if (diff > 1e-3f) {
+        printf("FAIL: instanced draw differs from per-instance draws\n");
+        return 1;
+    }
+
+    // Intensities scale each instance's contribution exactly
+    float half[COUNT];
+    for (int i = 0; i < COUNT; i++) half[i] = 0.5f;
+    const raster_line_mode_t modes[] = { RASTER_LINE_SPLAT, RASTER_LINE_AA };
+    for (int m = 0; m < 2; m++) {
+        renderer->line_mode = modes[m];
+        renderer->canvas = reference;
+        renderer_begin_frame(renderer);
+        canvas_clear(reference, 0.0f);
+        renderer_draw_instances(renderer, cube, worlds, NULL, COUNT, &view, &proj);
+
+        renderer->canvas = instanced;
+        renderer_begin_frame(renderer);
+        canvas_clear(instanced, 0.0f);
+        renderer_draw_instances(renderer, cube, worlds, half, COUNT, &view, &proj);
+
+        for (int y = 0; y < instanced->height; y++) {
+            for (int x = 0; x < instanced->width; x++) {
+                if (canvas_row(instanced, y)[x] * 2.0f != canvas_row(reference, y)[x]) {
+                    printf("FAIL: %s: half intensity is not half at (%d, %d)\n",
+                           modes[m] == RASTER_LINE_AA ? "aa" : "splat", x, y);
+                    return 1;
+                }
+            }
+        }
+        printf("%s: per-instance intensity OK\n", modes[m] == RASTER_LINE_AA ? "aa" : "splat");
+    }
+
+    // Everything culled draws nothing
+    renderer_begin_frame(renderer);
+    canvas_clear(instanced, 0.0f);
+    canvas_clear(reference, 0.0f);
+    drawn = renderer_draw_instances(renderer, cube, worlds + ON_SCREEN, NULL, COUNT - ON_SCREEN,
+                                    &view, &proj);
+    if (drawn != 0 || max_difference(instanced, reference) != 0.0f) {
+        printf("FAIL: off-screen instances were drawn\n");
+        return 1;
+    }
+
+    renderer_destroy(renderer);
+    free_canvas(instanced);
+    free_canvas(reference);
+    indexed_mesh_destroy(cube);
+    printf("Instancing test completed.\n");
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "../include/lighting.h"
+#include "../include/cpu.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Batch lighting must equal the per-pair Lambert reference exactly
+
+static float reference(vec3f_t edge, const light_t* lights, int num_lights) {
+    float total = 0.0f;
+    for (int j = 0; j < num_lights; j++) {
+        total += calculate_lambert_intensity(edge, lights[j].direction) * lights[j].intensity;
+    }
+    return fminf(total, 1.0f);
+}
+
+int main() {
+    enum { LIGHTS = 20, VERTICES = 500, EDGES = 1003 };
+    light_t lights[LIGHTS];
+    srand(17);
+    for (int j = 0; j < LIGHTS; j++) {
+        lights[j].direction = vec3f_make(rand_range(-1, 1), rand_range(-1, 1), rand_range(-1, 1));
+        lights[j].intensity = rand_range(0.05f, 0.2f);
+    }
+    lights[3].intensity = 0.001f;  // Below the threshold used later
+    lights[7].intensity = -0.1f;   // Darkening light
+
+    indexed_mesh_t* mesh = indexed_mesh_create(VERTICES, EDGES);
+    for (int i = 0; i < VERTICES; i++) {
+        mesh->vertices[i] = vec3f_make(rand_range(-1, 1), rand_range(-1, 1), rand_range(-1, 1));
+    }
+    for (int i = 0; i < 2 * EDGES; i++) mesh->indices[i] = rand() % VERTICES;
+    mesh->indices[0] = mesh->indices[1];  // Degenerate edge
+
+    light_set_t set;
+    light_set_init(&set);
+    float* out = malloc(sizeof(float) * EDGES);
+
+    // Threshold 0 keeps every light: exact match, SIMD and scalar
+    const unsigned int masks[] = { 0, ~0u };
+    for (int m = 0; m < 2; m++) {
+        cpu_set_feature_mask(masks[m]);
+        light_set_prepare(&set, lights, LIGHTS, 0.0f);
+        lighting_evaluate_indexed(&set, mesh, out);
+        for (int i = 0; i < EDGES; i++) {
+            vec3f_t edge = vec3f_sub(mesh->vertices[mesh->indices[2*i + 1]],
+                                     mesh->vertices[mesh->indices[2*i]]);
+            float want = reference(edge, lights, LIGHTS);
+            if (out[i] != want) {
+                printf("FAIL: edge %d lit %.9g, reference %.9g (mask %x)\n", i, out[i], want, masks[m]);
+                return 1;
+            }
+        }
+    }
+    cpu_set_feature_mask(~0u);
+
+    // Threshold culling drops the dim light and nothing else
+    light_set_prepare(&set, lights, LIGHTS, 0.01f);
+    if (set.count != LIGHTS - 1 || set.culled != 1 || set.all_positive) {
+        printf("FAIL: culling kept %d lights\n", set.count);
+        return 1;
+    }
+
+    // Bright positive lights saturate; the early exit must not change results
+    for (int j = 0; j < LIGHTS; j++) lights[j].intensity = 1.0f;
+    light_set_prepare(&set, lights, LIGHTS, 0.0f);
+    lighting_evaluate_indexed(&set, mesh, out);
+    for (int i = 0; i < EDGES; i++) {
+        vec3f_t edge = vec3f_sub(mesh->vertices[mesh->indices[2*i + 1]],
+                                 mesh->vertices[mesh->indices[2*i]]);
+        if (out[i] != reference(edge, lights, LIGHTS)) {
+            printf("FAIL: saturated edge %d\n", i);
+            return 1;
+        }
+    }
+
+    free(out);
+    light_set_destroy(&set);
+    indexed_mesh_destroy(mesh);
+    printf("Lighting tests passed\n");
+    return 0;
+}
@@ -0,0 +1,211 @@
+#include "../include/renderer.h"
+#include "../include/raster.h"
+#include "../include/mesh_lod.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// UV sphere of the given radius: rings of latitude plus meridians
+static indexed_mesh_t* make_sphere(int rings, int sectors, float radius) {
+    int vertices = rings * sectors;
+    int edges = rings * sectors + (rings - 1) * sectors;
+    indexed_mesh_t* mesh = indexed_mesh_create(vertices, edges);
+    for (int r = 0; r < rings; r++) {
+        float phi = 3.14159265f * (r + 1) / (rings + 1);
+        for (int s = 0; s < sectors; s++) {
+            float theta = 6.2831853f * s / sectors;
+            mesh->vertices[r * sectors + s] = vec3f_make(radius * sinf(phi) * cosf(theta),
+                                                         radius * cosf(phi),
+                                                         radius * sinf(phi) * sinf(theta));
+        }
+    }
+    int e = 0;
+    for (int r = 0; r < rings; r++) {
+        for (int s = 0; s < sectors; s++) {
+            mesh->indices[2*e] = r * sectors + s;
+            mesh->indices[2*e + 1] = r * sectors + (s + 1) % sectors;
+            e++;
+            if (r + 1 < rings) {
+                mesh->indices[2*e] = r * sectors + s;
+                mesh->indices[2*e + 1] = (r + 1) * sectors + s;
+                e++;
+            }
+        }
+    }
+    indexed_mesh_compute_bounds(mesh);
+    return mesh;
+}
+
+// Every index in range, no edge collapsed to a point, no edge listed twice
+static int level_valid(const indexed_mesh_t* mesh) {
+    for (int i = 0; i < mesh->num_edges; i++) {
+        int a = mesh->indices[2*i], b = mesh->indices[2*i + 1];
+        if (a < 0 || b < 0 || a >= mesh->num_vertices || b >= mesh->num_vertices || a == b) return 0;
+        for (int j = 0; j < i; j++) {
+            int c = mesh->indices[2*j], d = mesh->indices[2*j + 1];
+            if ((a == c && b == d) || (a == d && b == c)) return 0;
+        }
+    }
+    return 1;
+}
+
+int main() {
+    indexed_mesh_t* sphere = make_sphere(48, 96, 1.0f);
+    mesh_lod_t* lod = mesh_lod_build(sphere, MESH_LOD_MAX_LEVELS);
+    if (!lod || lod->num_levels < 4 || lod->levels[0].mesh != sphere || lod->levels[0].error != 0.0f) {
+        printf("FAIL: expected a chain of levels over the source mesh\n");
+        return 1;
+    }
+    for (int i = 0; i < lod->num_levels; i++) {
+        const indexed_mesh_t* m = lod->levels[i].mesh;
+        printf("level %2d: %5d vertices %5d edges, error %.4f\n", i, m->num_vertices,
+               m->num_edges, lod->levels[i].error);
+        if (!level_valid(m)) {
+            printf("FAIL: level %d has invalid edges\n", i);
+            return 1;
+        }
+        if (i > 0 && (m->num_edges >= lod->levels[i - 1].mesh->num_edges ||
+                      lod->levels[i].error < lod->levels[i - 1].error ||
+                      m->bounds_radius != lod->bounds_radius)) {
+            printf("FAIL: level %d does not simplify level %d\n", i, i - 1);
+            return 1;
+        }
+        // The error bound holds: every vertex stays within error of the sphere
+        for (int v = 0; v < m->num_vertices; v++) {
+            float r = vec3f_length(m->vertices[v]);
+            if (r > 1.0f + 1e-4f || r < 1.0f - lod->levels[i].error - 1e-4f) {
+                printf("FAIL: level %d vertex %d is %.4f from the center\n", i, v, r);
+                return 1;
+            }
+        }
+    }
+
+    // Selection: full detail up close, coarser with distance, never over budget
+    mat4_t world, view, proj;
+    mat4_identity(&world);
+    mat4_frustum_asymmetric(&proj, -0.5f, 0.5f, -0.375f, 0.375f, 1.0f, 1000.0f);
+    const float distances[] = { 3.0f, 10.0f, 40.0f, 160.0f, 640.0f };
+    int previous = -1;
+    for (int d = 0; d < 5; d++) {
+        mat4_translate(&view, 0.0f, 0.0f, -distances[d]);
+        float ppu = mesh_lod_pixels_per_unit(lod, &world, &view, &proj, 240);
+        int level = mesh_lod_select(lod, ppu, 0.5f);
+        printf("distance %5.0f: %7.2f pixels per unit, level %d\n", distances[d], ppu, level);
+        if (level < previous || lod->levels[level].error * ppu > 0.5f ||
+            (level + 1 < lod->num_levels && lod->levels[level + 1].error * ppu <= 0.5f)) {
+            printf("FAIL: wrong level at distance %.0f\n", distances[d]);
+            return 1;
+        }
+        previous = level;
+    }
+    if (mesh_lod_select(lod, 1000.0f, 0.5f) != 0 || previous < 4 ||
+        mesh_lod_select(lod, 1e-3f, 0.5f) != lod->num_levels - 1) {
+        printf("FAIL: selection did not span the chain\n");
+        return 1;
+    }
+    // A scaled world shrinks the budget in object units; inside the sphere nothing is safe
+    mat4_t scaled;
+    mat4_translate(&view, 0.0f, 0.0f, -40.0f);
+    mat4_scale(&scaled, 4.0f, 4.0f, 4.0f);
+    float ppu = mesh_lod_pixels_per_unit(lod, &world, &view, &proj, 240);
+    if (mesh_lod_pixels_per_unit(lod, &scaled, &view, &proj, 240) <= ppu) {
+        printf("FAIL: world scale ignored\n");
+        return 1;
+    }
+    mat4_translate(&view, 0.0f, 0.0f, -0.5f);
+    if (mesh_lod_pixels_per_unit(lod, &world, &view, &proj, 240) != 0.0f) {
+        printf("FAIL: camera inside the bounds should disable simplification\n");
+        return 1;
+    }
+
+    // Close up, renderer_draw_lod is renderer_draw_wireframe on the source
+    canvas_t* reference = create_canvas(320, 240);
+    canvas_t* canvas = create_canvas(320, 240);
+    renderer_t* ref_renderer = renderer_create(reference);
+    renderer_t* renderer = renderer_create(canvas);
+    mat4_rotate_xyz(&world, 0.3f, 0.7f, 0.0f);
+    mat4_translate(&view, 0.0f, 0.0f, -3.0f);
+    canvas_clear(reference, 0.0f);
+    canvas_clear(canvas, 0.0f);
+    renderer_draw_wireframe(ref_renderer, sphere, &world, &view, &proj);
+    if (renderer_draw_lod(renderer, lod, &world, &view, &proj) != 0 ||
+        !canvases_identical(reference, canvas)) {
+        printf("FAIL: close-up LOD draw differs from the full mesh\n");
+        return 1;
+    }
+    mat4_translate(&view, 0.0f, 0.0f, -200.0f);
+    if (renderer_draw_lod(renderer, lod, &world, &view, &proj) == 0) {
+        printf("FAIL: distant LOD draw used the full mesh\n");
+        return 1;
+    }
+
+    // Point batching of sub-pixel segments matches per-segment drawing bit for bit,
+    // with and without depth, in both formats and on the tiled path
+    enum { NUM_SEGMENTS = 3000 };
+    segment_t* segments = malloc(sizeof(segment_t) * NUM_SEGMENTS);
+    srand(25);
+    for (int i = 0; i < NUM_SEGMENTS; i++) {
+        float x = (float)rand() / RAND_MAX * 340 - 10, y = (float)rand() / RAND_MAX * 260 - 10;
+        float length = i % 7 == 0 ? 40.0f : 0.9f;  // Mostly sub-pixel, some long
+        segments[i] = (segment_t){
+            .x0 = x, .y0 = y,
+            .x1 = x + ((float)rand() / RAND_MAX * 2 - 1) * length,
+            .y1 = y + ((float)rand() / RAND_MAX * 2 - 1) * length,
+            .z0 = (float)rand() / RAND_MAX * 2 - 1,
+            .z1 = (float)rand() / RAND_MAX * 2 - 1
+        };
+    }
+    threadpool_t* pool = threadpool_create(3);
+    arena_t arena;
+    arena_init(&arena, 0);
+    const canvas_format_t formats[] = { CANVAS_FORMAT_FLOAT32, CANVAS_FORMAT_UNORM16 };
+    const float thicknesses[] = { 1.0f, 2.5f };
+    for (int f = 0; f < 2; f++) {
+        for (int depth = 0; depth < 2; depth++) {
+            for (int t = 0; t < 2; t++) {
+                canvas_t* expected = create_canvas_format(320, 240, formats[f]);
+                canvas_t* direct = create_canvas_format(320, 240, formats[f]);
+                canvas_t* tiled = create_canvas_format(320, 240, formats[f]);
+                if (depth) {
+                    canvas_attach_depth(expected, DEPTH_FORMAT_FLOAT32);
+                    canvas_attach_depth(direct, DEPTH_FORMAT_FLOAT32);
+                    canvas_attach_depth(tiled, DEPTH_FORMAT_FLOAT32);
+                }
+                canvas_clear(expected, 0.0f);
+                canvas_clear(direct, 0.0f);
+                canvas_clear(tiled, 0.0f);
+                for (int i = 0; i < NUM_SEGMENTS; i++) {
+                    const segment_t* s = &segments[i];
+                    draw_line_f_depth(expected, s->x0, s->y0, s->z0, s->x1, s->y1, s->z1,
+                                      thicknesses[t], 1.0f, NULL);
+                }
+                raster_segments(direct, segments, NUM_SEGMENTS, thicknesses[t], RASTER_LINE_SPLAT);
+                arena_reset(&arena);
+                raster_segments_tiled(tiled, segments, NUM_SEGMENTS, thicknesses[t],
+                                      RASTER_LINE_SPLAT, pool, &arena);
+                if (!canvases_identical(expected, direct) || !canvases_identical(expected, tiled)) {
+                    printf("FAIL: batched points differ (format %d, depth %d, thickness %.1f)\n",
+                           f, depth, thicknesses[t]);
+                    return 1;
+                }
+                free_canvas(expected);
+                free_canvas(direct);
+                free_canvas(tiled);
+            }
+        }
+    }
+    printf("point batches match per-segment drawing\n");
+
+    arena_destroy(&arena);
+    threadpool_destroy(pool);
+    free(segments);
+    renderer_destroy(ref_renderer);
+    renderer_destroy(renderer);
+    free_canvas(reference);
+    free_canvas(canvas);
+    mesh_lod_destroy(lod);
+    indexed_mesh_destroy(sphere);
+    printf("LOD test completed.\n");
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "../include/math3d.h"
+#include "../include/cpu.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Matrix library checked against the original scalar implementations
+
+#define TOLERANCE 1e-5f
+// M * M^-1 for the random TRS matrices below: with scales down to 0.1 and
+// translations up to 5 the inverse's translation column reaches 50, and the
+// product's translation column cancels terms of up to 150 back to zero, so one
+// float rounding there is already about 1e-5
+#define INVERSE_TOLERANCE 1e-4f
+
+static void reference_multiply(mat4_t* result, const mat4_t* a, const mat4_t* b) {
+    float temp[16];
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            temp[j*4+i] = 0.0f;
+            for (int k = 0; k < 4; ++k) temp[j*4+i] += a->m[k*4+i] * b->m[j*4+k];
+        }
+    }
+    for (int i = 0; i < 16; i++) result->m[i] = temp[i];
+}
+
+static void reference_rotate_xyz(mat4_t* m, float rx, float ry, float rz) {
+    float cx = cosf(rx), sx = sinf(rx);
+    float cy = cosf(ry), sy = sinf(ry);
+    float cz = cosf(rz), sz = sinf(rz);
+    mat4_t x_rot = {{ 1,0,0,0, 0,cx,-sx,0, 0,sx,cx,0, 0,0,0,1 }};
+    mat4_t y_rot = {{ cy,0,sy,0, 0,1,0,0, -sy,0,cy,0, 0,0,0,1 }};
+    mat4_t z_rot = {{ cz,-sz,0,0, sz,cz,0,0, 0,0,1,0, 0,0,0,1 }};
+    mat4_t temp;
+    reference_multiply(&temp, &x_rot, &y_rot);
+    reference_multiply(m, &temp, &z_rot);
+}
+
+static float max_diff(const mat4_t* a, const mat4_t* b) {
+    float worst = 0.0f;
+    for (int i = 0; i < 16; i++) worst = fmaxf(worst, fabsf(a->m[i] - b->m[i]));
+    return worst;
+}
+
+static void random_matrix(mat4_t* m) {
+    for (int i = 0; i < 16; i++) m->m[i] = rand_range(-2.0f, 2.0f);
+}
+
+static int check_within(const char* what, float diff, float tolerance) {
+    if (!(diff <= tolerance)) {
+        printf("FAIL: %s differs by %g\n", what, diff);
+        return 0;
+    }
+    return 1;
+}
+
+static int check(const char* what, float diff) {
+    return check_within(what, diff, TOLERANCE);
+}
+
+int main() {
+    srand(11);
+    mat4_t a, b, expected, got, identity;
+    mat4_identity(&identity);
+
+    for (int trial = 0; trial < 100; trial++) {
+        // General multiply, including aliased outputs
+        random_matrix(&a);
+        random_matrix(&b);
+        reference_multiply(&expected, &a, &b);
+        mat4_multiply(&got, &a, &b);
+        if (!check("mat4_multiply", max_diff(&got, &expected))) return 1;
+        got = a;
+        mat4_multiply(&got, &got, &b);
+        if (!check("mat4_multiply (result == a)", max_diff(&got, &expected))) return 1;
+        got = b;
+        mat4_multiply(&got, &a, &got);
+        if (!check("mat4_multiply (result == b)", max_diff(&got, &expected))) return 1;
+
+        // Closed-form Euler rotation
+        float rx = rand_range(-3.2f, 3.2f), ry = rand_range(-3.2f, 3.2f), rz = rand_range(-3.2f, 3.2f);
+        reference_rotate_xyz(&expected, rx, ry, rz);
+        mat4_rotate_xyz(&got, rx, ry, rz);
+        if (!check("mat4_rotate_xyz", max_diff(&got, &expected))) return 1;
+
+        // TRS equals T * R * S built from separate matrices
+        vec3f_t t = vec3f_make(rand_range(-5, 5), rand_range(-5, 5), rand_range(-5, 5));
+        vec3f_t s = vec3f_make(rand_range(0.1f, 3), rand_range(0.1f, 3), rand_range(0.1f, 3));
+        mat4_t tm, rm, sm, tr;
+        mat4_translate(&tm, t.x, t.y, t.z);
+        reference_rotate_xyz(&rm, rx, ry, rz);
+        mat4_scale(&sm, s.x, s.y, s.z);
+        reference_multiply(&tr, &tm, &rm);
+        reference_multiply(&expected, &tr, &sm);
+        mat4_trs(&got, t, vec3f_make(rx, ry, rz), s);
+        if (!check("mat4_trs", max_diff(&got, &expected))) return 1;
+
+        // In-place composition matches the same chain of multiplies
+        got = identity;
+        mat4_compose_translate(&got, t.x, t.y, t.z);
+        mat4_compose_rotate_xyz(&got, rx, ry, rz);
+        mat4_compose_scale(&got, s.x, s.y, s.z);
+        if (!check("mat4_compose_*", max_diff(&got, &expected))) return 1;
+        got = a;
+        mat4_compose(&got, &b);
+        reference_multiply(&expected, &a, &b);
+        if (!check("mat4_compose", max_diff(&got, &expected))) return 1;
+
+        // Affine inverse: M * M^-1 == I
+        mat4_t inverse, product;
+        mat4_trs(&a, t, vec3f_make(rx, ry, rz), s);
+        if (mat4_inverse_affine(&inverse, &a) != 0) {
+            printf("FAIL: mat4_inverse_affine rejected an invertible matrix\n");
+            return 1;
+        }
+        reference_multiply(&product, &a, &inverse);
+        if (!check_within("mat4_inverse_affine", max_diff(&product, &identity), INVERSE_TOLERANCE)) {
+            return 1;
+        }
+    }
+
+    mat4_t singular;
+    mat4_scale(&singular, 1.0f, 0.0f, 1.0f);
+    if (mat4_inverse_affine(&got, &singular) != -1) {
+        printf("FAIL: singular matrix inverted\n");
+        return 1;
+    }
+
+    // Batch multiply, with and without the AVX2 path
+    enum { N = 37 };
+    mat4_t bs[N], results[N];
+    random_matrix(&a);
+    for (int i = 0; i < N; i++) random_matrix(&bs[i]);
+    const unsigned int masks[] = { 0, ~0u };
+    for (int m = 0; m < 2; m++) {
+        cpu_set_feature_mask(masks[m]);
+        mat4_multiply_batch(results, &a, bs, N);
+        for (int i = 0; i < N; i++) {
+            reference_multiply(&expected, &a, &bs[i]);
+            if (!check("mat4_multiply_batch", max_diff(&results[i], &expected))) return 1;
+        }
+    }
+    cpu_set_feature_mask(~0u);
+
+    printf("Matrix tests passed\n");
+    return 0;
+}
@@ -17,6 +17,30 @@ int main() {
     printf("After normalization:\n");
     print_vec3(&v);
 
+    // Test compact vectors: no spherical payload, explicit round trip only
+    printf("sizeof(vec3_t)=%zu sizeof(vec3f_t)=%zu sizeof(vec4_t)=%zu\n\n",
+           sizeof(vec3_t), sizeof(vec3f_t), sizeof(vec4_t));
+    if (sizeof(vec3f_t) != 12 || sizeof(vec4_t) != 16) {
+        printf("FAIL: unexpected compact vector size\n");
+        return 1;
+    }
+
+    vec3f_t c = vec3f_from_spherical(5.0f, M_PI/4, M_PI/6);
+    float r, theta, phi;
+    vec3f_to_spherical(c, &r, &theta, &phi);
+    printf("Compact round trip: (r=%.2f, θ=%.2frad, φ=%.2frad)\n", r, theta, phi);
+    if (fabsf(r - 5.0f) > 1e-4f || fabs(theta - M_PI/4) > 1e-4 || fabs(phi - M_PI/6) > 1e-4) {
+        printf("FAIL: spherical round trip\n");
+        return 1;
+    }
+
+    vec3f_t n = vec3f_normalize(c);
+    printf("Compact normalized length: %.4f\n\n", vec3f_length(n));
+    if (fabsf(vec3f_length(n) - 1.0f) > 1e-5f) {
+        printf("FAIL: vec3f_normalize\n");
+        return 1;
+    }
+
     // Test matrix operations
     mat4_t trans, rot, result;
     mat4_translate(&trans, 2.0f, 3.0f, 1.5f);
@@ -0,0 +1,179 @@
+#include "../include/mesh_file.h"
+#include "../include/renderer.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MESH_PATH "test_mesh_file.t3dm"
+#define OBJ_PATH "test_mesh_file.obj"
+
+// Overwrite bytes of a file in place
+static void patch_file(const char* path, long offset, const void* bytes, size_t count) {
+    FILE* fp = fopen(path, "r+b");
+    fseek(fp, offset, SEEK_SET);
+    fwrite(bytes, 1, count, fp);
+    fclose(fp);
+}
+
+static int expect_open_error(unsigned int verify, mesh_file_status_t expected, const char* what) {
+    mesh_file_status_t status;
+    mesh_file_t* file = mesh_file_open(MESH_PATH, verify, &status);
+    if (file || status != expected) {
+        printf("FAIL: %s: got \"%s\", expected \"%s\"\n", what, mesh_file_status_string(status),
+               mesh_file_status_string(expected));
+        mesh_file_close(file);
+        return 1;
+    }
+    printf("%s: rejected (%s)\n", what, mesh_file_status_string(status));
+    return 0;
+}
+
+int main() {
+    // Round trip: same vertices, indices and bounds, read straight from the mapping
+    srand(22);
+    indexed_mesh_t* mesh = random_mesh(1001, 3000);
+
+    if (mesh_file_write(MESH_PATH, mesh) != MESH_FILE_OK) {
+        printf("FAIL: could not write %s\n", MESH_PATH);
+        return 1;
+    }
+    mesh_file_status_t status;
+    mesh_file_t* file = mesh_file_open(MESH_PATH, MESH_FILE_VERIFY_ALL, &status);
+    if (!file) {
+        printf("FAIL: open: %s\n", mesh_file_status_string(status));
+        return 1;
+    }
+    const indexed_mesh_t* loaded = &file->mesh;
+    const char* begin = file->data;
+    const char* end = begin + file->size;
+    int inside = (const char*)loaded->vertices >= begin && (const char*)loaded->indices < end &&
+                 (size_t)((const char*)loaded->vertices - begin) % MESH_FILE_ALIGNMENT == 0 &&
+                 (size_t)((const char*)loaded->indices - begin) % MESH_FILE_ALIGNMENT == 0;
+    int same = loaded->num_vertices == mesh->num_vertices && loaded->num_edges == mesh->num_edges &&
+               memcmp(loaded->vertices, mesh->vertices, sizeof(vec3f_t) * mesh->num_vertices) == 0 &&
+               memcmp(loaded->indices, mesh->indices, 2 * sizeof(int) * mesh->num_edges) == 0 &&
+               loaded->bounds_radius == mesh->bounds_radius;
+    printf("round trip: %d vertices, %d edges, %s, %s\n", loaded->num_vertices, loaded->num_edges,
+           same ? "identical" : "FAIL: differs", inside ? "zero-copy" : "FAIL: copied");
+    if (!same || !inside) return 1;
+
+    // Renders exactly like the in-memory mesh; edits stay private to the process
+    mat4_t world, view, proj;
+    mat4_rotate_xyz(&world, 0.4f, 0.9f, 0.0f);
+    mat4_translate(&view, 0.0f, 0.0f, -4.0f);
+    mat4_frustum_asymmetric(&proj, -0.5f, 0.5f, -0.375f, 0.375f, 1.0f, 20.0f);
+    canvas_t* a = create_canvas(320, 240);
+    canvas_t* b = create_canvas(320, 240);
+    render_wireframe(a, mesh, world, view, proj);
+    render_wireframe(b, loaded, world, view, proj);
+    if (!canvases_identical(a, b)) {
+        printf("FAIL: mapped mesh renders differently\n");
+        return 1;
+    }
+    file->mesh.vertices[0].x = 42.0f;
+    mesh_file_close(file);
+    file = mesh_file_open(MESH_PATH, MESH_FILE_VERIFY_ALL, &status);
+    if (!file || file->mesh.vertices[0].x != mesh->vertices[0].x) {
+        printf("FAIL: an edit to the mapping reached the file\n");
+        return 1;
+    }
+    mesh_file_close(file);
+    free_canvas(a);
+    free_canvas(b);
+
+    // Validation on open
+    int failures = 0;
+    mesh_file_header_t header;
+    FILE* fp = fopen(MESH_PATH, "rb");
+    if (fread(&header, sizeof(header), 1, fp) != 1) return 1;
+    fclose(fp);
+
+    int bad_index = mesh->num_vertices;
+    long index_at = (long)header.index_offset + 4 * 17;
+    patch_file(MESH_PATH, index_at, &bad_index, sizeof(int));
+    failures += expect_open_error(0, MESH_FILE_ERROR_INDICES, "index out of range");
+    failures += expect_open_error(MESH_FILE_TRUST_INDICES | MESH_FILE_VERIFY_CHECKSUM,
+                                  MESH_FILE_ERROR_CHECKSUM, "modified block");
+    if (!(file = mesh_file_open(MESH_PATH, MESH_FILE_TRUST_INDICES, &status))) {
+        printf("FAIL: trusted open checked the indices: %s\n", mesh_file_status_string(status));
+        return 1;
+    }
+    mesh_file_close(file);
+    patch_file(MESH_PATH, index_at, &mesh->indices[17], sizeof(int));
+
+    mesh_file_header_t h = header;
+    h.version = MESH_FILE_VERSION + 1;
+    patch_file(MESH_PATH, 0, &h, sizeof(h));
+    failures += expect_open_error(0, MESH_FILE_ERROR_VERSION, "future version");
+
+    h = header;
+    h.num_edges += 1000;
+    patch_file(MESH_PATH, 0, &h, sizeof(h));
+    failures += expect_open_error(0, MESH_FILE_ERROR_LAYOUT, "block past the end");
+
+    h = header;
+    h.index_offset += 4;
+    patch_file(MESH_PATH, 0, &h, sizeof(h));
+    failures += expect_open_error(0, MESH_FILE_ERROR_LAYOUT, "misaligned block");
+
+    h = header;
+    h.magic[0] = 'X';
+    patch_file(MESH_PATH, 0, &h, sizeof(h));
+    failures += expect_open_error(0, MESH_FILE_ERROR_FORMAT, "bad magic");
+
+    fp = fopen(MESH_PATH, "wb");
+    fwrite(&header, 1, 20, fp);
+    fclose(fp);
+    failures += expect_open_error(0, MESH_FILE_ERROR_FORMAT, "truncated header");
+    if (failures) return 1;
+
+    mesh->indices[5] = -1;
+    if (mesh_file_write(MESH_PATH, mesh) != MESH_FILE_ERROR_INDICES) {
+        printf("FAIL: wrote a mesh with a negative index\n");
+        return 1;
+    }
+    indexed_mesh_destroy(mesh);
+
+    // OBJ: a cube from quads (shared edges stored once) plus a polyline with
+    // relative indices and texture/normal references
+    fp = fopen(OBJ_PATH, "w");
+    fputs("# cube\no cube\n"
+          "v -1 -1 -1\nv 1 -1 -1\nv 1 1 -1\nv -1 1 -1\n"
+          "v -1 -1 1\nv 1 -1 1\nv 1 1 1\nv -1 1 1\n"
+          "vn 0 0 1\nvt 0 0\n"
+          "f 1 2 3 4\nf 5 6 7 8\nf 1/1 2/1 6/1 5/1\nf 2//1 3//1 7//1 6//1\n"
+          "f 3 4 8 7\r\nf 4 1 5 8\n\n"
+          "v 0 0 2\nv 0 0 3\n"
+          "l -2 -1 1  # trailing comment\n", fp);
+    fclose(fp);
+    indexed_mesh_t* cube = mesh_file_import_obj(OBJ_PATH, &status);
+    if (!cube || cube->num_vertices != 10 || cube->num_edges != 14 ||
+        cube->indices[26] != 9 || cube->indices[27] != 0 || cube->bounds_radius <= 0.0f) {
+        printf("FAIL: OBJ import: %s, %d vertices, %d edges\n", mesh_file_status_string(status),
+               cube ? cube->num_vertices : -1, cube ? cube->num_edges : -1);
+        return 1;
+    }
+    indexed_mesh_destroy(cube);
+
+    if (mesh_file_convert_obj(OBJ_PATH, MESH_PATH) != MESH_FILE_OK ||
+        !(file = mesh_file_open(MESH_PATH, MESH_FILE_VERIFY_ALL, NULL)) || file->mesh.num_edges != 14) {
+        printf("FAIL: OBJ conversion\n");
+        return 1;
+    }
+    printf("OBJ: 10 vertices, 14 edges, converted and reopened\n");
+    mesh_file_close(file);
+
+    fp = fopen(OBJ_PATH, "w");
+    fputs("v 0 0 0\nv 1 0 0\nf 1 2 3\n", fp);  // References a missing vertex
+    fclose(fp);
+    if (mesh_file_import_obj(OBJ_PATH, &status) || status != MESH_FILE_ERROR_PARSE) {
+        printf("FAIL: OBJ with a bad reference was accepted\n");
+        return 1;
+    }
+
+    remove(MESH_PATH);
+    remove(OBJ_PATH);
+    printf("Mesh file test completed.\n");
+    return 0;
+}
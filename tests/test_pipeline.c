@@ -5,7 +5,7 @@
 #include <math.h>
 
 // Simple cube mesh for pipeline test
-static const vec3_t cube_vertices[8] = {
+static const vec3f_t cube_vertices[8] = {
     { -1, -1, -1 }, { 1, -1, -1 },
     {  1,  1, -1 }, { -1,  1, -1 },
     { -1, -1,  1 }, { 1, -1,  1 },
@@ -20,10 +20,10 @@ static const int cube_edges[12][2] = {
 
 int main() {
     // Create canvas
-    canvas_t* canvas = canvas_create(800, 600);
+    canvas_t* canvas = create_canvas(800, 600);
 
     // Set up transformation matrices
-    mat4_t model, view, proj, mvp;
+    mat4_t model, view, proj;
     mat4_identity(&model);
     mat4_rotate_xyz(&model, 0.7f, 0.7f, 0.0f);
 
@@ -32,27 +32,75 @@ int main() {
 
     mat4_frustum_asymmetric(&proj, -1, 1, -0.75, 0.75, 1.0f, 10.0f);
 
-    mat4_t temp;
-    mat4_multiply(&temp, &view, &model);
-    mat4_multiply(&mvp, &proj, &temp);
+    // Legacy edge soup: every edge carries copies of both endpoints
+    edge_t edges[12];
+    for (int i = 0; i < 12; ++i) {
+        edges[i].v0 = vec3_from_vec3f(cube_vertices[cube_edges[i][0]]);
+        edges[i].v1 = vec3_from_vec3f(cube_vertices[cube_edges[i][1]]);
+    }
+    mesh_t soup = { edges, 12 };
 
-    // Project and draw edges
+    // Convert to the indexed format; the 24 endpoints collapse to 8 vertices
+    indexed_mesh_t* cube = indexed_mesh_from_mesh(&soup);
+    printf("Indexed cube: %d vertices, %d edges\n", cube->num_vertices, cube->num_edges);
+    if (cube->num_vertices != 8 || cube->num_edges != 12) {
+        printf("FAIL: expected 8 vertices and 12 edges\n");
+        return 1;
+    }
+    // Indices survive the vertex array being shrunk to the welded count
     for (int i = 0; i < 12; ++i) {
-        vec3_t v0 = cube_vertices[cube_edges[i][0]];
-        vec3_t v1 = cube_vertices[cube_edges[i][1]];
+        for (int end = 0; end < 2; ++end) {
+            vec3f_t expected = cube_vertices[cube_edges[i][end]];
+            vec3f_t got = cube->vertices[cube->indices[2*i + end]];
+            if (got.x != expected.x || got.y != expected.y || got.z != expected.z) {
+                printf("FAIL: edge %d endpoint %d moved after welding\n", i, end);
+                return 1;
+            }
+        }
+    }
+    mesh_t huge = { edges, 1 << 30 };  // 2^31 endpoints: more vertices than an int counts
+    if (indexed_mesh_from_mesh(&huge) != NULL) {
+        printf("FAIL: welded a soup whose vertex count overflows int\n");
+        return 1;
+    }
 
-        // Project vertices
-        float x0, y0, x1, y1;
-        project_vertex(&mvp, &v0, canvas->width, canvas->height, &x0, &y0);
-        project_vertex(&mvp, &v1, canvas->width, canvas->height, &x1, &y1);
+    // Project and draw edges
+    render_wireframe(canvas, cube, model, view, proj);
 
-        // Draw edge
-        draw_line_f(canvas, x0, y0, x1, y1, 2.0f);
+    int lit = 0;
+    for (int y = 0; y < canvas->height; ++y) {
+        for (int x = 0; x < canvas->width; ++x) {
+            if (canvas->pixels[y][x] > 0.0f) lit++;
+        }
+    }
+    printf("Lit pixels: %d\n", lit);
+    if (lit == 0) {
+        printf("FAIL: nothing was drawn\n");
+        return 1;
     }
 
     // Save result
     canvas_save_ppm(canvas, "pipeline_test.ppm");
-    canvas_destroy(canvas);
+
+    // Context rendering: after the first frame the arena must stop allocating
+    renderer_t* renderer = renderer_create(canvas);
+    unsigned long first_frame_allocs = 0;
+    for (int frame = 0; frame < 4; ++frame) {
+        renderer_begin_frame(renderer);
+        canvas_clear(canvas, 0.0f);
+        renderer_draw_wireframe(renderer, cube, &model, &view, &proj);
+        if (frame == 0) first_frame_allocs = renderer->frame_arena.heap_allocs;
+    }
+    arena_stats_t stats = arena_get_stats(&renderer->frame_arena);
+    printf("Frame arena: peak %zu bytes, %lu resets, %lu heap allocations\n",
+           stats.peak_bytes, stats.resets, stats.heap_allocs);
+    if (stats.heap_allocs > first_frame_allocs + 1) {
+        printf("FAIL: frame arena kept allocating after warm-up\n");
+        return 1;
+    }
+    renderer_destroy(renderer);
+    indexed_mesh_destroy(cube);
+    free_canvas(canvas);
 
     printf("Pipeline test completed. Output saved to pipeline_test.ppm\n");
     return 0;
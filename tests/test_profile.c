@@ -0,0 +1,188 @@
+#include "../include/renderer.h"
+#include "../include/lighting.h"
+#include "../include/profile.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_PATH "test_profile.json"
+
+static int count_substrings(const char* text, const char* needle) {
+    int count = 0;
+    for (const char* p = strstr(text, needle); p; p = strstr(p + 1, needle)) count++;
+    return count;
+}
+
+int main() {
+    srand(24);
+    indexed_mesh_t* mesh = random_mesh(500, 2000);
+
+    // The camera sits close enough that the near plane cuts through the mesh
+    mat4_t world, view, proj, behind;
+    mat4_rotate_xyz(&world, 0.4f, 0.9f, 0.0f);
+    mat4_translate(&view, 0.0f, 0.0f, -1.5f);
+    mat4_translate(&behind, 0.0f, 0.0f, 10.0f);
+    mat4_frustum_asymmetric(&proj, -0.5f, 0.5f, -0.375f, 0.375f, 1.0f, 20.0f);
+
+    canvas_t* plain = create_canvas(320, 240);
+    canvas_t* profiled = create_canvas(320, 240);
+    renderer_t* reference = renderer_create(plain);
+    renderer_t* renderer = renderer_create(profiled);
+    profile_t profile;
+    profile_init(&profile, 1 << 16);
+    renderer->profile = &profile;
+
+    // Three frames: counters per frame, identical output, totals summed
+    enum { FRAMES = 3 };
+    for (int frame = 0; frame < FRAMES; frame++) {
+        profile_begin_frame(&profile);
+        renderer_begin_frame(reference);
+        renderer_begin_frame(renderer);
+        canvas_clear(plain, 0.0f);
+        canvas_clear(profiled, 0.0f);
+        renderer_draw_wireframe(reference, mesh, &world, &view, &proj);
+        renderer_draw_wireframe(renderer, mesh, &world, &view, &proj);
+        renderer_draw_wireframe(renderer, mesh, &behind, &view, &proj);  // Culled whole
+        profile_end_frame(&profile);
+        if (!canvases_identical(plain, profiled)) {
+            printf("FAIL: profiling changed the output\n");
+            return 1;
+        }
+    }
+
+    const profile_stats_t first = profile.last;  // Later frames overwrite profile.last
+    const profile_stats_t* last = &first;
+    printf("frame: %llu vertices, %llu drawn, %llu clipped, %llu culled edges, %llu pixels\n",
+           (unsigned long long)last->vertices_projected, (unsigned long long)last->edges_drawn,
+           (unsigned long long)last->edges_clipped, (unsigned long long)last->edges_culled,
+           (unsigned long long)last->pixels_touched);
+    for (int s = 0; s < PROFILE_STAGE_COUNT; s++) {
+        printf("  %-8s %3llu calls %9lld ns %11llu cycles\n", profile_stage_name(s),
+               (unsigned long long)last->calls[s], (long long)last->ns[s],
+               (unsigned long long)last->cycles[s]);
+    }
+    if (profile.frames != FRAMES || last->vertices_projected != (uint64_t)mesh->num_vertices ||
+        last->edges_drawn + last->edges_culled != (uint64_t)mesh->num_edges ||
+        last->edges_drawn == 0 || last->edges_clipped == 0 || last->meshes_culled != 1 ||
+        last->pixels_touched < last->edges_drawn || last->scratch_bytes == 0 ||
+        last->calls[PROFILE_PROJECT] != 2 || last->calls[PROFILE_CLIP] != 1 ||
+        last->calls[PROFILE_SORT] != 1 || last->calls[PROFILE_RASTER] != 1 ||
+        last->calls[PROFILE_LIGHTING] != 0 || last->ns[PROFILE_RASTER] <= 0) {
+        printf("FAIL: unexpected per-frame counters\n");
+        return 1;
+    }
+    if (profile.total.edges_drawn != FRAMES * last->edges_drawn ||
+        profile.total.calls[PROFILE_CLIP] != FRAMES || profile.frame.calls[PROFILE_CLIP] != 0) {
+        printf("FAIL: totals do not add up over %d frames\n", FRAMES);
+        return 1;
+    }
+
+    // Depth buffer: no sort stage
+    canvas_attach_depth(profiled, DEPTH_FORMAT_FLOAT32);
+    profile_begin_frame(&profile);
+    renderer_begin_frame(renderer);
+    canvas_clear(profiled, 0.0f);
+    renderer_draw_wireframe(renderer, mesh, &world, &view, &proj);
+    profile_end_frame(&profile);
+    if (profile.last.calls[PROFILE_SORT] != 0 || profile.last.calls[PROFILE_RASTER] != 1) {
+        printf("FAIL: depth-tested frame recorded a sort\n");
+        return 1;
+    }
+    canvas_detach_depth(profiled);
+
+    // Instances: off-screen copies count as culled meshes
+    mat4_t worlds[4] = { world, world, behind, behind };
+    profile_begin_frame(&profile);
+    renderer_begin_frame(renderer);
+    int drawn = renderer_draw_instances(renderer, mesh, worlds, NULL, 4, &view, &proj);
+    profile_end_frame(&profile);
+    if (drawn != 2 || profile.last.meshes_culled != 2 ||
+        profile.last.vertices_projected != 2 * (uint64_t)mesh->num_vertices ||
+        profile.last.calls[PROFILE_CLIP] != 2 ||
+        profile.last.edges_drawn != 2 * last->edges_drawn) {
+        printf("FAIL: instanced frame counters\n");
+        return 1;
+    }
+
+    // Free functions report to the thread's bound profile
+    mesh_t soup = { malloc(sizeof(edge_t) * 100), 100 };
+    for (int i = 0; i < soup.num_edges; i++) {
+        soup.edges[i] = (edge_t){ .v0 = { .x = 0.0f }, .v1 = { .x = 1.0f, .y = (float)i } };
+    }
+    light_t light = { vec3f_make(1.0f, 1.0f, 0.0f), 1.0f };
+    profile_bind(&profile);
+    profile_begin_frame(&profile);
+    apply_lighting(&soup, &light, 1);
+    render_wireframe(plain, mesh, world, view, proj);
+    profile_end_frame(&profile);
+    profile_bind(NULL);
+    apply_lighting(&soup, &light, 1);  // Unbound: not counted
+    if (profile.last.edges_lit != 100 || profile.last.calls[PROFILE_LIGHTING] != 1 ||
+        profile.last.edges_drawn != last->edges_drawn || profile_bound() != NULL) {
+        printf("FAIL: bound profile missed apply_lighting or render_wireframe\n");
+        return 1;
+    }
+    free(soup.edges);
+    printf("depth, instancing, lighting and one-shot rendering counted\n");
+
+    // Chrome trace: one complete event per stage call and frame
+    if (profile_save_trace(&profile, TRACE_PATH) != 0) {
+        printf("FAIL: could not write %s\n", TRACE_PATH);
+        return 1;
+    }
+    FILE* fp = fopen(TRACE_PATH, "rb");
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    char* text = malloc(size + 1);
+    if (fread(text, 1, size, fp) != (size_t)size) return 1;
+    text[size] = '\0';
+    fclose(fp);
+    int depth = 0, balanced = 1;
+    for (long i = 0; i < size; i++) {
+        if (text[i] == '{' || text[i] == '[') depth++;
+        if (text[i] == '}' || text[i] == ']') depth--;
+        if (depth < 0) balanced = 0;
+    }
+    int complete = count_substrings(text, "\"ph\":\"X\"");
+    int frames = count_substrings(text, "\"name\":\"frame\"");
+    printf("trace: %ld bytes, %d complete events, %d frames\n", size, complete, frames);
+    if (!balanced || depth != 0 || strncmp(text, "{\"displayTimeUnit\"", 18) != 0 ||
+        complete != (int)profile.num_events || frames != profile.frames ||
+        count_substrings(text, "\"name\":\"edges\",\"ph\":\"C\"") != profile.frames ||
+        !strstr(text, "\"name\":\"raster\"") || !strstr(text, "\"name\":\"lighting\"")) {
+        printf("FAIL: malformed trace\n");
+        return 1;
+    }
+    free(text);
+    remove(TRACE_PATH);
+
+    // The log is bounded; counters keep going without it
+    profile_t small;
+    profile_init(&small, 4);
+    renderer->profile = &small;
+    profile_begin_frame(&small);
+    for (int i = 0; i < 3; i++) renderer_draw_wireframe(renderer, mesh, &world, &view, &proj);
+    profile_end_frame(&small);
+    if (small.num_events != 4 || small.dropped_events == 0 || small.last.calls[PROFILE_RASTER] != 3) {
+        printf("FAIL: bounded log kept %zu events, dropped %lu\n", small.num_events,
+               small.dropped_events);
+        return 1;
+    }
+    profile_reset(&small);
+    if (small.num_events != 0 || small.frames != 0 || small.total.edges_drawn != 0) {
+        printf("FAIL: reset left data behind\n");
+        return 1;
+    }
+    profile_destroy(&small);
+
+    profile_destroy(&profile);
+    renderer_destroy(reference);
+    renderer_destroy(renderer);
+    free_canvas(plain);
+    free_canvas(profiled);
+    indexed_mesh_destroy(mesh);
+    printf("Profile test completed.\n");
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "../include/renderer.h"
+#include "../include/projection_cache.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Draw one frame cached into `cached` and uncached into `reference`, then compare
+static int frame_matches(renderer_t* renderer, canvas_t* cached, canvas_t* reference,
+                         const indexed_mesh_t* mesh, projection_cache_t* cache,
+                         const mat4_t* world, const mat4_t* view, const mat4_t* proj) {
+    renderer->canvas = cached;
+    renderer_begin_frame(renderer);
+    canvas_clear(cached, 0.0f);
+    renderer_draw_wireframe_cached(renderer, mesh, cache, world, view, proj);
+
+    renderer->canvas = reference;
+    renderer_begin_frame(renderer);
+    canvas_clear(reference, 0.0f);
+    renderer_draw_wireframe(renderer, mesh, world, view, proj);
+    return canvases_identical(cached, reference);
+}
+
+static int expect(const projection_cache_t* cache, unsigned long hits, unsigned long misses,
+                  const char* step) {
+    if (cache->hits != hits || cache->misses != misses) {
+        printf("FAIL: %s: %lu hits / %lu misses, expected %lu / %lu\n",
+               step, cache->hits, cache->misses, hits, misses);
+        return 0;
+    }
+    printf("%s: %lu hits / %lu misses\n", step, cache->hits, cache->misses);
+    return 1;
+}
+
+int main() {
+    srand(11);
+    indexed_mesh_t* mesh = random_mesh(400, 1500);
+
+    mat4_t world, view, proj;
+    mat4_rotate_xyz(&world, 0.2f, 0.5f, 0.0f);
+    mat4_translate(&view, 0.0f, 0.0f, -3.0f);
+    mat4_frustum_asymmetric(&proj, -0.5f, 0.5f, -0.4f, 0.4f, 1.0f, 20.0f);
+
+    canvas_t* cached = create_canvas(320, 256);
+    canvas_t* reference = create_canvas(320, 256);
+    renderer_t* renderer = renderer_create(cached);
+    projection_cache_t cache;
+    projection_cache_init(&cache);
+
+    // First frame projects, the next ones reuse
+    for (int frame = 0; frame < 3; frame++) {
+        if (!frame_matches(renderer, cached, reference, mesh, &cache, &world, &view, &proj)) {
+            printf("FAIL: cached frame %d differs\n", frame);
+            return 1;
+        }
+    }
+    if (!expect(&cache, 2, 1, "still object")) return 1;
+
+    // Moving the object re-projects
+    mat4_rotate_xyz(&world, 0.2f, 0.6f, 0.0f);
+    if (!frame_matches(renderer, cached, reference, mesh, &cache, &world, &view, &proj) ||
+        !expect(&cache, 2, 2, "moved object")) return 1;
+
+    // So does moving the camera
+    mat4_translate(&view, 0.1f, 0.0f, -3.0f);
+    if (!frame_matches(renderer, cached, reference, mesh, &cache, &world, &view, &proj) ||
+        !expect(&cache, 2, 3, "moved camera")) return 1;
+
+    // Edits are picked up once the mesh is touched
+    mesh->vertices[0] = vec3f_make(0.9f, -0.9f, 0.0f);
+    indexed_mesh_touch(mesh);
+    if (!frame_matches(renderer, cached, reference, mesh, &cache, &world, &view, &proj) ||
+        !expect(&cache, 2, 4, "edited mesh")) return 1;
+
+    // A different canvas size re-projects too
+    canvas_t* small_cached = create_canvas(160, 128);
+    canvas_t* small_reference = create_canvas(160, 128);
+    if (!frame_matches(renderer, small_cached, small_reference, mesh, &cache, &world, &view, &proj) ||
+        !expect(&cache, 2, 5, "resized canvas")) return 1;
+    if (!frame_matches(renderer, small_cached, small_reference, mesh, &cache, &world, &view, &proj) ||
+        !expect(&cache, 3, 5, "same size again")) return 1;
+
+    // Culled objects are cached as empty
+    mat4_translate(&view, 0.0f, 0.0f, 10.0f);  // Object behind the camera
+    for (int frame = 0; frame < 2; frame++) {
+        if (!frame_matches(renderer, cached, reference, mesh, &cache, &world, &view, &proj)) {
+            printf("FAIL: culled frame differs\n");
+            return 1;
+        }
+    }
+    if (!expect(&cache, 4, 6, "culled object") || cache.count != 0) return 1;
+
+    projection_cache_invalidate(&cache);
+    renderer_draw_wireframe_cached(renderer, mesh, &cache, &world, &view, &proj);
+    if (!expect(&cache, 4, 7, "invalidated")) return 1;
+
+    projection_cache_destroy(&cache);
+    renderer_destroy(renderer);
+    free_canvas(cached);
+    free_canvas(reference);
+    free_canvas(small_cached);
+    free_canvas(small_reference);
+    indexed_mesh_destroy(mesh);
+    printf("Projection cache test completed.\n");
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include "../include/scene.h"
+#include "../include/renderer.h"
+#include <stdio.h>
+#include <string.h>
+
+static int expect_recomputed(scene_t* scene, int expected, const char* step) {
+    int recomputed = scene_update(scene);
+    printf("%s: %d world matrices recomputed\n", step, recomputed);
+    if (recomputed != expected) {
+        printf("FAIL: %s recomputed %d nodes, expected %d\n", step, recomputed, expected);
+        return 0;
+    }
+    return 1;
+}
+
+static int same_matrix(const mat4_t* a, const mat4_t* b) {
+    return memcmp(a, b, sizeof(mat4_t)) == 0;
+}
+
+int main() {
+    scene_t scene;
+    scene_init(&scene, 0);
+
+    // root_a -> arm -> hand, root_a -> leg; root_b on its own
+    int root_a = scene_add_node(&scene, -1);
+    int arm = scene_add_node(&scene, root_a);
+    int hand = scene_add_node(&scene, arm);
+    int leg = scene_add_node(&scene, root_a);
+    int root_b = scene_add_node(&scene, -1);
+    if (scene_add_node(&scene, 99) != -1) {
+        printf("FAIL: added a node under a missing parent\n");
+        return 1;
+    }
+
+    scene_set_trs(&scene, root_a, vec3f_make(1.0f, 0.0f, -5.0f), vec3f_make(0.0f, 0.3f, 0.0f),
+                  vec3f_make(2.0f, 2.0f, 2.0f));
+    scene_set_trs(&scene, arm, vec3f_make(0.0f, 1.0f, 0.0f), vec3f_make(0.5f, 0.0f, 0.2f),
+                  vec3f_make(1.0f, 1.0f, 1.0f));
+    scene_set_translation(&scene, hand, vec3f_make(0.0f, 0.5f, 0.0f));
+    scene_set_rotation(&scene, leg, vec3f_make(0.0f, 0.0f, 1.0f));
+    scene_set_scale(&scene, root_b, vec3f_make(3.0f, 3.0f, 3.0f));
+    if (!expect_recomputed(&scene, 5, "initial")) return 1;
+    if (!expect_recomputed(&scene, 0, "unchanged")) return 1;
+
+    // World = parent world * local TRS
+    mat4_t root_local, arm_local, hand_local, expected;
+    mat4_trs(&root_local, vec3f_make(1.0f, 0.0f, -5.0f), vec3f_make(0.0f, 0.3f, 0.0f),
+             vec3f_make(2.0f, 2.0f, 2.0f));
+    mat4_trs(&arm_local, vec3f_make(0.0f, 1.0f, 0.0f), vec3f_make(0.5f, 0.0f, 0.2f),
+             vec3f_make(1.0f, 1.0f, 1.0f));
+    mat4_trs(&hand_local, vec3f_make(0.0f, 0.5f, 0.0f), vec3f_make(0.0f, 0.0f, 0.0f),
+             vec3f_make(1.0f, 1.0f, 1.0f));
+    mat4_multiply(&expected, &root_local, &arm_local);
+    mat4_multiply(&expected, &expected, &hand_local);
+    if (!same_matrix(scene_world(&scene, hand), &expected)) {
+        printf("FAIL: hand world matrix is not root * arm * hand\n");
+        return 1;
+    }
+
+    // Dirty subtrees only
+    scene_set_rotation(&scene, arm, vec3f_make(0.6f, 0.0f, 0.2f));
+    if (!expect_recomputed(&scene, 2, "arm moved")) return 1;       // arm, hand
+    scene_set_translation(&scene, root_a, vec3f_make(2.0f, 0.0f, -5.0f));
+    if (!expect_recomputed(&scene, 4, "root moved")) return 1;      // whole first tree
+    scene_set_scale(&scene, hand, vec3f_make(0.5f, 0.5f, 0.5f));
+    scene_set_scale(&scene, root_b, vec3f_make(1.0f, 1.0f, 1.0f));
+    if (!expect_recomputed(&scene, 2, "two leaves")) return 1;
+
+    // animated_object_t binding: only a changed pose dirties the node
+    vec3f_t p0 = vec3f_make(0.0f, 0.0f, 0.0f), p1 = vec3f_make(1.0f, 0.0f, 0.0f);
+    vec3f_t p2 = vec3f_make(1.0f, 1.0f, 0.0f), p3 = vec3f_make(0.0f, 1.0f, 0.0f);
+    animated_object_t* object = animated_object_create();
+    bezier_animation_t* path = animation_create(&p0, &p1, &p2, &p3, 2.0f, 0);
+    path->start_time = 0.0;
+    animated_object_set_position_animation(object, path);
+    animated_object_set_time(object, 0.5);
+    scene_bind_object(&scene, leg, object);
+    if (!expect_recomputed(&scene, 1, "object bound")) return 1;
+    if (!expect_recomputed(&scene, 0, "object still")) return 1;
+    animated_object_set_time(object, 1.0);
+    if (!expect_recomputed(&scene, 1, "object moved")) return 1;
+    animated_object_set_time(object, 5.0);  // Past the end: clamps to p3
+    scene_update(&scene);
+    animated_object_set_time(object, 6.0);
+    if (!expect_recomputed(&scene, 0, "object finished")) return 1;
+
+    // Animation pool binding
+    anim_pool_t pool;
+    anim_pool_init(&pool, 4);
+    anim_handle_t handle = anim_pool_add(&pool, path, NULL);
+    anim_pool_update(&pool, 0.25);
+    scene_bind_pool(&scene, arm, &pool, handle);
+    if (!expect_recomputed(&scene, 2, "pool bound")) return 1;
+    anim_pool_update(&pool, 0.25);
+    if (!expect_recomputed(&scene, 0, "pool still")) return 1;
+    anim_pool_update(&pool, 0.75);
+    if (!expect_recomputed(&scene, 2, "pool moved")) return 1;
+    vec3f_t position = pool.poses[anim_pool_index(&pool, handle)].position;
+    if (memcmp(&scene.nodes[arm].translation, &position, sizeof(vec3f_t)) != 0) {
+        printf("FAIL: arm does not follow its pool pose\n");
+        return 1;
+    }
+    anim_pool_remove(&pool, handle);
+    if (!expect_recomputed(&scene, 0, "pool entry removed") ||
+        scene.nodes[arm].binding != SCENE_BIND_NONE) return 1;
+
+    // Scene drawing matches drawing each node by hand
+    indexed_mesh_t* mesh = indexed_mesh_create(4, 6);
+    mesh->vertices[0] = vec3f_make(0.0f, 0.0f, 0.0f);
+    mesh->vertices[1] = vec3f_make(0.5f, 0.0f, 0.0f);
+    mesh->vertices[2] = vec3f_make(0.0f, 0.5f, 0.0f);
+    mesh->vertices[3] = vec3f_make(0.0f, 0.0f, 0.5f);
+    const int edges[12] = { 0, 1, 0, 2, 0, 3, 1, 2, 1, 3, 2, 3 };
+    memcpy(mesh->indices, edges, sizeof(edges));
+    indexed_mesh_compute_bounds(mesh);
+    for (int i = 0; i < scene.count; i++) scene_set_mesh(&scene, i, mesh);
+
+    mat4_t view, proj;
+    mat4_translate(&view, 0.0f, -1.0f, -6.0f);
+    mat4_frustum_asymmetric(&proj, -0.5f, 0.5f, -0.4f, 0.4f, 1.0f, 50.0f);
+    canvas_t* drawn = create_canvas(200, 160);
+    canvas_t* by_hand = create_canvas(200, 160);
+    renderer_t* renderer = renderer_create(drawn);
+    renderer_draw_scene(renderer, &scene, &view, &proj);
+    renderer->canvas = by_hand;
+    for (int i = 0; i < scene.count; i++) {
+        renderer_begin_frame(renderer);
+        renderer_draw_wireframe(renderer, mesh, scene_world(&scene, i), &view, &proj);
+    }
+    for (int y = 0; y < drawn->height; y++) {
+        if (memcmp(canvas_row(drawn, y), canvas_row(by_hand, y), sizeof(float) * drawn->width) != 0) {
+            printf("FAIL: scene drawing differs from per-node drawing\n");
+            return 1;
+        }
+    }
+
+    renderer_destroy(renderer);
+    free_canvas(drawn);
+    free_canvas(by_hand);
+    indexed_mesh_destroy(mesh);
+    anim_pool_destroy(&pool);
+    animated_object_destroy(object);  // Also frees path
+    scene_destroy(&scene);
+    printf("Scene graph test completed.\n");
+    return 0;
+}
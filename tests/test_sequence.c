@@ -0,0 +1,203 @@
+#include "../include/sequence.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SEQUENCE_PATH "test_sequence.y4m"
+#define REFERENCE_PATH "test_sequence_ref.y4m"
+
+enum { WIDTH = 320, HEIGHT = 240, NUM_FRAMES = 24, MAX_WORKERS = 8 };
+
+typedef struct {
+    const indexed_mesh_t* mesh;
+    mat4_t view;
+    mat4_t proj;
+    int bad_worker;
+} scene_ctx_t;
+
+// Frames captured by the output callback (or the reference loop)
+typedef struct {
+    uint32_t hash[NUM_FRAMES];  // FNV-1a of the raw canvas rows
+    int first_frame;
+    int next_frame;             // Frame expected next; -1 after one out of order
+    int fail_at;                // Report an error on this frame (-1: never)
+} capture_t;
+
+static void draw_scene(void* user, renderer_t* renderer, int worker, int frame, double time) {
+    scene_ctx_t* scene = user;
+    if (worker < 0 || worker >= MAX_WORKERS) scene->bad_worker = 1;
+    float angle = (float)time;
+    mat4_t world;
+    mat4_rotate_xyz(&world, angle, angle * 0.7f, angle * 0.3f + frame * 0.01f);
+    renderer_draw_wireframe(renderer, scene->mesh, &world, &scene->view, &scene->proj);
+}
+
+static uint32_t hash_canvas(const canvas_t* canvas) {
+    size_t row_bytes = (size_t)canvas->width *
+                       (canvas->format == CANVAS_FORMAT_UNORM16 ? sizeof(uint16_t) : sizeof(float));
+    uint32_t hash = 2166136261u;
+    for (int y = 0; y < canvas->height; y++) {
+        const unsigned char* row = canvas->format == CANVAS_FORMAT_UNORM16
+                                       ? (const unsigned char*)canvas_row16(canvas, y)
+                                       : (const unsigned char*)canvas_row(canvas, y);
+        for (size_t i = 0; i < row_bytes; i++) hash = (hash ^ row[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static int capture_frame(void* user, const canvas_t* canvas, int frame) {
+    capture_t* capture = user;
+    if (frame != capture->next_frame) {
+        capture->next_frame = -1;
+        return 0;
+    }
+    if (frame == capture->fail_at) return -1;
+    capture->hash[frame - capture->first_frame] = hash_canvas(canvas);
+    capture->next_frame++;
+    return 0;
+}
+
+// The sequential renderer: one canvas, one renderer, frames in order
+static void render_reference(const sequence_desc_t* desc, capture_t* capture) {
+    canvas_t* canvas = create_canvas_format(desc->width, desc->height, desc->format);
+    if (desc->depth) canvas_attach_depth(canvas, desc->depth_format);
+    renderer_t* renderer = renderer_create(canvas);
+    renderer->line_mode = desc->line_mode;
+    renderer->line_thickness = desc->line_thickness;
+    for (int frame = desc->first_frame; frame < desc->first_frame + desc->num_frames; frame++) {
+        renderer_begin_frame(renderer);
+        canvas_clear(canvas, desc->clear_value);
+        desc->draw(desc->user, renderer, 0, frame, desc->start_time + frame / desc->fps);
+        if (desc->sink) frame_sink_submit(desc->sink, canvas);
+        capture->hash[frame - desc->first_frame] = hash_canvas(canvas);
+    }
+    renderer_destroy(renderer);
+    free_canvas(canvas);
+}
+
+static int files_identical(const char* a, const char* b) {
+    FILE* fa = fopen(a, "rb");
+    FILE* fb = fopen(b, "rb");
+    int same = fa && fb;
+    while (same) {
+        int ca = fgetc(fa), cb = fgetc(fb);
+        if (ca != cb) same = 0;
+        if (ca == EOF) break;
+    }
+    if (fa) fclose(fa);
+    if (fb) fclose(fb);
+    return same;
+}
+
+int main() {
+    srand(23);
+    indexed_mesh_t* mesh = random_mesh(300, 1200);
+
+    scene_ctx_t scene = { .mesh = mesh };
+    mat4_translate(&scene.view, 0.0f, 0.0f, -4.0f);
+    mat4_frustum_asymmetric(&scene.proj, -0.5f, 0.5f, -0.375f, 0.375f, 1.0f, 20.0f);
+
+    // Every configuration and thread count matches the sequential renderer
+    const char* names[] = { "float", "unorm16 + depth", "float aa + depth" };
+    const int threads[] = { 1, 2, 3, MAX_WORKERS };
+    for (int c = 0; c < 3; c++) {
+        sequence_desc_t desc;
+        sequence_desc_init(&desc, WIDTH, HEIGHT);
+        desc.format = c == 1 ? CANVAS_FORMAT_UNORM16 : CANVAS_FORMAT_FLOAT32;
+        desc.depth = c > 0;
+        desc.depth_format = c == 1 ? DEPTH_FORMAT_UNORM16 : DEPTH_FORMAT_FLOAT32;
+        desc.line_mode = c == 2 ? RASTER_LINE_AA : RASTER_LINE_SPLAT;
+        desc.line_thickness = c == 2 ? 2.0f : 1.0f;
+        desc.clear_value = 0.05f;
+        desc.num_frames = NUM_FRAMES;
+        desc.fps = 24.0;
+        desc.start_time = 0.5;
+        desc.draw = draw_scene;
+        desc.user = &scene;
+
+        capture_t reference = { .fail_at = -1 };
+        render_reference(&desc, &reference);
+
+        for (int t = 0; t < 4; t++) {
+            capture_t capture = { .fail_at = -1 };
+            desc.output = capture_frame;
+            desc.output_user = &capture;
+            sequence_stats_t stats;
+            if (sequence_render(&desc, threads[t], &stats) != 0 || capture.next_frame != NUM_FRAMES ||
+                stats.frames != NUM_FRAMES || stats.workers != threads[t] || scene.bad_worker) {
+                printf("FAIL: %s on %d threads: %d frames, next %d\n", names[c], threads[t],
+                       stats.frames, capture.next_frame);
+                return 1;
+            }
+            if (memcmp(capture.hash, reference.hash, sizeof(reference.hash)) != 0) {
+                printf("FAIL: %s on %d threads differs from the sequential renderer\n",
+                       names[c], threads[t]);
+                return 1;
+            }
+        }
+        desc.output = NULL;
+        printf("%s: identical to sequential on 1, 2, 3 and %d threads\n", names[c], MAX_WORKERS);
+    }
+
+    // A sub-range renders the same frames as the full sequence
+    sequence_desc_t desc;
+    sequence_desc_init(&desc, WIDTH, HEIGHT);
+    desc.num_frames = NUM_FRAMES;
+    desc.draw = draw_scene;
+    desc.user = &scene;
+    capture_t reference = { .fail_at = -1 };
+    render_reference(&desc, &reference);
+
+    capture_t range = { .first_frame = 7, .next_frame = 7, .fail_at = -1 };
+    desc.first_frame = 7;
+    desc.num_frames = 5;
+    desc.output = capture_frame;
+    desc.output_user = &range;
+    if (sequence_render(&desc, 3, NULL) != 0 || range.next_frame != 12 ||
+        memcmp(range.hash, reference.hash + 7, 5 * sizeof(uint32_t)) != 0) {
+        printf("FAIL: frames 7..11 differ from the full sequence\n");
+        return 1;
+    }
+
+    // Fewer frames than threads
+    capture_t few = { .first_frame = 7, .next_frame = 7, .fail_at = -1 };
+    sequence_stats_t stats;
+    desc.num_frames = 2;
+    desc.output_user = &few;
+    if (sequence_render(&desc, MAX_WORKERS, &stats) != 0 || stats.workers != 2 || few.next_frame != 9) {
+        printf("FAIL: 2 frames on %d threads\n", MAX_WORKERS);
+        return 1;
+    }
+    printf("ranges: sub-range matches, workers clamped to the frame count\n");
+
+    // An output error stops the sequence after the frames before it
+    capture_t failing = { .fail_at = 5 };
+    desc.first_frame = 0;
+    desc.num_frames = NUM_FRAMES;
+    desc.output_user = &failing;
+    if (sequence_render(&desc, 4, &stats) != -1 || stats.frames != 5 || failing.next_frame != 5) {
+        printf("FAIL: output error: %d frames emitted, next %d\n", stats.frames, failing.next_frame);
+        return 1;
+    }
+    printf("output error: stopped after %d frames\n", stats.frames);
+
+    // Frame sink output is byte-identical to a sequential stream
+    desc.output = NULL;
+    desc.sink = frame_sink_open(REFERENCE_PATH, FRAME_SINK_Y4M, WIDTH, HEIGHT, 30);
+    render_reference(&desc, &reference);
+    if (frame_sink_close(desc.sink) != 0) return 1;
+    desc.sink = frame_sink_open(SEQUENCE_PATH, FRAME_SINK_Y4M, WIDTH, HEIGHT, 30);
+    if (sequence_render(&desc, 4, NULL) != 0 || frame_sink_close(desc.sink) != 0 ||
+        !files_identical(SEQUENCE_PATH, REFERENCE_PATH)) {
+        printf("FAIL: y4m stream differs from the sequential one\n");
+        return 1;
+    }
+    printf("frame sink: y4m stream byte-identical\n");
+
+    remove(SEQUENCE_PATH);
+    remove(REFERENCE_PATH);
+    indexed_mesh_destroy(mesh);
+    printf("Sequence test completed.\n");
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "../include/renderer.h"
+#include "../include/raster.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+int main() {
+    const int width = 1000, height = 700;  // Not a multiple of the tile size
+    canvas_t* reference = create_canvas(width, height);
+    canvas_t* tiled = create_canvas(width, height);
+
+    // Segments that cross many tiles, overlap heavily and leave the canvas
+    enum { NUM_SEGMENTS = 2000 };
+    segment_t* segments = malloc(sizeof(segment_t) * NUM_SEGMENTS);
+    srand(99);
+    for (int i = 0; i < NUM_SEGMENTS; i++) {
+        segments[i] = (segment_t){
+            .x0 = (float)rand() / RAND_MAX * (width + 200) - 100,
+            .y0 = (float)rand() / RAND_MAX * (height + 200) - 100,
+            .x1 = (float)rand() / RAND_MAX * (width + 200) - 100,
+            .y1 = (float)rand() / RAND_MAX * (height + 200) - 100
+        };
+    }
+
+    arena_t arena;
+    arena_init(&arena, 0);
+    const float thicknesses[] = { 1.0f, 3.0f };
+    const int thread_counts[] = { 1, 2, 4 };
+    const raster_line_mode_t modes[] = { RASTER_LINE_SPLAT, RASTER_LINE_AA };
+    for (int m = 0; m < 2; m++) {
+        for (int t = 0; t < 2; t++) {
+            canvas_clear(reference, 0.0f);
+            raster_segments(reference, segments, NUM_SEGMENTS, thicknesses[t], modes[m]);
+
+            for (int n = 0; n < 3; n++) {
+                threadpool_t* pool = threadpool_create(thread_counts[n]);
+                canvas_clear(tiled, 0.0f);
+                arena_reset(&arena);
+                raster_segments_tiled(tiled, segments, NUM_SEGMENTS, thicknesses[t], modes[m],
+                                      pool, &arena);
+                threadpool_destroy(pool);
+
+                int same = canvases_identical(reference, tiled);
+                printf("%s, thickness %.0f, %d thread(s): %s\n",
+                       modes[m] == RASTER_LINE_AA ? "aa" : "splat", thicknesses[t], thread_counts[n],
+                       same ? "bit-identical" : "FAIL: differs");
+                if (!same) return 1;
+            }
+        }
+    }
+    arena_destroy(&arena);
+
+    // Full pipeline through the renderer context
+    indexed_mesh_t* mesh = random_mesh(500, 3000);
+
+    mat4_t world, view, proj;
+    mat4_rotate_xyz(&world, 0.4f, 0.9f, 0.0f);
+    mat4_translate(&view, 0.0f, 0.0f, -4.0f);
+    mat4_frustum_asymmetric(&proj, -0.5f, 0.5f, -0.35f, 0.35f, 1.0f, 20.0f);
+
+    renderer_t* renderer = renderer_create(reference);
+    canvas_clear(reference, 0.0f);
+    renderer_draw_wireframe(renderer, mesh, &world, &view, &proj);
+
+    renderer->canvas = tiled;
+    renderer_set_threads(renderer, 3);
+    renderer_begin_frame(renderer);
+    canvas_clear(tiled, 0.0f);
+    renderer_draw_wireframe(renderer, mesh, &world, &view, &proj);
+
+    int same = canvases_identical(reference, tiled);
+    printf("renderer tiled (%d threads): %s\n", threadpool_size(renderer->pool),
+           same ? "bit-identical" : "FAIL: differs");
+
+    renderer_destroy(renderer);
+    indexed_mesh_destroy(mesh);
+    free(segments);
+    free_canvas(reference);
+    free_canvas(tiled);
+    if (!same) return 1;
+
+    printf("Tiled raster test completed.\n");
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "../include/math3d.h"
+#include "../include/transform.h"
+#include "../include/renderer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define NUM_VERTICES 1027  // Not a multiple of 8: exercises the scalar tail
+
+static float max_diff(const float* a, const float* b, int n) {
+    float worst = 0.0f;
+    for (int i = 0; i < n; i++) worst = fmaxf(worst, fabsf(a[i] - b[i]));
+    return worst;
+}
+
+int main() {
+    static float x[NUM_VERTICES], y[NUM_VERTICES], z[NUM_VERTICES];
+    static float ref_x[NUM_VERTICES], ref_y[NUM_VERTICES], ref_d[NUM_VERTICES];
+    static float out_x[NUM_VERTICES], out_y[NUM_VERTICES], out_d[NUM_VERTICES];
+    const int width = 3840, height = 2160;
+
+    // Vertices in a cube that stays in front of the near plane
+    srand(1234);
+    for (int i = 0; i < NUM_VERTICES; i++) {
+        x[i] = (float)rand() / RAND_MAX * 4.0f - 2.0f;
+        y[i] = (float)rand() / RAND_MAX * 4.0f - 2.0f;
+        z[i] = (float)rand() / RAND_MAX * 4.0f - 2.0f;
+    }
+
+    mat4_t world, view, proj, mvp;
+    mat4_rotate_xyz(&world, 0.3f, 0.5f, 0.1f);
+    mat4_translate(&view, 0.0f, 0.0f, -8.0f);
+    mat4_frustum_asymmetric(&proj, -0.5f, 0.5f, -0.3f, 0.3f, 1.0f, 50.0f);
+    mat4_mvp(&mvp, &world, &view, &proj);
+
+    transform_vertices_soa_kernel(TRANSFORM_KERNEL_SCALAR, &mvp, x, y, z, NUM_VERTICES,
+                                  width, height, ref_x, ref_y, ref_d);
+
+    // The scalar batch kernel must agree with the per-vertex reference path
+    float worst_px = 0.0f;
+    for (int i = 0; i < NUM_VERTICES; i++) {
+        vec3f_t p = project_vertex(vec3f_make(x[i], y[i], z[i]), world, view, proj,
+                                   width, height);
+        worst_px = fmaxf(worst_px, fmaxf(fabsf(p.x - ref_x[i]), fabsf(p.y - ref_y[i])));
+    }
+    printf("project_vertex vs batch scalar: max %.2e px\n", worst_px);
+    if (worst_px > TRANSFORM_TOLERANCE_PX) {
+        printf("FAIL: batch scalar kernel disagrees with project_vertex\n");
+        return 1;
+    }
+
+    printf("Active kernel: %s\n", transform_kernel_name(transform_active_kernel()));
+    const transform_kernel_t kernels[] = { TRANSFORM_KERNEL_SSE, TRANSFORM_KERNEL_AVX2 };
+    for (int k = 0; k < 2; k++) {
+        transform_vertices_soa_kernel(kernels[k], &mvp, x, y, z, NUM_VERTICES,
+                                      width, height, out_x, out_y, out_d);
+        float dx = max_diff(ref_x, out_x, NUM_VERTICES);
+        float dy = max_diff(ref_y, out_y, NUM_VERTICES);
+        float dd = max_diff(ref_d, out_d, NUM_VERTICES);
+        printf("%-6s vs scalar: x %.2e px, y %.2e px, depth %.2e\n",
+               transform_kernel_name(kernels[k]), dx, dy, dd);
+        if (dx > TRANSFORM_TOLERANCE_PX || dy > TRANSFORM_TOLERANCE_PX ||
+            dd > TRANSFORM_TOLERANCE_DEPTH) {
+            printf("FAIL: %s kernel outside tolerance\n", transform_kernel_name(kernels[k]));
+            return 1;
+        }
+    }
+
+    printf("Transform test completed.\n");
+    return 0;
+}
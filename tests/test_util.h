@@ -0,0 +1,65 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <stdlib.h>
+#include <string.h>
+#include "../include/canvas.h"  // For canvas_t
+#include "../include/mesh.h"    // For indexed_mesh_t
+
+// Fixtures shared by the tests. Everything here is static inline, so a test
+// that uses only some of the helpers still builds warning-clean.
+
+// Compare every pixel bit for bit (padding excluded), in either canvas format
+static inline int canvases_identical(const canvas_t* a, const canvas_t* b) {
+    for (int y = 0; y < a->height; y++) {
+        if (a->format == CANVAS_FORMAT_UNORM16
+                ? memcmp(canvas_row16(a, y), canvas_row16(b, y), sizeof(uint16_t) * a->width) != 0
+                : memcmp(canvas_row(a, y), canvas_row(b, y), sizeof(float) * a->width) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Uniform in [lo, hi], drawn from rand(); seed with srand for reproducible input
+static inline float rand_range(float lo, float hi) {
+    return lo + (hi - lo) * (float)rand() / RAND_MAX;
+}
+
+// Vertices uniform in [-1, 1]^3 joined by random edges, with bounds. Draws
+// from rand(), so seed with srand first for a reproducible mesh.
+static inline indexed_mesh_t* random_mesh(int num_vertices, int num_edges) {
+    indexed_mesh_t* mesh = indexed_mesh_create(num_vertices, num_edges);
+    if (!mesh) return NULL;
+    for (int i = 0; i < mesh->num_vertices; i++) {
+        mesh->vertices[i] = vec3f_make(rand_range(-1, 1), rand_range(-1, 1), rand_range(-1, 1));
+    }
+    for (int i = 0; i < 2 * mesh->num_edges; i++) mesh->indices[i] = rand() % mesh->num_vertices;
+    indexed_mesh_compute_bounds(mesh);
+    return mesh;
+}
+
+// Unit cube centred on the origin: 8 corners, 12 edges
+static inline indexed_mesh_t* make_cube(void) {
+    indexed_mesh_t* cube = indexed_mesh_create(8, 12);
+    if (!cube) return NULL;
+    for (int i = 0; i < 8; i++) {
+        cube->vertices[i] = vec3f_make(i & 1 ? 0.5f : -0.5f, i & 2 ? 0.5f : -0.5f,
+                                       i & 4 ? 0.5f : -0.5f);
+    }
+    // Every pair of corners differing in one coordinate
+    int e = 0;
+    for (int i = 0; i < 8; i++) {
+        for (int bit = 1; bit < 8; bit <<= 1) {
+            if (!(i & bit)) {
+                cube->indices[2*e] = i;
+                cube->indices[2*e + 1] = i | bit;
+                e++;
+            }
+        }
+    }
+    indexed_mesh_compute_bounds(cube);
+    return cube;
+}
+
+#endif // TEST_UTIL_H